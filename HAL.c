@@ -1,197 +1,350 @@
-
-
-#include <stdint.h>
-#include "tm4c123gh6pm.h"
-#include "HAL.h"
-#include "system.h"
-#include "timers.h"
-
-/* the pins are as described here
-PORTA (P0,P1 UART)  (P2,P3 coolant control) (P4-P7 Driver Enable control)
-PORTB (P0,P1 USB)   (P4-P7 Driver Step control) (P2,P3 can be used for coolant control if it requires PWM)
-PORTC (PC4-PC7 Driver Direction Control)
-PORTD (P0,P1 Spindle control)  (P2-P5 USB) (P6,P7 can be used for optical encoder of spindle)
-PORTE (P0-P2 limits)	(P3-P5 can support CAN network between machines ,, analog feed back,, I2C communication)
-PORTF (P0-P2 limits/homing)	(P3 blinking led)	(P4 probe)
-
-
-TIMER5 for execute and load queue
-WTIMER0 for debugger
-WTIMER1 for tick_clock
-WTIMER5 for DDA
-*/
-static void stepper_init(void);
-static void limit_init(void);
-static void emergency_init(void);
-static void execute_timer_init(void);
-static void load_timer_init(void);
-static void dda_timer_init(void);
-static void tick_timer_init(void);
-
-
-void peripherals_init(void){
-	SYSCTL_RCGCGPIO_R |= 0x0000003F;
-	while((SYSCTL_PRGPIO_R&0x0000003F) != 0x0000003F ){}
-	GPIO_PORTF_LOCK_R = GPIO_LOCK_KEY;
-	GPIO_PORTF_CR_R |= 0x00000001;		//enable writting F0
-	GPIO_PORTD_LOCK_R = GPIO_LOCK_KEY;
-	GPIO_PORTD_CR_R |= 0x00000080;		//enable writting D7
-	SYSCTL_RCGCTIMER_R |= 0x00000020;
-	while((SYSCTL_PRTIMER_R&0x00000020) != 0x00000020 ){}
-	SYSCTL_RCGCWTIMER_R |= 0x00000023;
-	while((SYSCTL_PRWTIMER_R&0x00000023) != 0x00000023 ){}
-	emergency_init();
-	limit_init();
-	stepper_init();
-	execute_timer_init();
-	load_timer_init();
-	dda_timer_init();
-	tick_timer_init();
-}
-
-
-//stepper module
-static void stepper_init(void){
-	///////////////////ENABLE PINS//////////////////////////////////
-	GPIO_PORTA_DR8R_R |= 0xF0;
-	GPIO_PORTA_DATA_R &=~ 0x000000F0;		//make the pins low
-	GPIO_PORTA_DIR_R |= 0x000000F0;			//make the pins output
-	GPIO_PORTA_DEN_R |= 0x000000F0;			//make them digital
-	GPIO_PORTA_AFSEL_R &=~ 0x000000F0;	//turn off alternate functions
-	GPIO_PORTA_PCTL_R &=~ 0xFFFF0000;		//make then normal port pins
-	GPIO_PORTA_AMSEL_R &=~ 0x000000F0;	//turn off analog
-	////////////////////////////////////////////////////////////////
-	////////////////////CLK PINS///////////////////////////////////
-	GPIO_PORTB_DR8R_R |= 0xF0;
-	GPIO_PORTB_DATA_R &=~ 0x000000F0;		//make the pins low
-	GPIO_PORTB_DIR_R |= 0x000000F0;			//make the pins output
-	GPIO_PORTB_DEN_R |= 0x000000F0;			//make them digital
-	GPIO_PORTB_AFSEL_R &=~ 0x000000F0;	//turn off alternate functions
-	GPIO_PORTB_PCTL_R &=~ 0xFFFF0000;		//make then normal port pins
-	GPIO_PORTB_AMSEL_R &=~ 0x000000F0;	//turn off analog
-	///////////////////////////////////////////////////////////////
-	///////////////////DIR PINS////////////////////////////////////
-	GPIO_PORTC_DR8R_R |= 0xF0;
-	GPIO_PORTC_DATA_R &=~ 0x000000F0;		//make the pins low
-	GPIO_PORTC_DIR_R |= 0x000000F0;			//make the pins output
-	GPIO_PORTC_DEN_R |= 0x000000F0;			//make them digital
-	GPIO_PORTC_AFSEL_R &=~ 0x000000F0;	//turn off alternate functions
-	GPIO_PORTC_PCTL_R &=~ 0xFFFF0000;		//make then normal port pins
-	GPIO_PORTC_AMSEL_R &=~ 0x000000F0;	//turn off analog
-}
-
-//the rest of the module are inline functions in the stepper header file
-///////////////////////////////////////////////////////////////////
-
-//limit switches module
-
-static void limit_init(void){
-	///////////////// linear limits //////////////////////////////
-	GPIO_PORTE_DATA_R &=~ 0x00000007;		//clear data
-	GPIO_PORTE_DIR_R &=~ 0x00000007;		//input
-	GPIO_PORTE_DEN_R |= 0x00000007;			//digital
-	GPIO_PORTE_AFSEL_R &=~ 0x00000007;	//non_alternate
-	GPIO_PORTE_PCTL_R &=~ 0x00000FFF;		//normal port
-	GPIO_PORTE_AMSEL_R &=~ 0x00000007;	//non_analog
-	GPIO_PORTE_IS_R &=~ 0x00000007;		//edge triggered interrupt
-	GPIO_PORTE_IBE_R |= 0x00000007;		//interrupt both edges
-	GPIO_PORTE_ICR_R |= 0x00000007;		//clear interrupts
-	NVIC_PRI1_R = (NVIC_PRI1_R&0xFFFFFF00)|(LIMITS_PRIORITY<<L_LIMITS_PRIORITY_BITS);		//set to priority 1
-	NVIC_EN0_R |= L_LIMITS_ENABLE_BIT;
-	GPIO_PORTE_IM_R |= 0x00000007;		//mask interrupt
-	///////////////////////////////////////////////////////////////
-	//////////////////angular limits//////////////////////////////
-	GPIO_PORTF_DATA_R &=~ 0x00000007;		//clear data
-	GPIO_PORTF_DIR_R &=~ 0x00000007;		//input
-	GPIO_PORTF_DEN_R |= 0x00000007;			//digital
-	GPIO_PORTF_AFSEL_R &=~ 0x00000007;	//non_alternate
-	GPIO_PORTF_PCTL_R &=~ 0x00000FFF;		//normal port
-	GPIO_PORTF_AMSEL_R &=~ 0x00000007;	//non_analog
-	GPIO_PORTF_IS_R &=~ 0x00000007;		//edge triggered interrupt
-	GPIO_PORTF_IBE_R |= 0x00000007;		//interrupt BOTH Edges
-	//GPIO_PORTF_IEV_R &=~ 0x00000007;		//interrupt on falling edge
-	GPIO_PORTF_ICR_R |= 0x00000007;		//clear interrupts
-	NVIC_PRI7_R = (NVIC_PRI7_R&0xFF00FFFF)|(LIMITS_PRIORITY<<A_LIMITS_PRIORITY_BITS);		//set to priority 1
-	NVIC_EN0_R |= A_LIMITS_ENABLE_BIT;
-	GPIO_PORTF_IM_R |= 0x00000007;		//mask interrupt
-}
-//the rest are inline functions in homing header file 
-//////////////////////////////////////////////////////////////////
-
-//emergency
-
-static void emergency_init(void){
-	GPIO_PORTB_DATA_R &=~ 0x00000008;		//clear data
-	GPIO_PORTB_DIR_R &=~ 0x00000008;		//input
-	GPIO_PORTB_PUR_R |= 0x00000008;
-	GPIO_PORTB_DEN_R |= 0x00000008;			//digital
-	GPIO_PORTB_AFSEL_R &=~ 0x00000008;	//non_alternate
-	GPIO_PORTB_PCTL_R &=~ 0x0000F000;		//normal port
-	GPIO_PORTB_AMSEL_R &=~ 0x00000008;	//non_analog
-	GPIO_PORTB_IS_R &=~ 0x00000008;		//edge triggered interrupt
-	GPIO_PORTB_IBE_R &=~ 0x00000008;		//interrupt selected by IEV
-	GPIO_PORTB_IEV_R &=~ 0x00000008;		//interrupt on falling edge
-	GPIO_PORTB_ICR_R |= 0x00000008;		//clear interrupts
-	NVIC_PRI0_R = (NVIC_PRI0_R&0xFFFF00FF)|(EMERGENCY_PRIORITY);		//set to priority 1
-	NVIC_EN0_R |= EMERGENCY_ENABLE_BIT;
-	GPIO_PORTB_IM_R |= 0x00000008;		//mask interrupt
-}
-//the rest are inline functions in emergency header file
-///////////////////////////////////////////////////////////////
-
-
-
-static void execute_timer_init(void){
-	TIMER5_CTL_R &=~ TIMER_CTL_TAEN;
-	TIMER5_CTL_R |= TIMER_CTL_TASTALL;
-	TIMER5_CFG_R = TIMER_CFG_16_BIT;
-	TIMER5_TAMR_R |= TIMER_TAMR_TACDIR|TIMER_TAMR_TAMR_1_SHOT;
-	TIMER5_TAILR_R = EXECUTE_TIMER_PERIOD;
-	TIMER5_TAPR_R = 0;
-	TIMER5_TAV_R = 0;
-	TIMER5_ICR_R |= TIMER_ICR_TATOCINT;
-	NVIC_PRI23_R = (NVIC_PRI23_R&0xFFFFFF00)|(EXECUTE_TIMER_PRIORITY);
-	NVIC_EN2_R |= EXECUTE_ENABLE_BIT;
-	TIMER5_IMR_R |= TIMER_IMR_TATOIM;
-}
-
-static void load_timer_init(void){
-	TIMER5_CTL_R &=~ TIMER_CTL_TBEN;
-	TIMER5_CTL_R |= TIMER_CTL_TBSTALL;
-	TIMER5_TBMR_R |= TIMER_TBMR_TBCDIR|TIMER_TBMR_TBMR_1_SHOT;
-	TIMER5_TBILR_R = LOAD_TIMER_PERIOD;
-	TIMER5_TBPR_R = 0;
-	TIMER5_TBV_R = 0;
-	TIMER5_ICR_R |= TIMER_ICR_TBTOCINT;
-	NVIC_PRI23_R = (NVIC_PRI23_R&0xFFFF00FF)|(LOAD_TIMER_PRIORITY);
-	NVIC_EN2_R |= LOAD_ENABLE_BIT;
-	TIMER5_IMR_R |= TIMER_IMR_TBTOIM;
-}
-
-static void dda_timer_init(void){
-	WTIMER5_CTL_R &=~ TIMER_CTL_TAEN;
-	WTIMER5_CTL_R |= TIMER_CTL_TASTALL;
-	WTIMER5_CFG_R = TIMER_CFG_16_BIT;
-	WTIMER5_TAMR_R |= TIMER_TAMR_TACDIR|TIMER_TAMR_TAMR_PERIOD|TIMER_TAMR_TAMIE;
-	WTIMER5_TAILR_R = EXECUTE_TIMER_PERIOD;
-	WTIMER5_TAPR_R = 0;
-	WTIMER5_TAV_R = 0;
-	WTIMER5_TAPMR_R = 0;
-	WTIMER5_ICR_R |= TIMER_ICR_TATOCINT|TIMER_ICR_TAMCINT;
-	NVIC_PRI26_R = (NVIC_PRI26_R&0xFFFFFF00)|(DDA_TIMER_PRIORITY);
-	NVIC_EN3_R |= DDA_ENABLE_BIT;
-	WTIMER5_IMR_R |= TIMER_IMR_TATOIM|TIMER_IMR_TAMIM;
-}
-
-
-static void tick_timer_init(void){
-	WTIMER1_CTL_R &=~ TIMER_CTL_TAEN|TIMER_CTL_TBEN;
-	WTIMER1_CTL_R |= TIMER_CTL_TASTALL|TIMER_CTL_TBSTALL;
-	WTIMER1_CFG_R = TIMER_CFG_32_BIT_TIMER;
-	WTIMER1_TAMR_R |= TIMER_TAMR_TACDIR|TIMER_TAMR_TAMR_PERIOD;
-	WTIMER1_TAILR_R = FCPU/1000;			//this will always give 1ms interval no matter the frequency
-	WTIMER1_TAV_R = 0;
-	WTIMER1_TBV_R = 0;
-	WTIMER1_CTL_R |= TIMER_CTL_TAEN|TIMER_CTL_TBEN;
-}
-
+
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "HAL.h"
+#include "system.h"
+#include "timers.h"
+#include "serial.h"
+#include "canonical.h"
+#include "events.h"
+#include "loader.h"
+
+/* the pins are as described here
+PORTA (P0,P1 UART)  (P2,P3 coolant control) (P4-P7 Driver Enable control)
+PORTB (P0,P1 USB)   (P4-P7 Driver Step control) (P2,P3 can be used for coolant control if it requires PWM)
+PORTC (PC4-PC7 Driver Direction Control)
+PORTD (P0,P1 Spindle control)  (P2-P5 USB) (P6,P7 can be used for optical encoder of spindle)
+PORTE (P0-P2 limits)	(P3-P5 can support CAN network between machines ,, analog feed back,, I2C communication)
+PORTF (P0-P2 limits/homing)	(P3 blinking led)	(P4 probe)
+
+
+UART0 for host/HMI link
+TIMER5 for execute and load queue
+TIMER2A for probe capture (PF4 T2CCP0)
+QEI0 for encoder feedback (PD6,PD7)
+WTIMER0 for debugger
+WTIMER1 for tick_clock
+WTIMER5 for DDA
+*/
+static void stepper_init(void);
+static void limit_init(void);
+static void emergency_init(void);
+static void execute_timer_init(void);
+static void load_timer_init(void);
+static void dda_timer_init(void);
+static void tick_timer_init(void);
+static void serial_init(void);
+static void probe_init(void);
+static void spindle_coolant_init(void);
+#if defined(__ENCODER_FEEDBACK)
+static void qei_init(void);
+#endif
+
+
+void peripherals_init(void){
+	SYSCTL_RCGCGPIO_R |= 0x0000003F;
+	while((SYSCTL_PRGPIO_R&0x0000003F) != 0x0000003F ){}
+	GPIO_PORTF_LOCK_R = GPIO_LOCK_KEY;
+	GPIO_PORTF_CR_R |= 0x00000001;		//enable writting F0
+	GPIO_PORTD_LOCK_R = GPIO_LOCK_KEY;
+	GPIO_PORTD_CR_R |= 0x00000080;		//enable writting D7
+	SYSCTL_RCGCTIMER_R |= 0x00000020;
+	while((SYSCTL_PRTIMER_R&0x00000020) != 0x00000020 ){}
+	SYSCTL_RCGCWTIMER_R |= 0x00000023;
+	while((SYSCTL_PRWTIMER_R&0x00000023) != 0x00000023 ){}
+	SYSCTL_RCGCUART_R |= 0x00000001;
+	while((SYSCTL_PRUART_R&0x00000001) != 0x00000001 ){}
+	emergency_init();
+	limit_init();
+	stepper_init();
+	execute_timer_init();
+	load_timer_init();
+	dda_timer_init();
+	tick_timer_init();
+	serial_init();
+	probe_init();
+	spindle_coolant_init();
+#if defined(__ENCODER_FEEDBACK)
+	qei_init();
+#endif
+}
+
+
+//stepper module
+static void stepper_init(void){
+	///////////////////ENABLE PINS//////////////////////////////////
+	GPIO_PORTA_DR8R_R |= 0xF0;
+	GPIO_PORTA_DATA_R &=~ 0x000000F0;		//make the pins low
+	GPIO_PORTA_DIR_R |= 0x000000F0;			//make the pins output
+	GPIO_PORTA_DEN_R |= 0x000000F0;			//make them digital
+	GPIO_PORTA_AFSEL_R &=~ 0x000000F0;	//turn off alternate functions
+	GPIO_PORTA_PCTL_R &=~ 0xFFFF0000;		//make then normal port pins
+	GPIO_PORTA_AMSEL_R &=~ 0x000000F0;	//turn off analog
+	////////////////////////////////////////////////////////////////
+	////////////////////CLK PINS///////////////////////////////////
+	GPIO_PORTB_DR8R_R |= 0xF0;
+	GPIO_PORTB_DATA_R &=~ 0x000000F0;		//make the pins low
+	GPIO_PORTB_DIR_R |= 0x000000F0;			//make the pins output
+	GPIO_PORTB_DEN_R |= 0x000000F0;			//make them digital
+	GPIO_PORTB_AFSEL_R &=~ 0x000000F0;	//turn off alternate functions
+	GPIO_PORTB_PCTL_R &=~ 0xFFFF0000;		//make then normal port pins
+	GPIO_PORTB_AMSEL_R &=~ 0x000000F0;	//turn off analog
+	///////////////////////////////////////////////////////////////
+	///////////////////DIR PINS////////////////////////////////////
+	GPIO_PORTC_DR8R_R |= 0xF0;
+	GPIO_PORTC_DATA_R &=~ 0x000000F0;		//make the pins low
+	GPIO_PORTC_DIR_R |= 0x000000F0;			//make the pins output
+	GPIO_PORTC_DEN_R |= 0x000000F0;			//make them digital
+	GPIO_PORTC_AFSEL_R &=~ 0x000000F0;	//turn off alternate functions
+	GPIO_PORTC_PCTL_R &=~ 0xFFFF0000;		//make then normal port pins
+	GPIO_PORTC_AMSEL_R &=~ 0x000000F0;	//turn off analog
+}
+
+//the rest of the module are inline functions in the stepper header file
+///////////////////////////////////////////////////////////////////
+
+//limit switches module
+
+static void limit_init(void){
+	///////////////// linear limits //////////////////////////////
+	GPIO_PORTE_DATA_R &=~ 0x00000007;		//clear data
+	GPIO_PORTE_DIR_R &=~ 0x00000007;		//input
+	GPIO_PORTE_DEN_R |= 0x00000007;			//digital
+	GPIO_PORTE_AFSEL_R &=~ 0x00000007;	//non_alternate
+	GPIO_PORTE_PCTL_R &=~ 0x00000FFF;		//normal port
+	GPIO_PORTE_AMSEL_R &=~ 0x00000007;	//non_analog
+	GPIO_PORTE_IS_R &=~ 0x00000007;		//edge triggered interrupt
+	GPIO_PORTE_IBE_R |= 0x00000007;		//interrupt both edges
+	GPIO_PORTE_ICR_R |= 0x00000007;		//clear interrupts
+	NVIC_PRI1_R = (NVIC_PRI1_R&0xFFFFFF00)|(LIMITS_PRIORITY<<L_LIMITS_PRIORITY_BITS);		//set to priority 1
+	NVIC_EN0_R |= L_LIMITS_ENABLE_BIT;
+	GPIO_PORTE_IM_R |= 0x00000007;		//mask interrupt
+	///////////////////////////////////////////////////////////////
+	//////////////////angular limits//////////////////////////////
+	GPIO_PORTF_DATA_R &=~ 0x00000007;		//clear data
+	GPIO_PORTF_DIR_R &=~ 0x00000007;		//input
+	GPIO_PORTF_DEN_R |= 0x00000007;			//digital
+	GPIO_PORTF_AFSEL_R &=~ 0x00000007;	//non_alternate
+	GPIO_PORTF_PCTL_R &=~ 0x00000FFF;		//normal port
+	GPIO_PORTF_AMSEL_R &=~ 0x00000007;	//non_analog
+	GPIO_PORTF_IS_R &=~ 0x00000007;		//edge triggered interrupt
+	GPIO_PORTF_IBE_R |= 0x00000007;		//interrupt BOTH Edges
+	//GPIO_PORTF_IEV_R &=~ 0x00000007;		//interrupt on falling edge
+	GPIO_PORTF_ICR_R |= 0x00000007;		//clear interrupts
+	NVIC_PRI7_R = (NVIC_PRI7_R&0xFF00FFFF)|(LIMITS_PRIORITY<<A_LIMITS_PRIORITY_BITS);		//set to priority 1
+	NVIC_EN0_R |= A_LIMITS_ENABLE_BIT;
+	GPIO_PORTF_IM_R |= 0x00000007;		//mask interrupt
+}
+//the rest are inline functions in homing header file 
+//////////////////////////////////////////////////////////////////
+
+//emergency
+
+static void emergency_init(void){
+	GPIO_PORTB_DATA_R &=~ 0x00000008;		//clear data
+	GPIO_PORTB_DIR_R &=~ 0x00000008;		//input
+	GPIO_PORTB_PUR_R |= 0x00000008;
+	GPIO_PORTB_DEN_R |= 0x00000008;			//digital
+	GPIO_PORTB_AFSEL_R &=~ 0x00000008;	//non_alternate
+	GPIO_PORTB_PCTL_R &=~ 0x0000F000;		//normal port
+	GPIO_PORTB_AMSEL_R &=~ 0x00000008;	//non_analog
+	GPIO_PORTB_IS_R &=~ 0x00000008;		//edge triggered interrupt
+	GPIO_PORTB_IBE_R &=~ 0x00000008;		//interrupt selected by IEV
+	GPIO_PORTB_IEV_R &=~ 0x00000008;		//interrupt on falling edge
+	GPIO_PORTB_ICR_R |= 0x00000008;		//clear interrupts
+	NVIC_PRI0_R = (NVIC_PRI0_R&0xFFFF00FF)|(EMERGENCY_PRIORITY);		//set to priority 1
+	NVIC_EN0_R |= EMERGENCY_ENABLE_BIT;
+	GPIO_PORTB_IM_R |= 0x00000008;		//mask interrupt
+}
+//the rest are inline functions in emergency header file
+///////////////////////////////////////////////////////////////
+
+
+
+static void execute_timer_init(void){
+	TIMER5_CTL_R &=~ TIMER_CTL_TAEN;
+	TIMER5_CTL_R |= TIMER_CTL_TASTALL;
+	TIMER5_CFG_R = TIMER_CFG_16_BIT;
+	TIMER5_TAMR_R |= TIMER_TAMR_TACDIR|TIMER_TAMR_TAMR_1_SHOT;
+	TIMER5_TAILR_R = EXECUTE_TIMER_PERIOD;
+	TIMER5_TAPR_R = 0;
+	TIMER5_TAV_R = 0;
+	TIMER5_ICR_R |= TIMER_ICR_TATOCINT;
+	NVIC_PRI23_R = (NVIC_PRI23_R&0xFFFFFF00)|(EXECUTE_TIMER_PRIORITY);
+	NVIC_EN2_R |= EXECUTE_ENABLE_BIT;
+	TIMER5_IMR_R |= TIMER_IMR_TATOIM;
+}
+
+static void load_timer_init(void){
+	TIMER5_CTL_R &=~ TIMER_CTL_TBEN;
+	TIMER5_CTL_R |= TIMER_CTL_TBSTALL;
+	TIMER5_TBMR_R |= TIMER_TBMR_TBCDIR|TIMER_TBMR_TBMR_1_SHOT;
+	TIMER5_TBILR_R = LOAD_TIMER_PERIOD;
+	TIMER5_TBPR_R = 0;
+	TIMER5_TBV_R = 0;
+	TIMER5_ICR_R |= TIMER_ICR_TBTOCINT;
+	NVIC_PRI23_R = (NVIC_PRI23_R&0xFFFF00FF)|(LOAD_TIMER_PRIORITY);
+	NVIC_EN2_R |= LOAD_ENABLE_BIT;
+	TIMER5_IMR_R |= TIMER_IMR_TBTOIM;
+}
+
+static void dda_timer_init(void){
+	WTIMER5_CTL_R &=~ TIMER_CTL_TAEN;
+	WTIMER5_CTL_R |= TIMER_CTL_TASTALL;
+	WTIMER5_CFG_R = TIMER_CFG_16_BIT;
+	WTIMER5_TAMR_R |= TIMER_TAMR_TACDIR|TIMER_TAMR_TAMR_PERIOD|TIMER_TAMR_TAMIE;
+	WTIMER5_TAILR_R = EXECUTE_TIMER_PERIOD;
+	WTIMER5_TAPR_R = 0;
+	WTIMER5_TAV_R = 0;
+	WTIMER5_TAPMR_R = 0;
+	WTIMER5_ICR_R |= TIMER_ICR_TATOCINT|TIMER_ICR_TAMCINT;
+	NVIC_PRI26_R = (NVIC_PRI26_R&0xFFFFFF00)|(DDA_TIMER_PRIORITY);
+	NVIC_EN3_R |= DDA_ENABLE_BIT;
+	WTIMER5_IMR_R |= TIMER_IMR_TATOIM|TIMER_IMR_TAMIM;
+}
+
+
+static void tick_timer_init(void){
+	WTIMER1_CTL_R &=~ TIMER_CTL_TAEN|TIMER_CTL_TBEN;
+	WTIMER1_CTL_R |= TIMER_CTL_TASTALL|TIMER_CTL_TBSTALL;
+	WTIMER1_CFG_R = TIMER_CFG_32_BIT_TIMER;
+	WTIMER1_TAMR_R |= TIMER_TAMR_TACDIR|TIMER_TAMR_TAMR_PERIOD;
+	WTIMER1_TAILR_R = FCPU/1000;			//this will always give 1ms interval no matter the frequency
+	WTIMER1_TAV_R = 0;
+	WTIMER1_TBV_R = 0;
+	WTIMER1_ICR_R = TIMER_ICR_TATOCINT;
+	NVIC_PRI24_R = (NVIC_PRI24_R&0xFFFFFF00)|(TICK_PRIORITY<<TICK_PRIORITY_BITS);
+	NVIC_EN3_R |= TICK_ENABLE_BIT;
+	WTIMER1_IMR_R |= TIMER_IMR_TATOIM;		//ev_tick masks it while nothing is due, the count runs on
+	WTIMER1_CTL_R |= TIMER_CTL_TAEN|TIMER_CTL_TBEN;
+}
+
+//tick_wake//
+//input : none
+//output : none
+//fuction : unmasks the 1ms tick interrupt, tick_sleep masks it
+//notes : ev_tick_wake and ev_tick call them in a critical section
+//additions:
+//
+void tick_wake(void){
+	WTIMER1_IMR_R |= TIMER_IMR_TATOIM;
+}
+
+void tick_sleep(void){
+	WTIMER1_IMR_R &=~ TIMER_IMR_TATOIM;
+}
+
+void WTIMER1A_Handler(void){
+	WTIMER1_ICR_R = TIMER_ICR_TATOCINT;
+	ev_tick(ld_dwell_tick());
+}
+
+
+
+//serial module
+
+static void serial_init(void){
+	UART0_CTL_R &=~ UART_CTL_UARTEN;		//disable while configuring
+	UART0_IBRD_R = FCPU/(16*SERIAL_BAUDRATE);
+	UART0_FBRD_R = ((((FCPU*8)/SERIAL_BAUDRATE)+1)/2)&0x3F;	//fraction*64 rounded
+	UART0_LCRH_R = UART_LCRH_WLEN_8|UART_LCRH_FEN;	//8N1 with fifos
+	UART0_IFLS_R = UART_IFLS_TX4_8|UART_IFLS_RX1_8;	//refill at half empty, read from 2 characters on
+	UART0_ICR_R = 0x000007FF;				//clear interrupts
+	UART0_IM_R |= UART_IM_RXIM|UART_IM_RTIM;	//receive and receive timeout for single characters
+	GPIO_PORTA_AFSEL_R |= 0x00000003;		//alternate function on PA0,PA1
+	GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R&0xFFFFFF00)|0x00000011;	//UART0
+	GPIO_PORTA_DEN_R |= 0x00000003;			//digital
+	GPIO_PORTA_AMSEL_R &=~ 0x00000003;	//non_analog
+	NVIC_PRI1_R = (NVIC_PRI1_R&0xFFFF00FF)|(SERIAL_PRIORITY<<SERIAL_PRIORITY_BITS);
+	NVIC_EN0_R |= SERIAL_ENABLE_BIT;
+	UART0_CTL_R |= UART_CTL_UARTEN|UART_CTL_TXE|UART_CTL_RXE;
+}
+
+//probe module
+//the probe edge on PF4 is captured by TIMER2A (edge time mode) instead of the port F interrupt,
+//so it has its own interrupt above the DDA. the pin still reads as an input for get_probe_state
+static void probe_init(void){
+	SYSCTL_RCGCTIMER_R |= 0x00000004;
+	while((SYSCTL_PRTIMER_R&0x00000004) != 0x00000004 ){}
+	TIMER2_CTL_R &=~ TIMER_CTL_TAEN;		//disable while configuring
+	GPIO_PORTF_DIR_R &=~ 0x00000010;		//input
+	GPIO_PORTF_PUR_R |= 0x00000010;			//pull up, the probe closes to ground
+	GPIO_PORTF_DEN_R |= 0x00000010;			//digital
+	GPIO_PORTF_AFSEL_R |= 0x00000010;		//alternate function on PF4
+	GPIO_PORTF_PCTL_R = (GPIO_PORTF_PCTL_R&0xFFF0FFFF)|0x00070000;	//T2CCP0
+	GPIO_PORTF_AMSEL_R &=~ 0x00000010;	//non_analog
+	TIMER2_CFG_R = TIMER_CFG_16_BIT;
+	TIMER2_TAMR_R = TIMER_TAMR_TACMR|TIMER_TAMR_TAMR_CAP;	//edge time capture
+	TIMER2_CTL_R = (TIMER2_CTL_R&~TIMER_CTL_TAEVENT_M)|TIMER_CTL_TAEVENT_BOTH;	//contact is made or lost
+	TIMER2_TAILR_R = 0x0000FFFF;
+	TIMER2_ICR_R = TIMER_ICR_CAECINT;		//clear interrupt
+	TIMER2_IMR_R &=~ TIMER_IMR_CAEIM;		//armed by the probe cycle
+	NVIC_PRI5_R = (NVIC_PRI5_R&0x1FFFFFFF)|(PROBE_PRIORITY<<PROBE_PRIORITY_BITS);
+	NVIC_EN0_R |= PROBE_ENABLE_BIT;
+	TIMER2_CTL_R |= TIMER_CTL_TAEN;
+}
+
+void probe_capture_arm(void){
+	TIMER2_ICR_R = TIMER_ICR_CAECINT;		//forget the edges seen before the move
+	TIMER2_IMR_R |= TIMER_IMR_CAEIM;
+}
+
+void probe_capture_disarm(void){
+	TIMER2_IMR_R &=~ TIMER_IMR_CAEIM;
+}
+
+void TIMER2A_Handler(void){
+	TIMER2_ICR_R = TIMER_ICR_CAECINT;
+	cm_probe_latch();
+}
+
+//spindle and coolant module
+//on/off outputs run from the queued commands in the load interrupt, the data register is written
+//through its address mask so the driver enables on PA4-PA7 aren't read and written back
+#define SPINDLE_DATA_R (*((volatile uint32_t *)(0x40007000 + ((SPINDLE_ENABLE_PIN|SPINDLE_DIR_PIN)<<2))))
+#define COOLANT_DATA_R (*((volatile uint32_t *)(0x40004000 + ((MIST_COOLANT_PIN|FLOOD_COOLANT_PIN)<<2))))
+
+static void spindle_coolant_init(void){
+	SPINDLE_DATA_R = 0;									//off
+	GPIO_PORTD_DIR_R |= SPINDLE_ENABLE_PIN|SPINDLE_DIR_PIN;
+	GPIO_PORTD_DEN_R |= SPINDLE_ENABLE_PIN|SPINDLE_DIR_PIN;
+	GPIO_PORTD_AFSEL_R &=~ (SPINDLE_ENABLE_PIN|SPINDLE_DIR_PIN);
+	GPIO_PORTD_PCTL_R &=~ 0x000000FF;
+	GPIO_PORTD_AMSEL_R &=~ (SPINDLE_ENABLE_PIN|SPINDLE_DIR_PIN);
+	COOLANT_DATA_R = 0;
+	GPIO_PORTA_DIR_R |= MIST_COOLANT_PIN|FLOOD_COOLANT_PIN;
+	GPIO_PORTA_DEN_R |= MIST_COOLANT_PIN|FLOOD_COOLANT_PIN;
+	GPIO_PORTA_AFSEL_R &=~ (MIST_COOLANT_PIN|FLOOD_COOLANT_PIN);
+	GPIO_PORTA_PCTL_R &=~ 0x0000FF00;
+	GPIO_PORTA_AMSEL_R &=~ (MIST_COOLANT_PIN|FLOOD_COOLANT_PIN);
+}
+
+void spindle_set(uint8_t spindle_mode){
+	switch(spindle_mode){
+		case SPINDLE_CW: SPINDLE_DATA_R = SPINDLE_ENABLE_PIN; break;
+		case SPINDLE_CCW: SPINDLE_DATA_R = SPINDLE_ENABLE_PIN|SPINDLE_DIR_PIN; break;
+		default: SPINDLE_DATA_R = 0;
+	}
+}
+
+void coolant_set(uint8_t mist, uint8_t flood){
+	COOLANT_DATA_R = ((mist)? MIST_COOLANT_PIN : 0)|((flood)? FLOOD_COOLANT_PIN : 0);
+}
+
+#if defined(__ENCODER_FEEDBACK)
+//qei module
+//quadrature encoder of the feedback motor on PD6 (PhA0) and PD7 (PhB0)
+static void qei_init(void){
+	SYSCTL_RCGCQEI_R |= 0x00000001;
+	while((SYSCTL_PRQEI_R&0x00000001) != 0x00000001 ){}
+	QEI0_CTL_R &=~ QEI_CTL_ENABLE;			//disable while configuring
+	GPIO_PORTD_AFSEL_R |= 0x000000C0;		//alternate function on PD6,PD7
+	GPIO_PORTD_PCTL_R = (GPIO_PORTD_PCTL_R&0x00FFFFFF)|0x66000000;	//PhA0,PhB0
+	GPIO_PORTD_DEN_R |= 0x000000C0;			//digital
+	GPIO_PORTD_AMSEL_R &=~ 0x000000C0;	//non_analog
+	QEI0_MAXPOS_R = 0xFFFFFFFF;					//free running, differences wrap correctly
+	QEI0_POS_R = 0;
+	QEI0_CTL_R = QEI_CTL_CAPMODE|QEI_CTL_ENABLE;	//count both edges of both phases (x4)
+}
+#endif
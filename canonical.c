@@ -1,478 +1,784 @@
-/*
- * canonical.c
- * This file is part of the X project
- *
- * Omar Emad El-Deen
- * Yossef Mohammed Hassanin
- * Mars, 2018
- */
-/*
- * this code is a loose implementation of g-code interpreter based on Kramer, Proctor and Messina's
- * canonical machine as described in the NIST RS274/NGC v3
- * the canonical machine is a layer between gcode parser and motion controller
- * It keeps state and executes commands - passing the
- * stateless commands to the motion planning layer.
- */
-/* --- System state contexts - Gcode models ---
- *
- *	Useful reference for doing C callbacks http://www.newty.de/fpt/fpt.html
- *
- *	There are 3 temporal contexts for system state:
- *	  - The gcode model in the canonical machine (the MODEL context, held in gm)
- *	  - The gcode model used by the planner (PLANNER context, held in bf's and mm)
- *	  - The gcode model used during motion for reporting (RUNTIME context, held in mr)
- *
- *	It's a bit more complicated than this. The 'gm' struct contains the core Gcode model
- *	context. This originates in the canonical machine and is copied to each planner buffer
- *	(bf buffer) during motion planning. Finally, the gm context is passed to the runtime
- *	(mr) for the RUNTIME context. So at last count the Gcode model exists in as many as
- *	30 copies in the system. (1+28+1)
- *
- *	Depending on the need, any one of these contexts may be called for reporting or by
- *	a function. Most typically, all new commends from the gcode parser work form the MODEL
- *	context, and status reports pull from the RUNTIME while in motion, and from MODEL when
- *	at rest. A convenience is provided in the ACTIVE_MODEL pointer to point to the right
- *	context.
- */
-/* --- Synchronizing command execution ---
- *
- *	Some gcode commands only set the MODEL state for interpretation of the current Gcode
- *	block. For example, cm_set_feed_rate(). This sets the MODEL so the move time is
- *	properly calculated for the current (and subsequent) blocks, so it's effected
- *	immediately.
- *
- *	"Synchronous commands" are commands that affect the runtime need to be synchronized
- *	with movement. Examples include G4 dwells, program stops and ends, and most M commands.
- *	These are queued into the planner queue and execute from the queue. Synchronous commands
- *	work like this:
- *
- *	  - Call the cm_xxx_xxx() function which will do any input validation and return an
- *		error if it detects one.
- *
- *	  - The cm_ function calls mp_queue_command(). Arguments are a callback to the _exec_...()
- *		function, which is the runtime execution routine, and any arguments that are needed
- *		by the runtime. See typedef for *exec in planner.h for details
- *
- *	  - mp_queue_command() stores the callback and the args in a planner buffer.
- *
- *	  - When planner execution reaches the buffer it executes the callback w/ the args.
- *		Take careful note that the callback executes under an interrupt, so beware of
- *		variables that may need to be volatile.
- *
- *	Note:
- *	  - The synchronous command execution mechanism uses 2 vectors in the bf buffer to store
- *		and return values for the callback. It's obvious, but impractical to pass the entire
- *		bf buffer to the callback as some of these commands are actually executed locally
- *		and have no buffer.
- */
- 
- 
-//******includes*******//
-#include <stdint.h>
-#include <string.h>
-#include <stdbool.h>
-#include <math.h>
-#include "system.h"
-#include "canonical.h"
-#include "planner.h"
-#include "stepper.h"
-#include "debugging.h"
-#include "util.h"
-//////////////////////
-
-//******globals*******//
-cmSingleton_t cm;
-/////////////////////
-
-//cm_get_active_coord_offset//
-//input : axis number
-//output : coordinate offset of an axis
-//fuction : 
-//notes : 
-//additions: 
-//
-float cm_get_active_coord_offset(uint8_t axis){
-	if(cm.gm.absolute_override == true){return 0;}
-	return (cm.origin_offset_enable ? cm.coord_offset[cm.gm.coordinate_system][axis] + cm.origin_offset[axis] :
-																		cm.coord_offset[cm.gm.coordinate_system][axis]);
-}
-
-void cm_set_work_offsets(GState_t *gcode_state)
-{
-	for (uint8_t axis = X_AXIS; axis < AXES; ++axis) {
-		gcode_state->work_offset[axis] = cm_get_active_coord_offset(axis);
-	}
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-void cm_set_model_target(float values[], float flags[]){
-	for(uint8_t axis = X_AXIS; axis < AXES; ++axis){
-		if(flags[axis] <= 0.0f){		//or axis state is disabled
-			continue;
-		}else{
-			if(cm.gm.distance_mode == ABSOLUTE_MODE){
-				cm.gm.target[axis] = cm_get_active_coord_offset(axis) + _TO_MILLI(values[axis]);
-			}else{
-				cm.gm.target[axis] += _TO_MILLI(values[axis]);
-			}
-		}
-	}
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-void canonical_init(void){
-	memset(&cm.gm,0,sizeof(GState_t));
-	memset(&cm.gn,0,sizeof(GIn_t));
-	memset(&cm.gf,0,sizeof(GIn_t));
-	
-	ACTIVE_MODEL = MODEL;
-	// set gcode defaults
-	cm_select_unit_mode(GCODE_DEFAULT_UNITS);
-	cm_set_coord_system(G54);
-	cm_select_plane(GCODE_DEFAULT_PLANE);
-	cm_select_path_control(GCODE_DEFAULT_PATH_CONTROL);
-	cm_select_distance_mode(GCODE_DEFAULT_DISTANCE_MODE);
-	cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);// always the default
-	// never start a machine in a motion mode
-	cm.gm.motion_mode = MOTION_MODE_CANCEL_MOTION_MODE;
-	cm.machine_state = MACHINE_READY;
-	
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-void cm_set_model_linenum(uint32_t linenum){
-	cm.gm.linenum = linenum;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-uint8_t cm_get_motion_mode(GState_t *gcode_state)
-{
-	return gcode_state->motion_mode;
-}
-
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_set_feed_rate_mode(uint8_t mode){
-	cm.gm.feedrate_mode = mode;
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_set_feed_rate(float feed_rate){
-	if(cm.gm.feedrate_mode == INVERSE_TIME_MODE){
-		cm.gm.feedrate = 1/cm.gn.feedrate;  //total time to finish the move in minutes
-	}
-	else{
-		cm.gm.feedrate = _TO_MILLI(feed_rate);
-	}
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_select_plane(uint8_t plane){
-	cm.gm.plane_select = plane;
-	return STAT_OK;
-}
-
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_select_unit_mode(uint8_t mode){
-	cm.gm.units_mode = mode;
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_select_path_control(uint8_t path){
-	cm.gm.path_control = path;
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_select_distance_mode(uint8_t mode){
-	cm.gm.distance_mode = mode;
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_straight_traverse(float target[],float flags[]){
-	cm.gm.motion_mode = MOTION_MODE_STRAIGHT_TRAVERSE;
-	cm_set_model_target(target,flags);
-	//check soft limits
-	//return if soft limit alerted
-	//start cycle
-	mp_plan_line(&cm.gm);
-	//finalize the move
-	memcpy(&cm.position,&cm.gm.target,sizeof(cm.gm.target));
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_straight_feed(float target[],float flags[]){
-	//if in inverse time feed mode and the feed rate is omitted its an error and a return is issued
-	db_start_session(CANONICAL_TIME);
-	if ((cm.gm.feedrate_mode != INVERSE_TIME_MODE) && (fp_ZERO(cm.gm.feedrate))) {
-		return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
-	}
-	cm.gm.motion_mode = MOTION_MODE_STRAIGHT_FEED;
-	cm_set_model_target(target,flags);
-	//check soft limits
-	//return if soft limit alerted
-	
-	cm_set_work_offsets(&cm.gm);
-	cm_cycle_start();
-	mp_plan_line(&cm.gm);
-	cm_finalize_move();
-	db_end_session(CANONICAL_TIME);
-	return STAT_OK;
-}
-
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_set_coord_offsets(uint8_t coord_system, float target[], float flags[]){
-	if((coord_system<G54)||(coord_system>G59)){
-		return STAT_INPUT_VALUE_OUT_OF_RANGE;
-	}
-	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
-		if(flags[axis] > 0.0f){
-			cm.coord_offset[coord_system][axis] = _TO_MILLI(target[axis]);
-		}
-	}
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_set_coord_system(uint8_t coord){
-	cm.gm.coordinate_system = coord;
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-void cm_set_absolute_override(uint8_t state){
-	cm.gm.absolute_override = state;
-	//reset offsets here
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_set_origin_offsets(float values[], float flags[]){
-	cm.origin_offset_enable = 1;
-	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
-		if(flags[axis] > 0.0f){
-			cm.origin_offset[axis] = cm.position[axis] - cm.coord_offset[cm.gm.coordinate_system][axis] - _TO_MILLI(values[axis]);
-		}
-	}
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_reset_origin_offsets(void){
-	cm.origin_offset_enable = 0;
-	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
-			cm.origin_offset[axis] = 0;
-		}
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_suspend_origin_offsets(void){
-	cm.origin_offset_enable = 0;
-	return STAT_OK;
-}
-////
-//input : 
-//output : 
-//fuction : 
-//notes : 
-//additions: 
-//
-stat_t cm_resume_origin_offsets(void){
-	cm.origin_offset_enable = 1;
-	return STAT_OK;
-}
-
-
-
-void cm_cycle_start(void)
-{
-	cm.machine_state = MACHINE_CYCLE;
-	if (cm.cycle_state == CYCLE_OFF) {					// don't (re)start homing, probe or other canned cycles
-		cm.cycle_state = CYCLE_MACHINING;
-	}
-}
-
-void cm_finalize_move(void) {
-	copy_vector(cm.position, cm.gm.target);		// update model position
-
-	// if in ivnerse time mode reset feed rate so next block requires an explicit feed rate setting
-	if ((cm.gm.feedrate_mode == INVERSE_TIME_MODE) && (cm.gm.motion_mode == MOTION_MODE_STRAIGHT_FEED)) {
-		cm.gm.feedrate = 0;
-	}
-}
-
-
-stat_t cm_soft_alarm(stat_t status)
-{
-	cm.machine_state = MACHINE_ALARM;
-	return (status);						// NB: More efficient than inlining rpt_exception() call.
-}
-
-stat_t cm_hard_alarm(stat_t status)
-{
-	// stop the motors and the spindle
-	st_init();							// hard stop
-	//turn off spindle
-	cm.machine_state = MACHINE_SHUTDOWN;
-	return (status);
-}
-
-uint8_t cm_get_machine_state(void) { return cm.machine_state;};
-
-uint8_t cm_get_runtime_busy(void) {return mp_get_runtime_busy();}
-
-///getters
-uint8_t cm_get_coordinate_system(GState_t* gstate){
-	return gstate->coordinate_system;
-}
-uint8_t cm_get_units_mode(GState_t* gstate){
-	return gstate->units_mode;
-}
-uint8_t cm_get_distance_mode(GState_t* gstate){
-	return gstate->distance_mode;
-}
-uint8_t cm_get_feedrate_mode(GState_t* gstate){
-	return gstate->feedrate_mode;
-}
-uint8_t cm_get_feedrate(GState_t* gstate){
-	return gstate->feedrate;
-}
-
-void cm_set_motion_mode(GState_t* gstate, uint8_t motion_mode){
-	gstate->motion_mode = motion_mode;
-}
-
-float cm_get_axis_jerk(uint8_t axis){
-	return cm.a[axis].max_jerk;
-}
-
-void cm_set_axis_jerk(uint8_t axis, float jerk){
-	cm.a[axis].max_jerk = jerk;
-	cm.a[X_AXIS].jerk_recip = 1.0f/((cm.a[X_AXIS].max_jerk)*JERK_MULTI);
-}
-void cm_request_cycle_start(void) { cm.cycle_start_requested = true; }
-
-void cm_set_position(uint8_t axis, float position)
-{
-	// TODO: Interlock involving runtime_busy test
-	cm.position[axis] = position;
-	cm.gm.target[axis] = position;
-	mp_set_planner_position(axis, position);
-	mp_set_runtime_position(axis, position);
-	mp_set_steps_to_runtime_position();
-}
-
-
-void cm_set_motion_state(uint8_t motion_state)
-{
-	cm.motion_state = motion_state;
-
-	switch (motion_state) {
-		case (MOTION_STOP): { ACTIVE_MODEL = MODEL; break; }
-		case (MOTION_RUN):  { ACTIVE_MODEL = RUNTIME; break; }
-		case (MOTION_HOLD): { ACTIVE_MODEL = RUNTIME; break; }
-	}
-}
-
-float cm_get_absolute_position(GState_t *gcode_state, uint8_t axis)
-{
-	if (gcode_state == MODEL) return (cm.position[axis]);
-	return (mp_get_runtime_absolute_position(axis));
-}
+/*
+ * canonical.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * this code is a loose implementation of g-code interpreter based on Kramer, Proctor and Messina's
+ * canonical machine as described in the NIST RS274/NGC v3
+ * the canonical machine is a layer between gcode parser and motion controller
+ * It keeps state and executes commands - passing the
+ * stateless commands to the motion planning layer.
+ */
+/* --- System state contexts - Gcode models ---
+ *
+ *	Useful reference for doing C callbacks http://www.newty.de/fpt/fpt.html
+ *
+ *	There are 3 temporal contexts for system state:
+ *	  - The gcode model in the canonical machine (the MODEL context, held in gm)
+ *	  - The gcode model used by the planner (PLANNER context, held in bf's and mm)
+ *	  - The gcode model used during motion for reporting (RUNTIME context, held in mr)
+ *
+ *	It's a bit more complicated than this. The 'gm' struct contains the core Gcode model
+ *	context. This originates in the canonical machine and is copied to each planner buffer
+ *	(bf buffer) during motion planning. Finally, the gm context is passed to the runtime
+ *	(mr) for the RUNTIME context. So at last count the Gcode model exists in as many as
+ *	30 copies in the system. (1+28+1)
+ *
+ *	Depending on the need, any one of these contexts may be called for reporting or by
+ *	a function. Most typically, all new commends from the gcode parser work form the MODEL
+ *	context, and status reports pull from the RUNTIME while in motion, and from MODEL when
+ *	at rest. A convenience is provided in the ACTIVE_MODEL pointer to point to the right
+ *	context.
+ */
+/* --- Synchronizing command execution ---
+ *
+ *	Some gcode commands only set the MODEL state for interpretation of the current Gcode
+ *	block. For example, cm_set_feed_rate(). This sets the MODEL so the move time is
+ *	properly calculated for the current (and subsequent) blocks, so it's effected
+ *	immediately.
+ *
+ *	"Synchronous commands" are commands that affect the runtime need to be synchronized
+ *	with movement. Examples include G4 dwells, program stops and ends, and most M commands.
+ *	These are queued into the planner queue and execute from the queue. Synchronous commands
+ *	work like this:
+ *
+ *	  - Call the cm_xxx_xxx() function which will do any input validation and return an
+ *		error if it detects one.
+ *
+ *	  - The cm_ function calls mp_queue_command(). Arguments are a callback to the _exec_...()
+ *		function, which is the runtime execution routine, and any arguments that are needed
+ *		by the runtime. See plan_command.h for details
+ *
+ *	  - mp_queue_command() stores the callback and the args in a planner buffer.
+ *
+ *	  - When planner execution reaches the buffer it executes the callback w/ the args.
+ *		Take careful note that the callback executes under an interrupt, so beware of
+ *		variables that may need to be volatile.
+ *
+ *	Note:
+ *	  - The synchronous command execution mechanism uses 2 vectors in the bf buffer to store
+ *		and return values for the callback. It's obvious, but impractical to pass the entire
+ *		bf buffer to the callback as some of these commands are actually executed locally
+ *		and have no buffer.
+ */
+ 
+ 
+//******includes*******//
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "plan_command.h"
+#include "stepper.h"
+#include "HAL.h"
+#include "encoder.h"
+#include "debugging.h"
+#include "recorder.h"
+#include "util.h"
+//////////////////////
+
+//******globals*******//
+MACHINE_LOCAL cmSingleton_t cm;
+/////////////////////
+
+//_cm_get_tool_length_offset//
+//input : none
+//output : tool length the Z offset takes now
+//fuction : 
+//notes : 0 in machine coordinates, G53 or ABSOLUTE_COORDS
+//additions:
+//
+static float _cm_get_tool_length_offset(void){
+	if((cm.gm.absolute_override == true) || (cm.gm.coordinate_system == ABSOLUTE_COORDS)){
+		return 0;
+	}
+	return cm.tool_length_offset;
+}
+
+//_cm_update_active_offset//
+//input : none
+//output : none
+//fuction : recomputes the effective work offset of every axis
+//notes : called only when something it depends on changes, G10, G92.x, G54-G59, G53, G43 and M6
+//additions: the tool length rides on Z like a work offset, so a target costs the same with G43 on.
+//it's left out of ABSOLUTE_COORDS, the machine coordinates the cycles move in
+//
+static void _cm_update_active_offset(void){
+	for(uint8_t axis = X_AXIS; axis < AXES; ++axis){
+		if(cm.gm.absolute_override == true){
+			cm.active_offset[axis] = 0;
+		}else if(cm.origin_offset_enable){
+			cm.active_offset[axis] = cm.coord_offset[cm.gm.coordinate_system][axis] + cm.origin_offset[axis];
+		}else{
+			cm.active_offset[axis] = cm.coord_offset[cm.gm.coordinate_system][axis];
+		}
+	}
+	cm.active_offset[Z_AXIS] += _cm_get_tool_length_offset();
+}
+
+//_cm_update_tool_length//
+//input : none
+//output : none
+//fuction : looks the G43 tool up in the table and folds its length into the active offset
+//notes : called on G43, G49, M6 and G10 L1, not per block
+//additions:
+//
+static void _cm_update_tool_length(void){
+	float offset = 0;
+	if(cm.gm.tool_length_comp == TOOL_LENGTH_COMP_ON){
+		uint8_t tool = (cm.tool_length_tool == TOOL_LOADED)? cm.gm.tool : cm.tool_length_tool;
+		offset = cm.tool_table[tool].length;
+	}
+	if(offset == cm.tool_length_offset) return;
+	cm.tool_length_offset = offset;
+	_cm_update_active_offset();
+}
+
+//cm_get_active_coord_offset//
+//input : axis number
+//output : coordinate offset of an axis
+//fuction : 
+//notes : 
+//additions: 
+//
+float cm_get_active_coord_offset(uint8_t axis){
+	return cm.active_offset[axis];
+}
+
+void cm_set_work_offsets(GState_t *gcode_state)
+{
+	copy_vector(gcode_state->work_offset, cm.active_offset);
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+void cm_set_model_target_mask(float values[], uint32_t flags){
+	if(cm.gm.distance_mode == ABSOLUTE_MODE){		//tested once, not per axis
+		FOR_AXES(axis,
+			if(flags & GF_BIT(axis)){		//or axis state is disabled
+				cm.gm.target[axis] = cm.active_offset[axis] + _AXIS_TO_MILLI(axis,values[axis]);
+			}
+		)
+	}else{
+		FOR_AXES(axis,
+			if(flags & GF_BIT(axis)){
+				cm.gm.target[axis] += _AXIS_TO_MILLI(axis,values[axis]);
+			}
+		)
+	}
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+void canonical_init(void){
+	memset(&cm.gm,0,sizeof(GState_t));
+	memset(&cm.gn,0,sizeof(GIn_t));
+	cm.gf = 0;
+	cm.tool_length_offset = 0;			// G49, the tool table is kept
+	cm.tool_length_tool = TOOL_LOADED;
+	
+	ACTIVE_MODEL = MODEL;
+	// set gcode defaults
+	cm_select_unit_mode(GCODE_DEFAULT_UNITS);
+	cm_set_coord_system(G54);
+	cm_select_plane(GCODE_DEFAULT_PLANE);
+	cm_select_path_control(GCODE_DEFAULT_PATH_CONTROL);
+	cm_select_distance_mode(GCODE_DEFAULT_DISTANCE_MODE);
+	cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);// always the default
+	// never start a machine in a motion mode
+	cm.gm.motion_mode = MOTION_MODE_CANCEL_MOTION_MODE;
+	cc_init();											// G40
+	cm.machine_state = MACHINE_READY;
+	
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+void cm_set_model_linenum(uint32_t linenum){
+	cm.gm.linenum = linenum;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+uint8_t cm_get_motion_mode(GState_t *gcode_state)
+{
+	return gcode_state->motion_mode;
+}
+
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_set_feed_rate_mode(uint8_t mode){
+	cm.gm.feedrate_mode = mode;
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_set_feed_rate(float feed_rate){
+#if FEATURE_INVERSE_TIME
+	if(cm.gm.feedrate_mode == INVERSE_TIME_MODE){
+		cm.gm.feedrate = 1/cm.gn.feedrate;  //total time to finish the move in minutes
+	}
+	else
+#endif
+	{
+		cm.gm.feedrate = _TO_MILLI(feed_rate);
+	}
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_select_plane(uint8_t plane){
+	cm.gm.plane_select = plane;
+	return STAT_OK;
+}
+
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_select_unit_mode(uint8_t mode){
+	cm.gm.units_mode = mode;
+	cm.unit_scale = (mode == INCHES)? MM_PER_INCH : 1.0f;
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+		cm.axis_scale[axis] = AXIS_IS_ROTARY(axis)? 1.0f : cm.unit_scale;
+	}
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_select_path_control(uint8_t path){
+	cm.gm.path_control = path;
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_select_distance_mode(uint8_t mode){
+	cm.gm.distance_mode = mode;
+	return STAT_OK;
+}
+//cm_set_model_target//
+//input : values, one float flag per axis as the old GIn_t had them
+//output : none
+//fuction : cm_set_model_target_mask for arc_planner.c
+//notes : arc_planner.c is still built on the float word flags, it calls this with the flags
+//cm_arc_feed_mask expanded for it. goes away once it takes the mask
+//additions:
+//
+void cm_set_model_target(float values[], float flags[]){
+	uint32_t mask = 0;
+	FOR_AXES(axis,
+		if(flags[axis] > 0.0f){mask |= GF_BIT(axis);}
+	)
+	cm_set_model_target_mask(values,mask);
+}
+
+//_cm_plan_line//
+//input : none
+//output : STAT_OK or the cutter compensation error
+//fuction : plans the model move, through the cutter compensation when it's on
+//notes : a refused move takes the model target back to the model position
+//additions:
+//
+static stat_t _cm_plan_line(void){
+	if(cm.gm.cutter_comp == CUTTER_COMP_OFF){
+		if(cc_busy()){return cc_defer_line(&cm.gm);}	// after the lines of the last compensated arc
+		mp_plan_line(&cm.gm);
+		return STAT_OK;
+	}
+	stat_t status = cc_plan_line(&cm.gm);
+	if(status != STAT_OK){
+		copy_vector(cm.gm.target,cm.position);
+	}
+	return status;
+}
+
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_straight_traverse(float target[],uint32_t flags){
+	db_start_session(CANONICAL_TIME);
+	cm.gm.motion_mode = MOTION_MODE_STRAIGHT_TRAVERSE;
+	cm_set_model_target_mask(target,flags);
+	//check soft limits
+	//return if soft limit alerted
+	cm_set_work_offsets(&cm.gm);			//the runtime reports work position with the offsets of the move
+	//start cycle
+	stat_t status = _cm_plan_line();
+	if(status != STAT_OK){
+		db_end_session(CANONICAL_TIME);
+		return status;
+	}
+	//finalize the move
+	memcpy(&cm.position,&cm.gm.target,sizeof(cm.gm.target));
+	db_end_session(CANONICAL_TIME);
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_straight_feed(float target[],uint32_t flags){
+	//if in inverse time feed mode and the feed rate is omitted its an error and a return is issued
+	db_start_session(CANONICAL_TIME);
+#if FEATURE_INVERSE_TIME
+	if ((cm.gm.feedrate_mode != INVERSE_TIME_MODE) && (fp_ZERO(cm.gm.feedrate))) {
+#else
+	if (fp_ZERO(cm.gm.feedrate)) {
+#endif
+		return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
+	}
+	cm.gm.motion_mode = MOTION_MODE_STRAIGHT_FEED;
+	cm_set_model_target_mask(target,flags);
+	//check soft limits
+	//return if soft limit alerted
+	
+	cm_set_work_offsets(&cm.gm);
+	cm_cycle_start();
+	stat_t status = _cm_plan_line();
+	if(status != STAT_OK){
+		db_end_session(CANONICAL_TIME);
+		return status;
+	}
+	cm_finalize_move();
+	db_end_session(CANONICAL_TIME);
+	return STAT_OK;
+}
+
+//cm_arc_feed_mask//
+//input : target, word mask of the block, IJK offsets, R
+//output : status of cm_arc_feed or cc_arc_feed
+//fuction : G2/G3 into arc_planner.c, into the cutter compensation while it's on
+//notes : arc_planner.c keeps the float word flags of the old GIn_t in cm_arc_feed and
+//cm_set_model_target until it's rebuilt on the mask, the axis bits are expanded for it here
+//additions:
+//
+stat_t cm_arc_feed_mask(float target[], uint32_t flags, float offsets[], float radius){
+	if(cm.gm.cutter_comp != CUTTER_COMP_OFF){
+		return cc_arc_feed(target,flags,offsets,radius);
+	}
+	float axis_flags[AXES];
+	FOR_AXES(axis,
+		axis_flags[axis] = (flags & GF_BIT(axis))? 1.0f : 0.0f;
+	)
+	return cm_arc_feed(target,axis_flags,offsets,radius);
+}
+
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_set_coord_offsets(uint8_t coord_system, float target[], uint32_t flags){
+	if((coord_system<G54)||(coord_system>G59)){
+		return STAT_INPUT_VALUE_OUT_OF_RANGE;
+	}
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+		if(flags & GF_BIT(axis)){
+			cm.coord_offset[coord_system][axis] = _AXIS_TO_MILLI(axis,target[axis]);
+		}
+	}
+	if(coord_system == cm.gm.coordinate_system){_cm_update_active_offset();}
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_set_coord_system(uint8_t coord){
+	cm.gm.coordinate_system = coord;
+	_cm_update_active_offset();
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+void cm_set_absolute_override(uint8_t state){
+	if(cm.gm.absolute_override == state) return;		//called twice per block, mostly with no change
+	cm.gm.absolute_override = state;
+	_cm_update_active_offset();
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_set_origin_offsets(float values[], uint32_t flags){
+	cm.origin_offset_enable = 1;
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+		if(flags & GF_BIT(axis)){
+			cm.origin_offset[axis] = cm.position[axis] - cm.coord_offset[cm.gm.coordinate_system][axis] - _AXIS_TO_MILLI(axis,values[axis]);
+		}
+	}
+	if(flags & GF_BIT(Z_AXIS)){
+		cm.origin_offset[Z_AXIS] -= _cm_get_tool_length_offset();		//the tool length stays on top of it
+	}
+	_cm_update_active_offset();
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_reset_origin_offsets(void){
+	cm.origin_offset_enable = 0;
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+			cm.origin_offset[axis] = 0;
+		}
+	_cm_update_active_offset();
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_suspend_origin_offsets(void){
+	cm.origin_offset_enable = 0;
+	_cm_update_active_offset();
+	return STAT_OK;
+}
+////
+//input : 
+//output : 
+//fuction : 
+//notes : 
+//additions: 
+//
+stat_t cm_resume_origin_offsets(void){
+	cm.origin_offset_enable = 1;
+	_cm_update_active_offset();
+	return STAT_OK;
+}
+
+/* --- synchronous commands, see the notes at the top and plan_command.h --- */
+
+static void _exec_spindle_control(float *value, float *flag);
+static void _exec_coolant_control(float *value, float *flag);
+static void _exec_change_tool(float *value, float *flag);
+
+//cm_dwell//
+//input : dwell time in seconds, P word
+//output : STAT_OK or the error
+//fuction : queues a G4 dwell
+//notes : 
+//additions:
+//
+stat_t cm_dwell(float seconds){
+	if(seconds < 0){return STAT_INPUT_VALUE_OUT_OF_RANGE;}
+	return cc_queue_dwell(seconds);				// with the held compensated move
+}
+
+//cm_set_spindle_speed//
+//input : S in RPM
+//output : STAT_OK
+//fuction : sets the model speed
+//notes : the spindle output is on/off, the speed isn't queued until there's a speed output
+//additions:
+//
+stat_t cm_set_spindle_speed(float speed){
+	cm.gm.spindle_speed = speed;
+	return STAT_OK;
+}
+
+//cm_spindle_control//
+//input : SPINDLE_OFF, SPINDLE_CW, SPINDLE_CCW
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : M3, M4, M5 in the model now and on the spindle output when the runtime gets there
+//notes : the parser checked the room for it, cc_command_room. a refused command leaves the model
+//as it was
+//additions:
+//
+stat_t cm_spindle_control(uint8_t spindle_mode){
+	float value[AXES] = {(float)spindle_mode};
+	float flag[AXES] = {1};
+	uint8_t previous = cm.gm.spindle_mode;
+	cm.gm.spindle_mode = spindle_mode;		//the queued command carries the model
+	stat_t status = cc_queue_command(_exec_spindle_control,value,flag);
+	if(status != STAT_OK){cm.gm.spindle_mode = previous;}
+	return status;
+}
+
+static void _exec_spindle_control(float *value, float *flag){
+	spindle_set((uint8_t)value[0]);
+}
+
+//cm_coolant_control//
+//input : COOLANT_OFF, COOLANT_MIST, COOLANT_FLOOD
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : M7, M8, M9, mist and flood add up, M9 turns both off, COOLANT_ON is M7 M8 in one block
+//notes : the command carries both outputs so it doesn't depend on the commands queued before.
+//a refused command leaves the model as it was
+//additions:
+//
+stat_t cm_coolant_control(uint8_t coolant){
+	uint8_t mist = cm.gm.mist_coolant;
+	uint8_t flood = cm.gm.flood_coolant;
+	switch(coolant){
+		case COOLANT_MIST: cm.gm.mist_coolant = true; break;
+		case COOLANT_FLOOD: cm.gm.flood_coolant = true; break;
+		case COOLANT_ON: cm.gm.mist_coolant = true; cm.gm.flood_coolant = true; break;
+		default: cm.gm.mist_coolant = false; cm.gm.flood_coolant = false;
+	}
+	float value[AXES] = {(float)cm.gm.mist_coolant, (float)cm.gm.flood_coolant};
+	float flag[AXES] = {1, 1};
+	stat_t status = cc_queue_command(_exec_coolant_control,value,flag);
+	if(status != STAT_OK){
+		cm.gm.mist_coolant = mist;
+		cm.gm.flood_coolant = flood;
+	}
+	return status;
+}
+
+static void _exec_coolant_control(float *value, float *flag){
+	coolant_set((uint8_t)value[0],(uint8_t)value[1]);
+}
+
+//cm_select_tool//
+//input : T word
+//output : STAT_OK, STAT_INPUT_VALUE_OUT_OF_RANGE past the tool table
+//fuction : declares the tool the next M6 changes to
+//notes : 
+//additions:
+//
+stat_t cm_select_tool(uint8_t tool_select){
+	if(tool_select >= TOOLS){return STAT_INPUT_VALUE_OUT_OF_RANGE;}	//every tool has a table entry
+	cm.gm.tool_select = tool_select;
+	return STAT_OK;
+}
+
+//cm_change_tool//
+//input : M6 flag
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : makes the selected tool the model tool and queues the change for the runtime
+//notes : a G43 without H takes the new length at once, the moves after the M6 are planned with it
+//and the ones before keep theirs, so nothing waits for the planner to drain. a refused change
+//leaves the tool and its length as they were
+//additions:
+//
+stat_t cm_change_tool(uint8_t tool_change){
+	float value[AXES] = {(float)cm.gm.tool_select};
+	float flag[AXES] = {1};
+	uint8_t previous = cm.gm.tool;
+	cm.gm.tool = cm.gm.tool_select;
+	_cm_update_tool_length();
+	stat_t status = cc_queue_command(_exec_change_tool,value,flag);
+	if(status != STAT_OK){
+		cm.gm.tool = previous;
+		_cm_update_tool_length();
+	}
+	return status;
+}
+
+static void _exec_change_tool(float *value, float *flag){
+	mr.gm.tool = (uint8_t)value[0];				//the runtime model reports the tool in the spindle
+}
+
+//cm_set_tool_table//
+//input : tool, P word, axis words and R of the block
+//output : STAT_OK, STAT_INPUT_VALUE_OUT_OF_RANGE past the tool table
+//fuction : G10 L1, Z sets the length and R the radius of a tool table entry
+//notes : the words left out keep their value
+//additions:
+//
+stat_t cm_set_tool_table(uint8_t tool, float target[], uint32_t flags, float radius){
+	if(tool >= TOOLS){return STAT_INPUT_VALUE_OUT_OF_RANGE;}
+	if(flags & GF_BIT(Z_AXIS)){
+		cm.tool_table[tool].length = _TO_MILLI(target[Z_AXIS]);
+	}
+	if(flags & GF_BIT(GF_RADIUS)){
+		cm.tool_table[tool].diameter = 2*_TO_MILLI(radius);
+	}
+	_cm_update_tool_length();						//it may be the G43 tool
+	return STAT_OK;
+}
+
+//cm_tool_length_comp//
+//input : TOOL_LENGTH_COMP_ON, TOOL_LENGTH_COMP_OFF, H word or TOOL_LOADED
+//output : STAT_OK, STAT_INPUT_VALUE_OUT_OF_RANGE past the tool table
+//fuction : G43 H, G49
+//notes : the offset applies from the next target, the tool doesn't move on its own
+//additions:
+//
+stat_t cm_tool_length_comp(uint8_t mode, uint8_t tool){
+	if((tool >= TOOLS) && (tool != TOOL_LOADED)){return STAT_INPUT_VALUE_OUT_OF_RANGE;}
+	cm.gm.tool_length_comp = mode;
+	cm.tool_length_tool = tool;
+	_cm_update_tool_length();
+	return STAT_OK;
+}
+
+
+
+void cm_cycle_start(void)
+{
+	cm.machine_state = MACHINE_CYCLE;
+	if (cm.cycle_state == CYCLE_OFF) {					// don't (re)start homing, probe or other canned cycles
+		cm.cycle_state = CYCLE_MACHINING;
+	}
+}
+
+void cm_finalize_move(void) {
+	copy_vector(cm.position, cm.gm.target);		// update model position
+
+#if FEATURE_INVERSE_TIME
+	// if in ivnerse time mode reset feed rate so next block requires an explicit feed rate setting
+	if ((cm.gm.feedrate_mode == INVERSE_TIME_MODE) && (cm.gm.motion_mode == MOTION_MODE_STRAIGHT_FEED)) {
+		cm.gm.feedrate = 0;
+	}
+#endif
+}
+
+
+stat_t cm_soft_alarm(stat_t status)
+{
+	cm.machine_state = MACHINE_ALARM;
+	return (status);						// NB: More efficient than inlining rpt_exception() call.
+}
+
+stat_t cm_hard_alarm(stat_t status)
+{
+	// stop the motors and the spindle
+	st_init();							// hard stop
+	fr_freeze();						// keep the segments that led here
+	spindle_set(SPINDLE_OFF);
+	coolant_set(false,false);
+	cm.machine_state = MACHINE_SHUTDOWN;
+	return (status);
+}
+
+uint8_t cm_get_machine_state(void) { return cm.machine_state;};
+
+uint8_t cm_get_runtime_busy(void) {return mp_get_runtime_busy();}
+
+///getters
+uint8_t cm_get_coordinate_system(GState_t* gstate){
+	return gstate->coordinate_system;
+}
+uint8_t cm_get_units_mode(GState_t* gstate){
+	return gstate->units_mode;
+}
+uint8_t cm_get_distance_mode(GState_t* gstate){
+	return gstate->distance_mode;
+}
+uint8_t cm_get_feedrate_mode(GState_t* gstate){
+	return gstate->feedrate_mode;
+}
+uint8_t cm_get_feedrate(GState_t* gstate){
+	return gstate->feedrate;
+}
+
+void cm_set_motion_mode(GState_t* gstate, uint8_t motion_mode){
+	gstate->motion_mode = motion_mode;
+}
+
+float cm_get_axis_jerk(uint8_t axis){
+	return cm.a[axis].max_jerk;
+}
+
+void cm_set_axis_jerk(uint8_t axis, float jerk){
+	cm.a[axis].max_jerk = jerk;
+	cm.a[X_AXIS].jerk_recip = 1.0f/((cm.a[X_AXIS].max_jerk)*JERK_MULTI);
+}
+void cm_request_cycle_start(void) { cm.cycle_start_requested = true; }
+
+void cm_set_position(uint8_t axis, float position)
+{
+	// TODO: Interlock involving runtime_busy test
+	cm.position[axis] = position;
+	cm.gm.target[axis] = position;
+	mp_set_planner_position(axis, position);
+	mp_set_runtime_position(axis, position);
+	mp_set_steps_to_runtime_position();
+}
+
+
+void cm_set_motion_state(uint8_t motion_state)
+{
+	cm.motion_state = motion_state;
+
+	switch (motion_state) {
+		case (MOTION_STOP): { ACTIVE_MODEL = MODEL; break; }
+		case (MOTION_RUN):  { ACTIVE_MODEL = RUNTIME; break; }
+		case (MOTION_HOLD): { ACTIVE_MODEL = RUNTIME; break; }
+	}
+}
+
+float cm_get_absolute_position(GState_t *gcode_state, uint8_t axis)
+{
+	if (gcode_state == MODEL) return (cm.position[axis]);
+	return (mp_get_runtime_absolute_position(axis));
+}
@@ -1,320 +1,469 @@
-
-#ifndef CANONICAL_H
-#define CANONICAL_H
-
-#define MODEL 	(GState_t *)&cm.gm		// absolute pointer from canonical machine gm model
-#define PLANNER (GState_t *)&bf->gm		// relative to buffer *bf is currently pointing to
-#define RUNTIME (GState_t *)&mr.gm		// absolute pointer from runtime mm struct
-#define ACTIVE_MODEL cm.am					// active model pointer is maintained by state management
-
-#define _TO_MILLI(a) ((cm.gm.units_mode == INCHES) ? (a * MM_PER_INCH) : a)
-
-typedef struct GCodeInput{
-	uint32_t linenum;			//N code
-	
-	uint8_t programflow;	//ending and stopping program
-	
-	uint8_t next_action;	//non-modal group 0
-	uint8_t motion_mode;	//modal group 1
-	
-	uint8_t feedrate_mode;		//feedrate setting
-	float feedrate;						//F in millimeter per minute
-	
-	
-	float target[AXES];		//target point
-	
-	uint8_t plane_select;			//modal group 2
-	uint8_t units_mode;				//modal group 6
-	uint8_t distance_mode;		//modal group 3
-	uint8_t coordinate_system;		//modal group 12
-	uint8_t absolute_override;		//G53 flag, for the current block only
-	uint8_t path_control;			//modal group 13
-	
-	uint8_t tool;					//tool after declaring the tool with T and assigning it with M6
-	uint8_t tool_select;	//tool declaring T value
-	uint8_t tool_change;	//tool assigning M6, assigning tool_select value to tool
-	
-	uint8_t mist_coolant;		//TRUE=MIST ON, FALSE=MIST OFF M7,M9
-	uint8_t flood_coolant;	//TRUE=FLOOD ON, FALSE=FLOOOD OFF M8,M9
-	uint8_t coolant_off;
-	
-	float parameter;				//P- parameter
-	float radius;						//R, radius/R value
-	float center_offsets[3];		//IJK
-	
-	float spindle_speed;		//S in RPM
-	uint8_t spindle_mode;		//spindle setting
-	//u have 3 chars that won't affect size
-	
-}GIn_t;
-
-
-typedef struct GCodeState{
-	
-	uint32_t linenum;			//N code
-	
-	float move_time;
-
-	float target[AXES];		//target point
-	float work_offset[AXES];
-	float spindle_speed;		//S in RPM
-	float feedrate;						//F in millimeter per minute
-	float parameter;				//P- parameter
-	
-	uint8_t motion_mode;	//modal group 1
-	uint8_t feedrate_mode;		//feedrate setting
-	uint8_t plane_select;			//modal group 2
-	uint8_t units_mode;				//modal group 6
-	uint8_t distance_mode;		//modal group 3
-	uint8_t coordinate_system;		//modal group 12
-	uint8_t absolute_override;		//G53 flag, for the current block only
-	uint8_t path_control;			//modal group 13
-	uint8_t tool;					//tool after declaring the tool with T and assigning it with M6
-	uint8_t tool_select;	//tool declaring T value
-	uint8_t mist_coolant;		//TRUE=MIST ON, FALSE=MIST OFF M7,M9
-	uint8_t flood_coolant;	//TRUE=FLOOD ON, FALSE=FLOOOD OFF M8,M9
-	uint8_t spindle_mode;		//spindle setting
-	//u have 3 chars that won't affect size
-}GState_t;
-
-typedef struct AxisConfig{
-	float max_velocity;		//max velocity in mm/min for traverse motion
-	float max_feedrate;		//max velocity in mm/min for feed motion
-	float max_jerk;				//max jerk
-	float jerk_recip;
-	float jerk_sqrt;
-	float jerk_sqrt_recip;
-	float max_travel;			//max work envelope for soft limits test
-	float min_travel;			//min work envelope for soft limits test
-	float junction_dev;
-	float search_velocity;				// homing search velocity
-	float latch_velocity;				// homing latch velocity
-	float latch_backoff;				// backoff from switches prior to homing latch movement
-	float zero_backoff;					// backoff from switches for machine zero
-	float homing_jerk;
-}Axiscfg_t;
-
-
-typedef struct cmSingleton{
-	float coord_offset[COORDS+1][AXES];
-	float origin_offset[AXES];
-	float position[AXES];
-	
-	float junction_acceleration;
-	
-	Axiscfg_t a[AXES];
-	
-	uint8_t origin_offset_enable;
-	
-	uint8_t homed[AXES];
-	uint8_t machine_state;
-	uint8_t cycle_state;
-	uint8_t motion_state;
-	uint8_t homing_state;
-	uint8_t probe_state;
-	
-	uint8_t cycle_start_requested;
-	
-	float probe_results[AXES];
-	float chordal_tolerance;
-	float arc_segment_len;
-	GState_t *am;
-	
-	GState_t gm;		//gcode model
-	GIn_t gn;				//gcode input values
-	GIn_t gf;				//gcode input flags
-}cmSingleton_t;
-
-extern cmSingleton_t cm;
-
-
-enum MachineState {
-	MACHINE_INITIALIZING = 0,		// machine is initializing
-	MACHINE_READY,					// machine is ready for use
-	MACHINE_ALARM,					// machine in soft alarm state
-	MACHINE_PROGRAM_STOP,			// program stop or no more blocks
-	MACHINE_PROGRAM_END,			// program end
-	MACHINE_CYCLE,					// machine is running (cycling)
-	MACHINE_SHUTDOWN,				// machine in hard alarm state (shutdown)
-};
-
-enum CycleState {
-	CYCLE_OFF = 0,					// machine is idle
-	CYCLE_MACHINING,				// in normal machining cycle
-	CYCLE_PROBE,					// in probe cycle
-	CYCLE_HOMING,					// homing is treated as a specialized cycle
-	CYCLE_JOG						// jogging is treated as a specialized cycle
-};
-
-enum MotionState {
-	MOTION_STOP = 0,				// motion has stopped
-	MOTION_RUN,						// machine is in motion
-	MOTION_HOLD						// feedhold in progress
-};
-
-enum HomingState{
-	HOMING_NOT_HOMED =0,
-	HOMING_HOMED,
-	HOMING_WAITING
-};
-
-enum cmProbeState {					// applies to cm.probe_state
-	PROBE_FAILED = 0,				// probe reached endpoint without triggering
-	PROBE_SUCCEEDED = 1,			// probe was triggered, cm.probe_results has position
-	PROBE_WAITING					// probe is waiting to be started
-};
-
-enum NEXT_ACTION{
-	ACTION_DEFAULT = 0,
-	ACTION_DWELL,
-	ACTION_SET_COORD_DATA,
-	ACTION_SET_AXIS_OFFSETS,
-	ACTION_RESET_AXIS_OFFSETS,
-	ACTION_SUSPEND_AXIS_OFFSETS,
-	ACTION_RESUME_AXIS_OFFSETS,
-	ACTION_GOTO_G28_POSITION,
-	ACTION_SET_G28_POSITION,
-	ACTION_SEARCH_HOME,
-	ACTION_SET_ABSOLUTE_ORIGIN,
-	ACTION_HOMING_NO_SET,
-	ACTION_GOTO_G30_POSITION,
-	ACTION_SET_G30_POSITION,
-	ACTION_STRAIGHT_PROBE
-	
-};
-
-enum MOTION_MODE{
-	MOTION_MODE_STRAIGHT_TRAVERSE = 0, //G0
-	MOTION_MODE_STRAIGHT_FEED, //G1
-	MOTION_MODE_CW_ARC,					//G2
-	MOTION_MODE_CCW_ARC,				//G3
-	MOTION_MODE_CANCEL_MOTION_MODE,			//G80
-	MOTION_MODE_CANNED_81,			//G81
-	MOTION_MODE_CANNED_82,			//G82
-	MOTION_MODE_CANNED_83,			//G83
-	MOTION_MODE_CANNED_84,			//G84
-	MOTION_MODE_CANNED_85,			//G85
-	MOTION_MODE_CANNED_86,			//G86
-	MOTION_MODE_CANNED_87,			//G87
-	MOTION_MODE_CANNED_88,			//G88
-	MOTION_MODE_CANNED_89			//G89
-};
-
-enum FEED_RATE_MODE{
-	INVERSE_TIME_MODE = 0,  //G93
-	UNITS_PER_MINUTE_MODE,	//G94
-	UNITS_PER_REV_MODE			//G95
-};
-
-enum PLANE_SELECT{
-	XY_PLANE = 0,		//G17
-	XZ_PLANE,				//G18
-	YZ_PLANE				//G19
-};
-
-enum UNIT_SYSTEM{
-	INCHES = 0,			//G20
-	MILLIMETERS,		//G21
-};
-
-enum COORDINATE_SYSTEM{
-	ABSOLUTE_COORDS = 0,			//machine coordinate system
-	G54,											//G54 coordinate
-	G55,											//G55 coordinate
-	G56,											//G56 coordinate
-	G57,											//G57 coordinate
-	G58,											//G58 coordinate
-	G59,											//G59 coordinate
-};
-
-enum PATH_CONTROL{
-	PATH_EXACT_PATH = 0,					//G61
-	PATH_EXACT_STOP,							//G61.1
-	PATH_CONTINUOUS								//G64
-};
-
-enum DISTANCE_SYSTEM{
-	ABSOLUTE_MODE = 0,			//G90
-	INCREMENTAL_MODE				//G91
-};
-
-enum SPINDLE_MODE{
-	SPINDLE_OFF = 0,					//M5
-	SPINDLE_CW,								//M3
-	SPINDLE_CCW								//M4
-};
-
-enum COOLANT_MODE{
-	COOLANT_OFF = 0,			//M9
-	COOLANT_ON,
-	COOLANT_MIST,					//M7
-	COOLANT_FLOOD					//M8
-};
-
-enum PROGRAM_FLOW{
-	PROGRAM_STOP = 0,
-	PROGRAM_END
-};
-
-//for now we will be supporting modal groups G(1,2,3,5,6,12,13) M(4,6,7,8) and non-modal group 0
-enum MODAL_GROUP{
-	MODAL_GROUP_G0 = 0,
-	MODAL_GROUP_G1,
-	MODAL_GROUP_G2,
-	MODAL_GROUP_G3,
-	MODAL_GROUP_G5,
-	MODAL_GROUP_G6,
-	MODAL_GROUP_G12,
-	MODAL_GROUP_G13,
-	MODAL_GROUP_M4,
-	MODAL_GROUP_M6,
-	MODAL_GROUP_M7,
-	MODAL_GROUP_M8,
-};
-
-void cm_set_work_offsets(GState_t *gcode_state);
-void cm_set_model_target(float values[], float flags[]);
-void canonical_init(void);
-void cm_set_model_linenum(uint32_t linenum);
-uint8_t cm_get_motion_mode(GState_t *gcode_state);
-stat_t cm_set_feed_rate_mode(uint8_t mode);
-stat_t cm_set_feed_rate(float feed_rate);
-stat_t cm_select_plane(uint8_t plane);
-stat_t cm_select_unit_mode(uint8_t mode);
-stat_t cm_select_path_control(uint8_t path);
-stat_t cm_select_distance_mode(uint8_t mode);
-stat_t cm_set_coord_offsets(uint8_t coord_system, float target[], float flags[]);
-stat_t cm_set_coord_system(uint8_t coord);
-void cm_set_absolute_override(uint8_t state);
-stat_t cm_set_origin_offsets(float values[], float flags[]);
-stat_t cm_reset_origin_offsets(void);
-stat_t cm_suspend_origin_offsets(void);
-stat_t cm_resume_origin_offsets(void);
-stat_t cm_straight_traverse(float target[],float flags[]);
-stat_t cm_straight_feed(float target[],float flags[]);
-stat_t cm_arc_feed(float target[], float flags[],float offsets[],float radius);
-stat_t cm_arc_callback(void);
-void cm_cycle_start(void);
-void cm_finalize_move(void);
-stat_t cm_soft_alarm(stat_t status);
-stat_t cm_hard_alarm(stat_t status);
-uint8_t cm_get_machine_state(void);
-uint8_t cm_get_runtime_busy(void);
-stat_t cm_homing_callback(void);
-uint8_t cm_get_coordinate_system(GState_t* gstate);
-uint8_t cm_get_units_mode(GState_t* gstate);
-uint8_t cm_get_distance_mode(GState_t* gstate);
-uint8_t cm_get_feedrate_mode(GState_t* gstate);
-uint8_t cm_get_feedrate(GState_t* gstate);
-void cm_set_motion_mode(GState_t* gstate, uint8_t motion_mode);
-float cm_get_axis_jerk(uint8_t axis);
-void cm_set_axis_jerk(uint8_t axis, float jerk);
-void cm_request_cycle_start(void);
-void cm_set_position(uint8_t axis, float position);
-void cm_abort_arc(void);
-void cm_set_motion_state(uint8_t motion_state);
-float cm_get_absolute_position(GState_t *gcode_state, uint8_t axis);
-stat_t cm_cycle_homing_start(void);
-stat_t cm_straight_probe(float target[],float flags[]);
-#endif
-
+
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include "config.h"
+
+#define MODEL 	(GState_t *)&cm.gm		// absolute pointer from canonical machine gm model
+#define PLANNER (GState_t *)&bf->gm		// relative to buffer *bf is currently pointing to
+#define RUNTIME (GState_t *)&mr.gm		// absolute pointer from runtime mm struct
+#define ACTIVE_MODEL cm.am					// active model pointer is maintained by state management
+
+#define _TO_MILLI(a) ((a) * cm.unit_scale)		//unit_scale follows G20/G21
+#define _AXIS_TO_MILLI(axis,a) ((a) * cm.axis_scale[axis])	//rotary axes stay in degrees
+#define AXIS_IS_ROTARY(axis) ((axis) >= A_AXIS)
+
+#define TOOLS 16								//tool table entries, T0 is the empty spindle
+#define TOOL_LOADED 0xFF				//G43 without H, the offset follows the tool M6 loads
+
+typedef struct GCodeInput{
+	uint32_t linenum;			//N code
+	
+	uint8_t programflow;	//ending and stopping program
+	
+	uint8_t next_action;	//non-modal group 0
+	uint8_t motion_mode;	//modal group 1
+	
+	uint8_t feedrate_mode;		//feedrate setting
+	float feedrate;						//F in millimeter per minute
+	
+	
+	float target[AXES];		//target point
+	
+	uint8_t plane_select;			//modal group 2
+	uint8_t units_mode;				//modal group 6
+	uint8_t distance_mode;		//modal group 3
+	uint8_t coordinate_system;		//modal group 12
+	uint8_t absolute_override;		//G53 flag, for the current block only
+	uint8_t path_control;			//modal group 13
+	uint8_t cutter_comp;			//modal group 7
+	uint8_t tool_length_comp;	//modal group 8
+	
+	uint8_t tool;					//tool after declaring the tool with T and assigning it with M6
+	uint8_t tool_select;	//tool declaring T value
+	uint8_t tool_change;	//tool assigning M6, assigning tool_select value to tool
+	
+	uint8_t coolant;				//M7 M8 M9, COOLANT_MODE
+	uint8_t h_word;					//H, tool of G43
+	uint8_t l_word;					//L of G10, 1 tool table, 2 or none coordinate system
+	
+	float parameter;				//P- parameter
+	float radius;						//R, radius/R value
+	float center_offsets[3];		//IJK
+	float d_word;						//D, tool diameter of G41.1 G42.1, tool of G41 G42
+	
+	float spindle_speed;		//S in RPM
+	uint8_t spindle_mode;		//spindle setting
+	//u have 2 chars that won't affect size
+	
+}GIn_t;
+
+/*
+	word presence of the block in cm.gf, one bit per GIn_t field so presence is a bit test
+	instead of a float compare. axis words take the first AXES bits so an axis number is its own bit
+*/
+enum gcodeInputFlags{
+	GF_LINENUM = AXES,
+	GF_PROGRAMFLOW,
+	GF_NEXT_ACTION,
+	GF_MOTION_MODE,
+	GF_FEEDRATE_MODE,
+	GF_FEEDRATE,
+	GF_PLANE_SELECT,
+	GF_UNITS_MODE,
+	GF_DISTANCE_MODE,
+	GF_COORDINATE_SYSTEM,
+	GF_ABSOLUTE_OVERRIDE,
+	GF_PATH_CONTROL,
+	GF_TOOL_SELECT,
+	GF_TOOL_CHANGE,
+	GF_COOLANT,
+	GF_PARAMETER,
+	GF_RADIUS,
+	GF_CENTER_OFFSET_I,
+	GF_CENTER_OFFSET_J,
+	GF_CENTER_OFFSET_K,
+	GF_SPINDLE_SPEED,
+	GF_SPINDLE_MODE,
+	GF_CUTTER_COMP,
+	GF_D_WORD,
+	GF_TOOL_LENGTH_COMP,
+	GF_H_WORD,
+	GF_FLAGS						//must stay <= 32
+};
+
+typedef char gf_flags_fit_in_32_bits[(GF_FLAGS <= 32)? 1 : -1];
+
+#define GF_BIT(flag) ((uint32_t)1 << (flag))
+#define GF_AXES_MASK (GF_BIT(AXES)-1)
+#define GF_CENTER_OFFSETS_MASK (GF_BIT(GF_CENTER_OFFSET_I)|GF_BIT(GF_CENTER_OFFSET_J)|GF_BIT(GF_CENTER_OFFSET_K))
+
+
+typedef struct GCodeState{
+	
+	uint32_t linenum;			//N code
+	
+	float move_time;
+
+	float target[AXES];		//target point
+	float work_offset[AXES];
+	float spindle_speed;		//S in RPM
+	float feedrate;						//F in millimeter per minute
+	float parameter;				//P- parameter
+	
+	uint8_t motion_mode;	//modal group 1
+	uint8_t feedrate_mode;		//feedrate setting
+	uint8_t plane_select;			//modal group 2
+	uint8_t units_mode;				//modal group 6
+	uint8_t distance_mode;		//modal group 3
+	uint8_t coordinate_system;		//modal group 12
+	uint8_t absolute_override;		//G53 flag, for the current block only
+	uint8_t path_control;			//modal group 13
+	uint8_t cutter_comp;			//modal group 7
+	uint8_t tool_length_comp;	//modal group 8
+	uint8_t tool;					//tool after declaring the tool with T and assigning it with M6
+	uint8_t tool_select;	//tool declaring T value
+	uint8_t mist_coolant;		//TRUE=MIST ON, FALSE=MIST OFF M7,M9
+	uint8_t flood_coolant;	//TRUE=FLOOD ON, FALSE=FLOOOD OFF M8,M9
+	uint8_t spindle_mode;		//spindle setting
+	//u have 1 char that won't affect size
+}GState_t;
+
+typedef struct AxisConfig{
+	float max_velocity;		//max velocity in mm/min for traverse motion
+	float max_feedrate;		//max velocity in mm/min for feed motion
+	float max_jerk;				//max jerk
+	float max_accel;			//max acceleration in mm/min^2, trapezoid profile
+	float jerk_recip;
+	float jerk_sqrt;
+	float jerk_sqrt_recip;
+	float max_travel;			//max work envelope for soft limits test
+	float min_travel;			//min work envelope for soft limits test
+	float junction_dev;
+	float search_velocity;				// homing search velocity
+	float latch_velocity;				// homing latch velocity
+	float latch_backoff;				// backoff from switches prior to homing latch movement
+	float zero_backoff;					// backoff from switches for machine zero
+	float homing_jerk;
+}Axiscfg_t;
+
+
+typedef struct cmTool{
+	float length;								//Z offset of the tip, G43
+	float diameter;							//G41 G42
+}cmTool_t;
+
+typedef struct cmSingleton{
+	float coord_offset[COORDS+1][AXES];
+	float origin_offset[AXES];
+	float position[AXES];
+	float active_offset[AXES];	//effective work offset, coord system + G92 + tool length unless G53, see _cm_update_active_offset
+	float tool_length_offset;		//Z offset of G43, the length of tool_length_tool
+	cmTool_t tool_table[TOOLS];	//G10 L1, in millimeters
+	float unit_scale;						//millimeters per input unit
+	float axis_scale[AXES];			//unit_scale for the linear axes, 1 for the rotary ones
+	
+	float junction_acceleration;
+	
+	Axiscfg_t a[AXES];
+	
+	uint8_t origin_offset_enable;
+	uint8_t tool_length_tool;		//H of G43 or TOOL_LOADED
+	
+	uint8_t homed[AXES];
+	uint8_t machine_state;
+	uint8_t cycle_state;
+	uint8_t motion_state;
+	uint8_t homing_state;
+	uint8_t homing_mode;				//HomingMode, how the axes after Z are homed
+	uint8_t probe_state;
+	
+	uint8_t cycle_start_requested;
+	
+	float probe_results[AXES];
+	float chordal_tolerance;
+	float arc_segment_len;
+	GState_t *am;
+	
+	GState_t gm;		//gcode model
+	GIn_t gn;				//gcode input values
+	uint32_t gf;		//gcode input flags, GF_BIT(GF_...) per word present in the block
+}cmSingleton_t;
+
+extern MACHINE_LOCAL cmSingleton_t cm;
+
+
+enum MachineState {
+	MACHINE_INITIALIZING = 0,		// machine is initializing
+	MACHINE_READY,					// machine is ready for use
+	MACHINE_ALARM,					// machine in soft alarm state
+	MACHINE_PROGRAM_STOP,			// program stop or no more blocks
+	MACHINE_PROGRAM_END,			// program end
+	MACHINE_CYCLE,					// machine is running (cycling)
+	MACHINE_SHUTDOWN,				// machine in hard alarm state (shutdown)
+};
+
+enum CycleState {
+	CYCLE_OFF = 0,					// machine is idle
+	CYCLE_MACHINING,				// in normal machining cycle
+	CYCLE_PROBE,					// in probe cycle
+	CYCLE_HOMING,					// homing is treated as a specialized cycle
+	CYCLE_JOG						// jogging is treated as a specialized cycle
+};
+
+enum MotionState {
+	MOTION_STOP = 0,				// motion has stopped
+	MOTION_RUN,						// machine is in motion
+	MOTION_HOLD						// feedhold in progress
+};
+
+enum HomingState{
+	HOMING_NOT_HOMED =0,
+	HOMING_HOMED,
+	HOMING_WAITING
+};
+
+enum HomingMode{
+	HOMING_SEQUENTIAL = 0,				// Z, then X, then Y
+	HOMING_SIMULTANEOUS					// Z, then the rest of the axes together
+};
+
+enum cmProbeState {					// applies to cm.probe_state
+	PROBE_FAILED = 0,				// probe reached endpoint without triggering
+	PROBE_SUCCEEDED = 1,			// probe was triggered, cm.probe_results has position
+	PROBE_WAITING					// probe is waiting to be started
+};
+
+enum NEXT_ACTION{
+	ACTION_DEFAULT = 0,
+	ACTION_DWELL,
+	ACTION_SET_COORD_DATA,
+	ACTION_SET_AXIS_OFFSETS,
+	ACTION_RESET_AXIS_OFFSETS,
+	ACTION_SUSPEND_AXIS_OFFSETS,
+	ACTION_RESUME_AXIS_OFFSETS,
+	ACTION_GOTO_G28_POSITION,
+	ACTION_SET_G28_POSITION,
+	ACTION_SEARCH_HOME,
+	ACTION_SET_ABSOLUTE_ORIGIN,
+	ACTION_HOMING_NO_SET,
+	ACTION_GOTO_G30_POSITION,
+	ACTION_SET_G30_POSITION,
+	ACTION_STRAIGHT_PROBE,					// G38.2 toward the workpiece, error on failure
+	ACTION_STRAIGHT_PROBE_NO_ERROR,	// G38.3
+	ACTION_STRAIGHT_PROBE_AWAY,			// G38.4 away from the workpiece, error on failure
+	ACTION_STRAIGHT_PROBE_AWAY_NO_ERROR,	// G38.5
+	ACTION_PROBE_GRID,							// G29 height map for leveling
+	ACTION_CLEAR_GRID								// G29.1
+	
+};
+
+enum MOTION_MODE{
+	MOTION_MODE_STRAIGHT_TRAVERSE = 0, //G0
+	MOTION_MODE_STRAIGHT_FEED, //G1
+	MOTION_MODE_CW_ARC,					//G2
+	MOTION_MODE_CCW_ARC,				//G3
+	MOTION_MODE_CANCEL_MOTION_MODE,			//G80
+	MOTION_MODE_CANNED_81,			//G81
+	MOTION_MODE_CANNED_82,			//G82
+	MOTION_MODE_CANNED_83,			//G83
+	MOTION_MODE_CANNED_84,			//G84
+	MOTION_MODE_CANNED_85,			//G85
+	MOTION_MODE_CANNED_86,			//G86
+	MOTION_MODE_CANNED_87,			//G87
+	MOTION_MODE_CANNED_88,			//G88
+	MOTION_MODE_CANNED_89			//G89
+};
+
+enum FEED_RATE_MODE{
+	INVERSE_TIME_MODE = 0,  //G93
+	UNITS_PER_MINUTE_MODE,	//G94
+	UNITS_PER_REV_MODE			//G95
+};
+
+enum PLANE_SELECT{
+	XY_PLANE = 0,		//G17
+	XZ_PLANE,				//G18
+	YZ_PLANE				//G19
+};
+
+enum UNIT_SYSTEM{
+	INCHES = 0,			//G20
+	MILLIMETERS,		//G21
+};
+
+enum COORDINATE_SYSTEM{
+	ABSOLUTE_COORDS = 0,			//machine coordinate system
+	G54,											//G54 coordinate
+	G55,											//G55 coordinate
+	G56,											//G56 coordinate
+	G57,											//G57 coordinate
+	G58,											//G58 coordinate
+	G59,											//G59 coordinate
+};
+
+enum PATH_CONTROL{
+	PATH_EXACT_PATH = 0,					//G61
+	PATH_EXACT_STOP,							//G61.1
+	PATH_CONTINUOUS								//G64
+};
+
+enum DISTANCE_SYSTEM{
+	ABSOLUTE_MODE = 0,			//G90
+	INCREMENTAL_MODE				//G91
+};
+
+enum SPINDLE_MODE{
+	SPINDLE_OFF = 0,					//M5
+	SPINDLE_CW,								//M3
+	SPINDLE_CCW								//M4
+};
+
+enum CUTTER_COMP_MODE{
+	CUTTER_COMP_OFF = 0,			//G40
+	CUTTER_COMP_LEFT,					//G41, G41.1
+	CUTTER_COMP_RIGHT					//G42, G42.1
+};
+
+enum TOOL_LENGTH_COMP_MODE{
+	TOOL_LENGTH_COMP_OFF = 0,	//G49
+	TOOL_LENGTH_COMP_ON				//G43
+};
+
+enum COOLANT_MODE{
+	COOLANT_OFF = 0,			//M9
+	COOLANT_ON,						//M7 M8 in one block
+	COOLANT_MIST,					//M7
+	COOLANT_FLOOD					//M8
+};
+
+enum PROGRAM_FLOW{
+	PROGRAM_STOP = 0,
+	PROGRAM_END
+};
+
+//for now we will be supporting modal groups G(1,2,3,5,6,7,8,12,13) M(4,6,7,8) and non-modal group 0
+enum MODAL_GROUP{
+	MODAL_GROUP_G0 = 0,
+	MODAL_GROUP_G1,
+	MODAL_GROUP_G2,
+	MODAL_GROUP_G3,
+	MODAL_GROUP_G5,
+	MODAL_GROUP_G6,
+	MODAL_GROUP_G7,
+	MODAL_GROUP_G8,
+	MODAL_GROUP_G12,
+	MODAL_GROUP_G13,
+	MODAL_GROUP_M4,
+	MODAL_GROUP_M6,
+	MODAL_GROUP_M7,
+	MODAL_GROUP_M8,
+};
+
+#define MODAL_BIT(group) ((uint16_t)1 << (group))
+
+//next actions of modal group 0 that take the axis words of the block
+#define ACTION_BIT(action) ((uint32_t)1 << (action))
+#define ACTION_AXIS_WORDS (ACTION_BIT(ACTION_SET_COORD_DATA)|ACTION_BIT(ACTION_SET_AXIS_OFFSETS)|\
+													 ACTION_BIT(ACTION_GOTO_G28_POSITION)|ACTION_BIT(ACTION_GOTO_G30_POSITION)|\
+													 ACTION_BIT(ACTION_SEARCH_HOME)|ACTION_BIT(ACTION_SET_ABSOLUTE_ORIGIN)|\
+													 ACTION_BIT(ACTION_HOMING_NO_SET)|ACTION_BIT(ACTION_STRAIGHT_PROBE)|\
+													 ACTION_BIT(ACTION_STRAIGHT_PROBE_NO_ERROR)|ACTION_BIT(ACTION_STRAIGHT_PROBE_AWAY)|\
+													 ACTION_BIT(ACTION_STRAIGHT_PROBE_AWAY_NO_ERROR)|ACTION_BIT(ACTION_PROBE_GRID))
+
+//block validation status, continues the status codes of system.h
+enum gcodeStatus{
+	STAT_MODAL_GROUP_VIOLATION = STAT_MINIMUM_PROBE_DISTANCE+1,	//two words of the same modal group in a block
+	STAT_AXIS_WORD_CONFLICT,				//axis words claimed by both a motion and a group 0 command
+	STAT_AXIS_WORDS_WITHOUT_MOTION,		//axis words with G80 active and nothing to take them
+	STAT_AXIS_WORDS_MISSING,				//G92 without any axis word
+	STAT_FOLLOWING_ERROR,						//encoder feedback lags the commanded steps over the limit
+	STAT_PROBE_CYCLE_FAILED,				//G38.2 or G38.4 ended without the probe changing state
+	STAT_PROBE_GRID_SPECIFICATION,	//G29 without X Y Z I J, less than 2 or too many points, or not probing down
+	STAT_JOG_CONFLICT,							//$J with motion queued or another cycle running, or g-code while jogging
+	STAT_CUTTER_COMP_SPECIFICATION,	//G41.1 G42.1 without a positive D, G41 G42 on a tool without diameter, inverse time, an arc off the G41 G42 plane or right after G41 G42 while compensating
+	STAT_CUTTER_COMP_GOUGE,					//a compensated move is too short for the radius at an inside corner, or an arc smaller than it
+	STAT_CHECKSUM_MISMATCH,					//streamed line whose *checksum doesn't match, see protocol.h
+	STAT_LINENUM_SEQUENCE,					//checksummed line that isn't the next line number
+	STAT_LINE_TOO_LONG							//streamed line longer than PC_LINE_SIZE
+};
+
+void cm_set_work_offsets(GState_t *gcode_state);
+void cm_set_model_target_mask(float values[], uint32_t flags);
+void cm_set_model_target(float values[], float flags[]);		//arc_planner.c, see cm_arc_feed_mask
+void canonical_init(void);
+void cm_set_model_linenum(uint32_t linenum);
+uint8_t cm_get_motion_mode(GState_t *gcode_state);
+stat_t cm_set_feed_rate_mode(uint8_t mode);
+stat_t cm_set_feed_rate(float feed_rate);
+stat_t cm_select_plane(uint8_t plane);
+stat_t cm_select_unit_mode(uint8_t mode);
+stat_t cm_select_path_control(uint8_t path);
+stat_t cm_select_distance_mode(uint8_t mode);
+stat_t cm_set_coord_offsets(uint8_t coord_system, float target[], uint32_t flags);
+stat_t cm_set_coord_system(uint8_t coord);
+void cm_set_absolute_override(uint8_t state);
+stat_t cm_set_origin_offsets(float values[], uint32_t flags);
+stat_t cm_reset_origin_offsets(void);
+stat_t cm_suspend_origin_offsets(void);
+stat_t cm_resume_origin_offsets(void);
+stat_t cm_dwell(float seconds);
+stat_t cm_set_spindle_speed(float speed);
+stat_t cm_spindle_control(uint8_t spindle_mode);
+stat_t cm_coolant_control(uint8_t coolant);
+stat_t cm_select_tool(uint8_t tool_select);
+stat_t cm_change_tool(uint8_t tool_change);
+stat_t cm_set_tool_table(uint8_t tool, float target[], uint32_t flags, float radius);
+stat_t cm_tool_length_comp(uint8_t mode, uint8_t tool);
+stat_t cm_straight_traverse(float target[],uint32_t flags);
+stat_t cm_straight_feed(float target[],uint32_t flags);
+stat_t cm_arc_feed_mask(float target[], uint32_t flags, float offsets[], float radius);
+stat_t cm_arc_feed(float target[], float flags[],float offsets[],float radius);		//arc_planner.c
+stat_t cm_arc_callback(void);
+void cm_cycle_start(void);
+void cm_finalize_move(void);
+stat_t cm_soft_alarm(stat_t status);
+stat_t cm_hard_alarm(stat_t status);
+uint8_t cm_get_machine_state(void);
+uint8_t cm_get_runtime_busy(void);
+stat_t cm_homing_callback(void);
+stat_t cm_probe_callback(void);
+stat_t cm_leveling_callback(void);
+uint8_t cm_get_coordinate_system(GState_t* gstate);
+uint8_t cm_get_units_mode(GState_t* gstate);
+uint8_t cm_get_distance_mode(GState_t* gstate);
+uint8_t cm_get_feedrate_mode(GState_t* gstate);
+uint8_t cm_get_feedrate(GState_t* gstate);
+void cm_set_motion_mode(GState_t* gstate, uint8_t motion_mode);
+float cm_get_axis_jerk(uint8_t axis);
+void cm_set_axis_jerk(uint8_t axis, float jerk);
+void cm_request_cycle_start(void);
+void cm_set_position(uint8_t axis, float position);
+void cm_abort_arc(void);
+void cm_set_motion_state(uint8_t motion_state);
+float cm_get_absolute_position(GState_t *gcode_state, uint8_t axis);
+stat_t cm_cycle_homing_start(void);
+stat_t cm_straight_probe(float target[],uint32_t flags, uint8_t failure_is_error, uint8_t toward);
+void cm_probe_latch(void);
+stat_t cm_jog_velocity(float velocity[], uint32_t flags);
+void cm_jog_cancel(void);
+stat_t cm_jogging_callback(void);
+stat_t cm_cutter_comp(uint8_t mode, float diameter);
+stat_t cm_cutter_comp_tool(uint8_t mode, uint8_t tool);
+stat_t cm_cutter_comp_callback(void);
+void cc_init(void);
+stat_t cc_plan_line(GState_t *gm);
+stat_t cc_arc_feed(float target[], uint32_t flags, float offsets[], float radius);
+void cc_flush(void);
+stat_t cc_queue_command(void(*cm_exec)(float*, float*), float *value, float *flag);
+stat_t cc_queue_dwell(float seconds);
+uint8_t cc_command_room(uint8_t commands);
+uint8_t cc_busy(void);
+stat_t cc_defer_line(GState_t *gm);
+stat_t cm_probe_grid(float target[], uint32_t flags, float points[]);
+stat_t cm_leveling_clear(void);
+void lv_enable(void);
+void lv_disable(void);
+float lv_get_offset(float x, float y);
+#endif
+
@@ -0,0 +1,105 @@
+/*
+ * config.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * machine configuration, kept apart from main so the host tools plan with the exact
+ * per-axis limits the firmware runs with
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "stepper.h"
+#include "kinematics.h"
+#include "config.h"
+
+//config_init//
+//input : none
+//output : none
+//fuction : loads the per-axis limits, jerk and junction settings
+//notes : must be invoked after canonical_init
+//additions: 
+//
+void config_init(void){
+	cm.a[X_AXIS].max_feedrate = 5000.0f;
+	cm.a[Y_AXIS].max_feedrate = 5000.0f;
+	cm.a[Z_AXIS].max_feedrate = 5000.0f;
+	cm.a[X_AXIS].max_velocity = 8000.0f;
+	cm.a[Y_AXIS].max_velocity = 8000.0f;
+	cm.a[Z_AXIS].max_velocity = 8000.0f;
+	mm.jerk = 540;
+	mm.jerk_cbrt = cbrtf(mm.jerk);
+	cm.a[X_AXIS].max_jerk = 340.0f;
+	cm.a[Y_AXIS].max_jerk = 340.0f;
+	cm.a[Z_AXIS].max_jerk = 340.0f;
+	cm.a[X_AXIS].jerk_recip = 1/((cm.a[X_AXIS].max_jerk)*1000000);
+	cm.a[Y_AXIS].jerk_recip = 1/((cm.a[Y_AXIS].max_jerk)*1000000);
+	cm.a[Z_AXIS].jerk_recip = 1/((cm.a[Z_AXIS].max_jerk)*1000000);
+	cm.a[X_AXIS].junction_dev = 0.05f;
+	cm.a[Y_AXIS].junction_dev = 0.05f;
+	cm.a[Z_AXIS].junction_dev = 0.05f;
+	cm.a[X_AXIS].max_accel = 3600000.0f;				//1000 mm/s^2
+	cm.a[Y_AXIS].max_accel = 3600000.0f;
+	cm.a[Z_AXIS].max_accel = 3600000.0f;
+#if (AXES > 3)
+	//rotary axes, degrees per minute and degrees
+	for(uint8_t axis = A_AXIS; axis<AXES; ++axis){
+		cm.a[axis].max_feedrate = 36000.0f;
+		cm.a[axis].max_velocity = 72000.0f;
+		cm.a[axis].max_jerk = 1000.0f;
+		cm.a[axis].jerk_recip = 1/((cm.a[axis].max_jerk)*1000000);
+		cm.a[axis].junction_dev = 0.5f;
+		cm.a[axis].max_accel = 36000000.0f;
+	}
+#endif
+	cm.junction_acceleration = 20000.0f;
+	cm.homing_mode = HOMING_SEQUENTIAL;
+	cm.chordal_tolerance = CHORDAL_TOLERANCE;
+	cm.arc_segment_len = ARC_SEGMENT_LENGTH;
+}
+
+//config_motors_init//
+//input : none
+//output : none
+//fuction : loads the motor mapping, resolution and port bits
+//notes : the kinematics terms are built from them
+//additions: 
+//
+void config_motors_init(void){
+	st_cfg.mot[MOTOR_1].step_per_unit = 40;
+	st_cfg.mot[MOTOR_2].step_per_unit = 40;
+	st_cfg.mot[MOTOR_3].step_per_unit = 40;
+	st_cfg.mot[MOTOR_1].motor_map = X_AXIS;
+	st_cfg.mot[MOTOR_2].motor_map = Y_AXIS;
+	st_cfg.mot[MOTOR_3].motor_map = Z_AXIS;
+	st_cfg.mot[MOTOR_1].dir_bit = 0x00000010;
+	st_cfg.mot[MOTOR_2].dir_bit = 0x00000020;
+	st_cfg.mot[MOTOR_3].dir_bit = 0x00000040;
+	st_cfg.mot[MOTOR_1].enable_bit = 0x00000010;
+	st_cfg.mot[MOTOR_2].enable_bit = 0x00000020;
+	st_cfg.mot[MOTOR_3].enable_bit = 0x00000040;
+	st_cfg.mot[MOTOR_1].step_bit = 0x00000010;
+	st_cfg.mot[MOTOR_2].step_bit = 0x00000020;
+	st_cfg.mot[MOTOR_3].step_bit = 0x00000040;
+#if (KINEMATICS_MODEL == KINEMATICS_GANTRY)
+	st_cfg.mot[KN_GANTRY_MOTOR].step_per_unit = 40;		//second motor of the gantry axis
+	st_cfg.mot[KN_GANTRY_MOTOR].motor_map = KN_GANTRY_AXIS;
+	st_cfg.mot[KN_GANTRY_MOTOR].dir_bit = 0x00000080;
+	st_cfg.mot[KN_GANTRY_MOTOR].enable_bit = 0x00000080;
+	st_cfg.mot[KN_GANTRY_MOTOR].step_bit = 0x00000080;
+#elif (AXES > 3) && (MOTORS > 3)
+	st_cfg.mot[MOTOR_4].step_per_unit = 8.888889f;		//1/16 microstepping with 1:10 reduction, per degree
+	st_cfg.mot[MOTOR_4].motor_map = A_AXIS;
+	st_cfg.mot[MOTOR_4].dir_bit = 0x00000080;
+	st_cfg.mot[MOTOR_4].enable_bit = 0x00000080;
+	st_cfg.mot[MOTOR_4].step_bit = 0x00000080;
+#endif
+	kn_init(KINEMATICS_MODEL);
+}
@@ -0,0 +1,59 @@
+// config.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+/*
+	storage class of the machine state, every singleton of the tree (cm, gc, hm, pb, ld, en, db,
+	ev, sr, fr, sx, the planner's mb, mm, mr, arc and st_cfg). the firmware has one machine so
+	it's plain static storage and costs nothing, host builds that define MACHINE_REENTRANT get
+	one complete machine per thread
+*/
+#if defined(MACHINE_REENTRANT)
+#define MACHINE_LOCAL _Thread_local
+#else
+#define MACHINE_LOCAL
+#endif
+
+/*
+	g-code features that cost a test on every block. a build that doesn't need one sets it to 0,
+	its words are then rejected by the parser as unsupported and its branches are compiled out of
+	the canonical machine and the planner
+*/
+#ifndef FEATURE_INVERSE_TIME
+#define FEATURE_INVERSE_TIME 1				//G93
+#endif
+#ifndef FEATURE_ARCS
+#define FEATURE_ARCS 1								//G2, G3
+#endif
+#ifndef FEATURE_ABSOLUTE_OVERRIDE
+#define FEATURE_ABSOLUTE_OVERRIDE 1		//G53
+#endif
+
+/*
+	FOR_AXES(axis, statements) expands the statements once per axis with axis a constant, so the
+	per-axis math of the block path is straight line code for the configured AXES and the
+	compiler folds the axis indexes. AXES must be a plain number from 1 to 6. FOR_AXES_LOOP
+	builds the plain loop instead, host/Makefile bench_loop times the two against each other
+*/
+#ifdef FOR_AXES_LOOP
+#define FOR_AXES(axis,...) for(uint8_t axis=0; axis<AXES; ++axis){__VA_ARGS__}
+#else
+#define _FOR_AXES_1(axis,...) {const uint8_t axis = 0; __VA_ARGS__}
+#define _FOR_AXES_2(axis,...) _FOR_AXES_1(axis,__VA_ARGS__) {const uint8_t axis = 1; __VA_ARGS__}
+#define _FOR_AXES_3(axis,...) _FOR_AXES_2(axis,__VA_ARGS__) {const uint8_t axis = 2; __VA_ARGS__}
+#define _FOR_AXES_4(axis,...) _FOR_AXES_3(axis,__VA_ARGS__) {const uint8_t axis = 3; __VA_ARGS__}
+#define _FOR_AXES_5(axis,...) _FOR_AXES_4(axis,__VA_ARGS__) {const uint8_t axis = 4; __VA_ARGS__}
+#define _FOR_AXES_6(axis,...) _FOR_AXES_5(axis,__VA_ARGS__) {const uint8_t axis = 5; __VA_ARGS__}
+#define _FOR_AXES_N(n,axis,...) _FOR_AXES_##n(axis,__VA_ARGS__)
+#define _FOR_AXES(n,axis,...) _FOR_AXES_N(n,axis,__VA_ARGS__)
+#define FOR_AXES(axis,...) _FOR_AXES(AXES,axis,__VA_ARGS__)
+#endif
+
+void config_init(void);
+void config_motors_init(void);
+
+#endif
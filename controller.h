@@ -1,12 +1,8 @@
-#ifndef CONTROLLER_H
-#define CONTROLLER_H
-
-void controller_run(void);
-
-typedef struct controller{
-	uint8_t block;
-}cont_t;
-
-
-#endif
-
+#ifndef CONTROLLER_H
+#define CONTROLLER_H
+
+void controller_run(void);
+
+
+#endif
+
@@ -0,0 +1,713 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "plan_command.h"
+#include "debugging.h"
+#include "util.h"
+
+/*
+	G41.1 D / G42.1 D offsets the path of the active plane by half the diameter, left or right of
+	the direction of travel, G41 D / G42 D take the diameter of tool D from the tool table, of the
+	loaded tool without D, G40 cancels. it runs between the canonical moves and mp_plan_line.
+	the end of a compensated move depends on the move after it, so one programmed move is held
+	and released when the next one comes:
+	  - inside corner, the held move ends on the intersection of both offset paths, of two lines,
+	    a line and a circle or two circles
+	  - outside corner, it ends on its own offset and an arc around the programmed corner joins
+	    the next offset
+	  - a move with no motion in the plane releases the held move square to its end and runs
+	    at the compensated position
+	G2 G3 in the plane of G41 G42 are offset to arcs of the programmed radius -+ the tool radius
+	on the same center. the compensated arcs and the corner arcs are cut in lines to the chordal
+	tolerance by cm_cutter_comp_callback so they never need more planner buffers than a line,
+	the block after them is read when they are planned.
+	the first move after G41.1/G42.1 runs from the uncompensated position to its first corner and
+	has to be a line, the first move after G40 runs from the last offset to its programmed end.
+	the state is the held move, its arc and a corner, whatever the length of the program.
+	dwells and M commands wait with the held move and are queued right behind it when it's
+	released, so the corner after them is still resolved. group 0 commands, M0 M1 and more than
+	CC_COMMANDS_MAX commands release it square, M2 M30 cancel the compensation.
+	inverse time feed is refused while compensating.
+*/
+
+#define CC_COLLINEAR 0.0001f					//sine of the angle between moves taken as straight
+#define CC_ARC_SEGMENTS_MAX 32				//lines per corner arc, the tolerance loosens above it
+#define CC_PATH_SEGMENTS_MAX 256			//lines per compensated arc
+#define CC_ARC_RADIUS_ERROR 0.005f		//mm the end of an IJK arc may be off the radius of its start
+#define CC_COMMANDS_MAX 3							//commands held with the move, the move, its corner and
+																			//the commands fit PLANNER_BUFFER_LIMIT
+
+typedef struct ccPath{					// programmed move of the plane
+	uint8_t arc;
+	GState_t gm;									// programmed target
+	float end[2];									// programmed end
+	float dir[2];									// unit direction at the end
+	float start_dir[2];						// at the start, the same for a line
+	float start[AXES];						// arc, programmed start, a helix runs the other axes from it
+	float center[2];							// arc
+	float radius;									// arc, compensated
+	float angle;									// arc, where the compensated arc starts
+	float sweep;									// arc, from angle to the programmed end, + ccw
+}ccPath_t;
+
+typedef struct ccArc{						// arc in lines for the callback
+	uint16_t segments;						// lines left to plan
+	uint16_t count;
+	GState_t gm;									// feed and the end of the other axes
+	float start[AXES];						// other axes at the start
+	float center[2];
+	float radius;
+	float angle;
+	float step;
+	float end[2];									// exact end of the last line
+}ccArc_t;
+
+typedef struct ccCommand{				// dwell or M command waiting for the held move
+	void (*cm_exec)(float *, float *);	// NULL for a dwell
+	float value[AXES];						// the dwell time in value[0]
+	float flag[AXES];
+	GState_t gm;									// model of the block, mp_queue_command copies cm.gm
+}ccCommand_t;
+
+struct cutterCompSingleton{
+	float radius;									// + on the left of the path, - on the right
+	uint8_t plane;								// of G41 G42
+	uint8_t axis_0;								// plane axes, axis_1 is 90 degrees ccw of axis_0
+	uint8_t axis_1;
+
+	uint8_t held;									// path waits for the move after it
+	uint8_t has_dir;							// path is the last compensated move
+	ccPath_t path;
+	float position[2];						// compensated position the released moves reach
+
+	uint8_t commands;
+	ccCommand_t command[CC_COMMANDS_MAX];
+	uint8_t release_commands;			// the commands come after path_arc
+
+	ccArc_t path_arc;							// released compensated arc
+	ccArc_t corner_arc;						// outside corner after it
+	uint8_t deferred;							// a line came while they were planned
+	GState_t deferred_gm;
+};
+
+static MACHINE_LOCAL struct cutterCompSingleton cc;
+
+static stat_t _cc_start(uint8_t mode, float diameter);
+static stat_t _cc_add(ccPath_t *p);
+static stat_t _cc_arc_path(ccPath_t *p, float start[], uint32_t flags, float offsets[], float radius);
+static uint8_t _cc_intersect(ccPath_t *a, ccPath_t *b, float point[]);
+static uint8_t _cc_line_circle(ccPath_t *line, ccPath_t *arc, float corner[], float point[]);
+static uint8_t _cc_circles(ccPath_t *a, ccPath_t *b, float corner[], float point[]);
+static void _cc_nearest(float p0[], float p1[], float corner[], float point[]);
+static float _cc_arc_trim(ccPath_t *p, float point[]);
+static float _cc_wrap(float angle);
+static void _cc_offset(const float dir[], float offset[]);
+static void _cc_release(GState_t *gm, float p0, float p1);
+static void _cc_release_path(float end[]);
+static void _cc_release_commands(void);
+static void _cc_start_arc(ccArc_t *a, GState_t *gm, float start[], float center[], float radius,
+	float angle, float sweep, float end[], uint16_t segments_max);
+static uint8_t _cc_plan_arc(ccArc_t *a);
+
+//cc_init//
+//input : none
+//output : none
+//fuction : forgets the held move and the corner
+//notes : with the canonical machine, the model starts in G40
+//additions:
+//
+void cc_init(void){
+	memset(&cc,0,sizeof(cc));
+}
+
+//cm_cutter_comp//
+//input : CUTTER_COMP_OFF, CUTTER_COMP_LEFT, CUTTER_COMP_RIGHT, tool diameter in the block units
+//output : STAT_OK
+//fuction : G40, G41.1, G42.1
+//notes : a change of side or diameter while compensating starts over from the current position
+//additions:
+//
+stat_t cm_cutter_comp(uint8_t mode, float diameter){
+	return _cc_start(mode,cm.unit_scale*diameter);
+}
+
+//cm_cutter_comp_tool//
+//input : CUTTER_COMP_LEFT, CUTTER_COMP_RIGHT, tool
+//output : STAT_OK, STAT_INPUT_VALUE_OUT_OF_RANGE, STAT_CUTTER_COMP_SPECIFICATION
+//fuction : G41, G42
+//notes : the diameter is read once here, a later G10 L1 takes effect on the next G41 G42
+//additions:
+//
+stat_t cm_cutter_comp_tool(uint8_t mode, uint8_t tool){
+	if(tool >= TOOLS){return STAT_INPUT_VALUE_OUT_OF_RANGE;}
+	if(cm.tool_table[tool].diameter <= 0){return STAT_CUTTER_COMP_SPECIFICATION;}
+	return _cc_start(mode,cm.tool_table[tool].diameter);
+}
+
+static stat_t _cc_start(uint8_t mode, float diameter){
+	cc_flush();
+	cm.gm.cutter_comp = mode;
+	cc.has_dir = false;
+	if(mode == CUTTER_COMP_OFF){
+		return STAT_OK;
+	}
+	cc.plane = cm.gm.plane_select;
+	switch(cc.plane){
+		case XZ_PLANE: cc.axis_0 = Z_AXIS; cc.axis_1 = X_AXIS; break;
+		case YZ_PLANE: cc.axis_0 = Y_AXIS; cc.axis_1 = Z_AXIS; break;
+		default: cc.axis_0 = X_AXIS; cc.axis_1 = Y_AXIS;
+	}
+	float radius = diameter/2;
+	cc.radius = (mode == CUTTER_COMP_LEFT)? radius : -radius;
+	if(cc_busy() == false){								// else the flushed arc ends on cc.position
+		cc.position[0] = mm.position[cc.axis_0];
+		cc.position[1] = mm.position[cc.axis_1];
+	}
+	return STAT_OK;
+}
+
+//cc_plan_line//
+//input : model of a straight move, target in machine coordinates
+//output : STAT_OK, STAT_CUTTER_COMP_GOUGE, STAT_CUTTER_COMP_SPECIFICATION
+//fuction : compensated replacement of mp_plan_line, releases the move before and holds this one
+//notes : cm.position still holds the programmed start of the move
+//additions:
+//
+stat_t cc_plan_line(GState_t *gm){
+#if FEATURE_INVERSE_TIME
+	if(gm->feedrate_mode == INVERSE_TIME_MODE){
+		return STAT_CUTTER_COMP_SPECIFICATION;	//the offset path isn't the programmed length
+	}
+#endif
+	float end[2] = {gm->target[cc.axis_0], gm->target[cc.axis_1]};
+	float delta[2] = {end[0]-cm.position[cc.axis_0], end[1]-cm.position[cc.axis_1]};
+	float length = _sqrtf(delta[0]*delta[0] + delta[1]*delta[1]);
+	if(length < EPSILON){						// nothing in the plane, Z plunge or retract
+		cc_flush();
+		GState_t move;
+		memcpy(&move,gm,sizeof(GState_t));
+		move.target[cc.axis_0] = cc.position[0];
+		move.target[cc.axis_1] = cc.position[1];
+		if(cc_busy()){return cc_defer_line(&move);}	// behind the lines of the held arc
+		_cc_release(&move,cc.position[0],cc.position[1]);
+		return STAT_OK;
+	}
+	ccPath_t p;
+	p.arc = false;
+	memcpy(&p.gm,gm,sizeof(GState_t));
+	p.end[0] = end[0];
+	p.end[1] = end[1];
+	p.dir[0] = p.start_dir[0] = delta[0]/length;
+	p.dir[1] = p.start_dir[1] = delta[1]/length;
+	return _cc_add(&p);
+}
+
+//cc_arc_feed//
+//input : target, word mask of the block, IJK offsets, R, like cm_arc_feed_mask
+//output : STAT_OK, STAT_GCODE_FEEDRATE_NOT_SPECIFIED, STAT_CUTTER_COMP_SPECIFICATION,
+//STAT_CUTTER_COMP_GOUGE
+//fuction : G2 G3 while compensating
+//notes : the arc has to be in the plane of G41 G42 and come after a compensated line. the
+//model takes the programmed target, the compensated arc is held like a line
+//additions:
+//
+stat_t cc_arc_feed(float target[], uint32_t flags, float offsets[], float radius){
+#if FEATURE_INVERSE_TIME
+	if(cm.gm.feedrate_mode == INVERSE_TIME_MODE){return STAT_CUTTER_COMP_SPECIFICATION;}
+#endif
+	if(fp_ZERO(cm.gm.feedrate)){return STAT_GCODE_FEEDRATE_NOT_SPECIFIED;}
+	if((cm.gm.plane_select != cc.plane) || (cc.has_dir == false)){
+		return STAT_CUTTER_COMP_SPECIFICATION;		// no offset to start the arc from
+	}
+	float start[2] = {cm.position[cc.axis_0], cm.position[cc.axis_1]};
+	ccPath_t p;
+	p.arc = true;
+	copy_vector(p.start,cm.position);
+	cm_set_model_target_mask(target,flags);
+	stat_t status = _cc_arc_path(&p,start,flags,offsets,radius);
+	if(status == STAT_OK){
+		cm_set_work_offsets(&cm.gm);
+		memcpy(&p.gm,&cm.gm,sizeof(GState_t));
+		cm_cycle_start();
+		status = _cc_add(&p);
+	}
+	if(status != STAT_OK){
+		copy_vector(cm.gm.target,cm.position);
+		return status;
+	}
+	cm_finalize_move();
+	return STAT_OK;
+}
+
+//_cc_arc_path//
+//input : arc path with the programmed start of the other axes, programmed start in the plane,
+//word mask, IJK offsets, R
+//output : STAT_OK, STAT_CUTTER_COMP_SPECIFICATION, STAT_CUTTER_COMP_GOUGE
+//fuction : center, compensated radius, angles and end directions of the model arc
+//notes : a negative R takes the arc over 180 degrees, equal ends of an IJK arc are a full circle
+//additions:
+//
+static stat_t _cc_arc_path(ccPath_t *p, float start[], uint32_t flags, float offsets[], float radius){
+	float turn = (cm.gm.motion_mode == MOTION_MODE_CCW_ARC)? 1 : -1;
+	p->end[0] = cm.gm.target[cc.axis_0];
+	p->end[1] = cm.gm.target[cc.axis_1];
+	if(flags & GF_BIT(GF_RADIUS)){
+		float r = _TO_MILLI(radius);
+		float chord[2] = {p->end[0]-start[0], p->end[1]-start[1]};
+		float length = _sqrtf(chord[0]*chord[0] + chord[1]*chord[1]);
+		if(length < EPSILON){return STAT_CUTTER_COMP_SPECIFICATION;}
+		float h_sq = r*r - length*length/4;
+		if(h_sq < -CC_ARC_RADIUS_ERROR*fabsf(r)){return STAT_CUTTER_COMP_SPECIFICATION;}
+		float h = (h_sq > 0)? _sqrtf(h_sq)/length : 0;
+		if(r < 0){h = -h;}
+		h *= turn;																// left of the chord for a ccw arc under 180 degrees
+		p->center[0] = (start[0]+p->end[0])/2 - chord[1]*h;
+		p->center[1] = (start[1]+p->end[1])/2 + chord[0]*h;
+	}else{
+		p->center[0] = start[0] + _AXIS_TO_MILLI(cc.axis_0,offsets[cc.axis_0]);
+		p->center[1] = start[1] + _AXIS_TO_MILLI(cc.axis_1,offsets[cc.axis_1]);
+	}
+	float r0[2] = {start[0]-p->center[0], start[1]-p->center[1]};
+	float r1[2] = {p->end[0]-p->center[0], p->end[1]-p->center[1]};
+	float programmed = _sqrtf(r0[0]*r0[0] + r0[1]*r0[1]);
+	float end_radius = _sqrtf(r1[0]*r1[0] + r1[1]*r1[1]);
+	if((programmed < EPSILON) || (fabsf(end_radius - programmed) > CC_ARC_RADIUS_ERROR)){
+		return STAT_CUTTER_COMP_SPECIFICATION;
+	}
+	p->radius = programmed - turn*cc.radius;		// the left of a ccw arc is its inside
+	if(p->radius < EPSILON){return STAT_CUTTER_COMP_GOUGE;}
+	p->angle = atan2f(r0[1],r0[0]);
+	float end_angle = atan2f(r1[1],r1[0]);
+	p->sweep = end_angle - p->angle;
+	if(turn > 0){
+		if(p->sweep <= EPSILON) p->sweep += 2*M_PI;
+	}else{
+		if(p->sweep >= -EPSILON) p->sweep -= 2*M_PI;
+	}
+	p->start_dir[0] = -turn*r0[1]/programmed;
+	p->start_dir[1] = turn*r0[0]/programmed;
+	p->dir[0] = -turn*r1[1]/end_radius;
+	p->dir[1] = turn*r1[0]/end_radius;
+	return STAT_OK;
+}
+
+//_cc_add//
+//input : compensated move of the plane, line or arc
+//output : STAT_OK, STAT_CUTTER_COMP_GOUGE, STAT_CUTTER_COMP_SPECIFICATION
+//fuction : resolves the corner with the held move, releases it and holds this one
+//notes : the corner arc takes the feed of the new move and leaves the other axes where the
+//released move ends
+//additions:
+//
+static stat_t _cc_add(ccPath_t *p){
+	db_start_session(CUTTER_COMP_TIME);
+	float offset[2];
+	_cc_offset(p->start_dir,offset);
+	float start[2] = {cm.position[cc.axis_0]+offset[0], cm.position[cc.axis_1]+offset[1]};	// of the new offset
+	float release[2] = {start[0], start[1]};							// end of the held move
+	uint8_t outside = false;
+	float last_offset[2];
+	if(cc.has_dir){
+		_cc_offset(cc.path.dir,last_offset);
+		float cross = cc.path.dir[0]*p->start_dir[1] - cc.path.dir[1]*p->start_dir[0];
+		float dot = cc.path.dir[0]*p->start_dir[0] + cc.path.dir[1]*p->start_dir[1];
+		if((fabsf(cross) < CC_COLLINEAR) && (dot > 0)){			// straight on
+			release[0] = cc.path.end[0] + last_offset[0];
+			release[1] = cc.path.end[1] + last_offset[1];
+		}else if(cross*cc.radius > 0){										// inside, both offsets meet
+			uint8_t gouge = (_cc_intersect(&cc.path,p,release) == false);
+			if(gouge == false){
+				if(cc.path.arc){
+					gouge = (cc.held && ((cc.path.sweep + _cc_arc_trim(&cc.path,release))*cc.path.sweep <= 0));
+				}else{
+					gouge = (cc.held && ((release[0]-cc.position[0])*cc.path.dir[0] + (release[1]-cc.position[1])*cc.path.dir[1] < 0));
+				}
+			}
+			if(gouge == false){
+				if(p->arc){
+					float trim = _cc_wrap(atan2f(release[1]-p->center[1],release[0]-p->center[0]) - p->angle);
+					gouge = ((p->sweep - trim)*p->sweep <= 0);
+				}else{
+					float offset_end[2];
+					_cc_offset(p->dir,offset_end);
+					gouge = ((p->end[0]+offset_end[0]-release[0])*p->dir[0] + (p->end[1]+offset_end[1]-release[1])*p->dir[1] < 0);
+				}
+			}
+			if(gouge){																		// a move is shorter than the radius
+				db_end_session(CUTTER_COMP_TIME);
+				return STAT_CUTTER_COMP_GOUGE;
+			}
+			start[0] = release[0];
+			start[1] = release[1];
+		}else{																						// outside, around the corner
+			release[0] = cc.path.end[0] + last_offset[0];
+			release[1] = cc.path.end[1] + last_offset[1];
+			outside = true;
+		}
+	}
+	db_end_session(CUTTER_COMP_TIME);
+
+	GState_t corner_gm;
+	memcpy(&corner_gm,&p->gm,sizeof(GState_t));
+	if(cc.held){
+		copy_vector(corner_gm.target,cc.path.gm.target);	// the other axes where the held move ends
+		_cc_release_path(release);
+	}else{
+		copy_vector(corner_gm.target,mm.position);
+		if(cc.has_dir){						// the last move was released square, go back onto the corner
+			_cc_release(&corner_gm,release[0],release[1]);
+		}
+	}
+	if(outside){
+		float angle = atan2f(last_offset[1],last_offset[0]);
+		float sweep = atan2f(offset[1],offset[0]) - angle;
+		if(cc.radius > 0){							// an outside corner turns against the side of the offset
+			while(sweep >= 0) sweep -= 2*M_PI;
+		}else{
+			while(sweep <= 0) sweep += 2*M_PI;
+		}
+		_cc_start_arc(&cc.corner_arc,&corner_gm,corner_gm.target,cc.path.end,fabsf(cc.radius),angle,sweep,start,CC_ARC_SEGMENTS_MAX);
+	}
+	if(p->arc){																					// starts where the held move ends
+		float trim = _cc_wrap(atan2f(start[1]-p->center[1],start[0]-p->center[0]) - p->angle);
+		p->angle += trim;
+		p->sweep -= trim;
+	}
+	memcpy(&cc.path,p,sizeof(ccPath_t));
+	cc.held = true;
+	cc.has_dir = true;
+	return STAT_OK;
+}
+
+//cc_flush//
+//input : none
+//output : none
+//fuction : releases the held move square to its end
+//notes : the corner after it is joined by cc_plan_line from there
+//additions:
+//
+void cc_flush(void){
+	if(cc.held == false) return;
+	float offset[2];
+	_cc_offset(cc.path.dir,offset);
+	float end[2] = {cc.path.end[0]+offset[0], cc.path.end[1]+offset[1]};
+	cc.held = false;
+	_cc_release_path(end);
+}
+
+//cc_queue_command//
+//input : like mp_queue_command
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : queues an M command behind the held move
+//notes : it waits with the move and is queued after it so the corner after it is still
+//resolved, with no held move it goes right to the planner
+//additions:
+//
+stat_t cc_queue_command(void(*cm_exec)(float*, float*), float *value, float *flag){
+	if((cc.held == false) && (cc_busy() == false)){
+		return mp_queue_command(cm_exec,value,flag);
+	}
+	if(cc.commands == CC_COMMANDS_MAX){
+		if(cc.path.arc || cc_busy()){return STAT_BUFFER_FULL;}	// the lines of the arc come first
+		cc_flush();																							// square, they all fit the planner
+		return mp_queue_command(cm_exec,value,flag);
+	}
+	ccCommand_t *command = &cc.command[cc.commands++];
+	command->cm_exec = cm_exec;
+	memcpy(&command->gm,&cm.gm,sizeof(GState_t));
+	copy_vector(command->value,value);
+	copy_vector(command->flag,flag);
+	if(cc.held == false){cc.release_commands = true;}	// behind the lines still to plan
+	return STAT_OK;
+}
+
+//cc_command_room//
+//input : commands and dwells of the block
+//output : true when cc_queue_command and cc_queue_dwell take them all
+//fuction : checked before the block changes the model, so none of them is refused halfway
+//notes : without room the held move is let go, square or as its arc, and the callback queues it
+//and the commands that waited with it. the block is read again once it's done
+//additions:
+//
+uint8_t cc_command_room(uint8_t commands){
+	if((cc.held == false) && (cc_busy() == false)){
+		return (mp_get_available_buffers() >= commands);
+	}
+	if(cc.commands + commands <= CC_COMMANDS_MAX){return true;}
+	if(cc_busy() == false){cc_flush();}
+	return false;
+}
+
+//cc_queue_dwell//
+//input : seconds
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : mp_queue_dwell behind the held move
+//notes : see cc_queue_command
+//additions:
+//
+stat_t cc_queue_dwell(float seconds){
+	if((cc.held == false) && (cc_busy() == false)){
+		return mp_queue_dwell(seconds);
+	}
+	if(cc.commands == CC_COMMANDS_MAX){
+		if(cc.path.arc || cc_busy()){return STAT_BUFFER_FULL;}
+		cc_flush();
+		return mp_queue_dwell(seconds);
+	}
+	ccCommand_t *command = &cc.command[cc.commands++];
+	command->cm_exec = NULL;
+	memcpy(&command->gm,&cm.gm,sizeof(GState_t));
+	command->value[0] = seconds;
+	if(cc.held == false){cc.release_commands = true;}	// behind the lines still to plan
+	return STAT_OK;
+}
+
+//cc_busy//
+//input : none
+//output : true while the callback has lines or commands to queue
+//fuction :
+//notes :
+//additions:
+//
+uint8_t cc_busy(void){
+	return (cc.path_arc.segments != 0) || cc.release_commands || (cc.corner_arc.segments != 0) || cc.deferred;
+}
+
+//cc_defer_line//
+//input : straight move
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : plans the move after the lines the callback still has to queue
+//notes : one move, the next block is read when the callback is done
+//additions:
+//
+stat_t cc_defer_line(GState_t *gm){
+	if(cc.deferred){return STAT_BUFFER_FULL;}
+	memcpy(&cc.deferred_gm,gm,sizeof(GState_t));
+	cc.deferred = true;
+	return STAT_OK;
+}
+
+//cm_cutter_comp_callback//
+//input : none
+//output : STAT_NOOP with nothing to queue, STAT_RC while it waits for buffers, STAT_OK when it's done
+//fuction : plans the lines of the released arc, its commands, the corner arc and a deferred move
+//notes : runs before cm_arc_callback, an uncompensated arc after G40 comes after them
+//additions:
+//
+stat_t cm_cutter_comp_callback(void){
+	if(cc_busy() == false){return STAT_NOOP;}
+	if(_cc_plan_arc(&cc.path_arc) == false){return STAT_RC;}
+	if(cc.release_commands){
+		if(mp_get_available_buffers() < PLANNER_BUFFER_LIMIT){return STAT_RC;}
+		cc.release_commands = false;
+		_cc_release_commands();
+	}
+	if(_cc_plan_arc(&cc.corner_arc) == false){return STAT_RC;}
+	if(cc.deferred){
+		if(mp_get_available_buffers() < PLANNER_BUFFER_LIMIT){return STAT_RC;}
+		cc.deferred = false;
+		mp_plan_line(&cc.deferred_gm);
+	}
+	return STAT_OK;
+}
+
+//_cc_intersect//
+//input : held move, new move, storage of the corner
+//output : false if the offsets don't meet
+//fuction : point where the offsets of both moves meet next to the programmed corner
+//notes :
+//additions:
+//
+static uint8_t _cc_intersect(ccPath_t *a, ccPath_t *b, float point[]){
+	if(a->arc && b->arc){return _cc_circles(a,b,a->end,point);}
+	if(a->arc){return _cc_line_circle(b,a,a->end,point);}
+	if(b->arc){return _cc_line_circle(a,b,a->end,point);}
+	float offset_a[2];
+	float offset_b[2];
+	_cc_offset(a->dir,offset_a);
+	_cc_offset(b->dir,offset_b);
+	float scale = 1/(1 + a->dir[0]*b->dir[0] + a->dir[1]*b->dir[1]);
+	point[0] = a->end[0] + (offset_a[0] + offset_b[0])*scale;
+	point[1] = a->end[1] + (offset_a[1] + offset_b[1])*scale;
+	return true;
+}
+
+static uint8_t _cc_line_circle(ccPath_t *line, ccPath_t *arc, float corner[], float point[]){
+	float offset[2];
+	_cc_offset(line->dir,offset);
+	float q[2] = {line->end[0]+offset[0]-arc->center[0], line->end[1]+offset[1]-arc->center[1]};
+	float b = q[0]*line->dir[0] + q[1]*line->dir[1];
+	float disc = b*b - (q[0]*q[0] + q[1]*q[1] - arc->radius*arc->radius);
+	if(disc < 0){return false;}
+	disc = _sqrtf(disc);
+	float p0[2] = {arc->center[0]+q[0]+(-b-disc)*line->dir[0], arc->center[1]+q[1]+(-b-disc)*line->dir[1]};
+	float p1[2] = {arc->center[0]+q[0]+(-b+disc)*line->dir[0], arc->center[1]+q[1]+(-b+disc)*line->dir[1]};
+	_cc_nearest(p0,p1,corner,point);
+	return true;
+}
+
+static uint8_t _cc_circles(ccPath_t *a, ccPath_t *b, float corner[], float point[]){
+	float d[2] = {b->center[0]-a->center[0], b->center[1]-a->center[1]};
+	float distance = _sqrtf(d[0]*d[0] + d[1]*d[1]);
+	if((distance < EPSILON) || (distance > a->radius + b->radius) || (distance < fabsf(a->radius - b->radius))){
+		return false;
+	}
+	float along = (a->radius*a->radius - b->radius*b->radius + distance*distance)/(2*distance);
+	float h_sq = a->radius*a->radius - along*along;
+	float h = (h_sq > 0)? _sqrtf(h_sq) : 0;
+	float u[2] = {d[0]/distance, d[1]/distance};
+	float m[2] = {a->center[0] + along*u[0], a->center[1] + along*u[1]};
+	float p0[2] = {m[0] - h*u[1], m[1] + h*u[0]};
+	float p1[2] = {m[0] + h*u[1], m[1] - h*u[0]};
+	_cc_nearest(p0,p1,corner,point);
+	return true;
+}
+
+static void _cc_nearest(float p0[], float p1[], float corner[], float point[]){
+	float d0 = (p0[0]-corner[0])*(p0[0]-corner[0]) + (p0[1]-corner[1])*(p0[1]-corner[1]);
+	float d1 = (p1[0]-corner[0])*(p1[0]-corner[0]) + (p1[1]-corner[1])*(p1[1]-corner[1]);
+	float *nearest = (d0 <= d1)? p0 : p1;
+	point[0] = nearest[0];
+	point[1] = nearest[1];
+}
+
+//_cc_arc_trim//
+//input : arc path, point on its circle
+//output : angle from the end of the arc to the point, -PI to PI
+//fuction :
+//notes :
+//additions:
+//
+static float _cc_arc_trim(ccPath_t *p, float point[]){
+	return _cc_wrap(atan2f(point[1]-p->center[1],point[0]-p->center[0]) - (p->angle + p->sweep));
+}
+
+static float _cc_wrap(float angle){
+	while(angle > M_PI) angle -= 2*M_PI;
+	while(angle < -M_PI) angle += 2*M_PI;
+	return angle;
+}
+
+//_cc_offset//
+//input : unit direction in the plane
+//output : offset vector of the path
+//fuction : the left normal scaled by the signed radius
+//notes :
+//additions:
+//
+static void _cc_offset(const float dir[], float offset[]){
+	offset[0] = -dir[1]*cc.radius;
+	offset[1] = dir[0]*cc.radius;
+}
+
+static void _cc_release(GState_t *gm, float p0, float p1){
+	GState_t move;
+	memcpy(&move,gm,sizeof(GState_t));
+	move.target[cc.axis_0] = p0;
+	move.target[cc.axis_1] = p1;
+	mp_plan_line(&move);
+	cc.position[0] = p0;
+	cc.position[1] = p1;
+}
+
+//_cc_release_path//
+//input : compensated end of the held move
+//output : none
+//fuction : a held line is planned with its commands, a held arc goes to the callback
+//notes :
+//additions:
+//
+static void _cc_release_path(float end[]){
+	if(cc.path.arc == false){
+		_cc_release(&cc.path.gm,end[0],end[1]);
+		_cc_release_commands();
+		return;
+	}
+	float sweep = cc.path.sweep + _cc_arc_trim(&cc.path,end);
+	_cc_start_arc(&cc.path_arc,&cc.path.gm,cc.path.start,cc.path.center,cc.path.radius,cc.path.angle,sweep,end,CC_PATH_SEGMENTS_MAX);
+	cc.release_commands = (cc.commands != 0);
+}
+
+//_cc_release_commands//
+//input : none
+//output : none
+//fuction : queues the commands that waited for the held move
+//notes : CC_COMMANDS_MAX keeps the room for them. each is queued with the model of its block
+//additions:
+//
+static void _cc_release_commands(void){
+	if(cc.commands == 0) return;
+	GState_t model;
+	memcpy(&model,&cm.gm,sizeof(GState_t));
+	for(uint8_t i = 0; i < cc.commands; ++i){
+		ccCommand_t *command = &cc.command[i];
+		memcpy(&cm.gm,&command->gm,sizeof(GState_t));
+		if(command->cm_exec == NULL){
+			mp_queue_dwell(command->value[0]);
+		}else{
+			mp_queue_command(command->cm_exec,command->value,command->flag);
+		}
+	}
+	memcpy(&cm.gm,&model,sizeof(GState_t));
+	cc.commands = 0;
+}
+
+//_cc_start_arc//
+//input : arc, feed and end of the other axes, their start, center, radius, start angle and
+//sweep in the plane, end, most lines
+//output : none
+//fuction : sets an arc up for the callback
+//notes : the compensated position moves to the end now, the moves after it start there
+//additions:
+//
+static void _cc_start_arc(ccArc_t *a, GState_t *gm, float start[], float center[], float radius,
+	float angle, float sweep, float end[], uint16_t segments_max){
+	float step = (cm.chordal_tolerance < radius)? 2*acosf(1 - cm.chordal_tolerance/radius) : M_PI;
+	uint32_t segments = (uint32_t)ceilf(fabsf(sweep)/step);
+	if(segments > segments_max) segments = segments_max;
+	if(segments == 0) segments = 1;
+	memcpy(&a->gm,gm,sizeof(GState_t));
+	memcpy(a->start,start,sizeof(a->start));
+	a->center[0] = center[0];
+	a->center[1] = center[1];
+	a->radius = radius;
+	a->angle = angle;
+	a->step = sweep/segments;
+	a->end[0] = end[0];
+	a->end[1] = end[1];
+	a->count = a->segments = (uint16_t)segments;
+	cc.position[0] = end[0];
+	cc.position[1] = end[1];
+}
+
+//_cc_plan_arc//
+//input : arc
+//output : true when all of its lines are planned
+//fuction : plans the lines of the arc while there are buffers
+//notes : the runtime posts EV_PLANNER as it frees them
+//additions:
+//
+static uint8_t _cc_plan_arc(ccArc_t *a){
+	while(a->segments != 0){
+		if(mp_get_available_buffers() < PLANNER_BUFFER_LIMIT){return false;}
+		if(--a->segments == 0){
+			_cc_release(&a->gm,a->end[0],a->end[1]);
+		}else{
+			a->angle += a->step;
+			float k = (float)(a->count - a->segments)/a->count;
+			GState_t move;
+			memcpy(&move,&a->gm,sizeof(GState_t));
+			FOR_AXES(axis,
+				move.target[axis] = a->start[axis] + (a->gm.target[axis] - a->start[axis])*k;
+			)
+			move.target[cc.axis_0] = a->center[0] + a->radius*cosf(a->angle);
+			move.target[cc.axis_1] = a->center[1] + a->radius*sinf(a->angle);
+			mp_plan_line(&move);
+		}
+	}
+	return true;
+}
@@ -1,259 +1,401 @@
-
-#include <stdint.h>
-#include <stdbool.h>
-#include <math.h>
-#include "system.h"
-#include "canonical.h"
-#include "planner.h"
-#include "switch.h"
-#include "util.h"
-
-struct homingSingleton{
-	// state saved from gcode model
-	uint8_t saved_units_mode;		// G20,G21 global setting
-	uint8_t saved_coord_system;		// G54 - G59 setting
-	uint8_t saved_distance_mode;	// G90,G91 global setting
-	uint8_t saved_feed_rate_mode;   // G93,G94 global setting
-	float saved_feed_rate;			// F setting
-	float saved_jerk;				// saved and restored for each axis homed
-	
-	float direction;
-	float search_travel;
-	float search_velocity;
-	float latch_velocity;
-	float latch_backoff;
-	float zero_backoff;
-	
-	uint8_t homing_closed;			// 0=open, 1=closed
-	uint8_t limit_closed;			// 0=open, 1=closed
-	uint8_t set_coordinates;		// G28.4 flag. true = set coords to zero at the end of homing cycle
-	stat_t (*func)(int8_t axis);	// binding for callback function state machine
-	
-	int8_t axis;					// axis currently being homed
-	uint8_t min_mode;				// mode for min switch for this axis
-	uint8_t max_mode;				// mode for max switch for this axis
-	
-	int8_t homing_switch_axis;
-	int8_t limit_switch_axis;
-	int8_t homing_switch_position;
-	int8_t limit_switch_position;
-
-};
-
-static struct homingSingleton hm;
-
-stat_t _homing_axis_start(int8_t axis);
-static stat_t _homing_finalize_exit(int8_t axis);
-static stat_t _homing_error_exit(stat_t status);
-static int8_t _get_next_axis(int8_t axis);
-static stat_t _set_homing_func(stat_t (*func)(int8_t axis));
-static stat_t _homing_axis_clear(int8_t axis);
-static stat_t _homing_axis_move(int8_t axis, float target, float velocity);
-static stat_t _homing_axis_set_zero(int8_t axis);
-static stat_t _homing_axis_search(int8_t axis);
-static stat_t _homing_axis_latch(int8_t axis);
-static stat_t _homing_axis_zero_backoff(int8_t axis);
-static stat_t _homing_abort(int8_t axis);
-
-stat_t cm_cycle_homing_start(void){
-	////save current state of the machince
-	hm.saved_coord_system = cm_get_coordinate_system(ACTIVE_MODEL);
-	hm.saved_distance_mode = cm_get_distance_mode(ACTIVE_MODEL);
-	hm.saved_feed_rate_mode = cm_get_feedrate_mode(ACTIVE_MODEL);
-	hm.saved_feed_rate = cm_get_feedrate(ACTIVE_MODEL);
-	hm.saved_units_mode = cm_get_units_mode(ACTIVE_MODEL);
-	
-	//set up homing state
-	cm_select_unit_mode(MILLIMETERS);
-	cm_select_distance_mode(INCREMENTAL_MODE);
-	cm_set_coord_system(ABSOLUTE_COORDS);	// homing is done in machine coordinates
-	cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);
-	hm.set_coordinates = true;
-	
-	hm.axis = -1;
-	hm.func = _homing_axis_start;
-	cm.cycle_state = CYCLE_HOMING;
-	cm.homing_state = HOMING_NOT_HOMED;
-	return STAT_OK;
-}
-
-
-//step zero: homing intialization for an axis
-static stat_t _homing_axis_start(int8_t axis){
-	
-	//get next axis .. if it's back to -1 then all axes are homed
-	//if -2 then none of the axes are requested to be homed
-	if ((axis = _get_next_axis(axis)) < 0) { 				// axes are done or error
-		if (axis == -1) {									// -1 is done
-			cm.homing_state = HOMING_HOMED;
-			return (_set_homing_func(_homing_finalize_exit));
-		} else if (axis == -2) { 							// -2 is error
-			return (_homing_error_exit(STAT_HOMING_BAD_OR_NO_AXIS_WORDS));
-		}
-	}
-	
-	cm.homed[axis] = false;
-	
-	if(fp_ZERO(cm.a[axis].search_velocity)){return _homing_error_exit(STAT_HOMING_ZERO_SEARCH_VELOCITY);}
-	if(fp_ZERO(cm.a[axis].latch_velocity)){return _homing_error_exit(STAT_HOMING_ZERO_LATCH_VELOCITY);}
-	if (cm.a[axis].latch_backoff < 0) return (_homing_error_exit(STAT_HOMING_ERROR_NEGATIVE_LATCH_BACKOFF));
-	
-	float travel_distance = fabs(cm.a[axis].max_travel - cm.a[axis].min_travel) + cm.a[axis].latch_backoff;
-	if (fp_ZERO(travel_distance)) return (_homing_error_exit(STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL));
-	
-	hm.min_mode = get_switch_mode(axis, SW_MIN);
-	hm.max_mode = get_switch_mode(axis, SW_MAX);
-	
-	//can't have two switches homing ... one limit and one home/r home&limit
-	if(((hm.min_mode&HOMING_BIT)^(hm.max_mode&HOMING_BIT)) == 0){
-		return _homing_error_exit(STAT_HOMING_SWITCH_MISCONFIGURATION);
-	}
-	hm.axis = axis;											// persist the axis
-	hm.search_velocity = fabsf(cm.a[axis].search_velocity);	// search velocity is always positive
-	hm.latch_velocity = fabsf(cm.a[axis].latch_velocity);	// latch velocity is always positive
-	//min switch is the homing switch 
-	if(hm.min_mode&HOMING_BIT){
-		hm.homing_switch_axis = axis;				// the min is the homing switch
-		hm.limit_switch_axis = axis;					// the max would be the limit switch
-		hm.homing_switch_position = SW_MIN;
-		hm.limit_switch_position = SW_MAX;
-		hm.search_travel = travel_distance;
-		hm.latch_backoff = -cm.a[axis].latch_backoff;
-		hm.zero_backoff = -cm.a[axis].zero_backoff;
-	}else{
-		hm.homing_switch_axis = axis;				// the min is the homing switch
-		hm.limit_switch_axis = axis;					// the max would be the limit switch
-		hm.homing_switch_position = SW_MAX;
-		hm.limit_switch_position = SW_MIN;
-		hm.search_travel = -travel_distance;
-		hm.latch_backoff = cm.a[axis].latch_backoff;
-		hm.zero_backoff = cm.a[axis].zero_backoff;
-	}
-	
-	uint8_t sw_mode = get_switch_mode(hm.homing_switch_axis,hm.homing_switch_position);
-	if ((sw_mode != SW_MODE_HOMING) && (sw_mode != SW_MODE_HOMING_LIMIT)) {
-		//if the homing switch is not in homing mode.. skip it to the next axis
-		return (_set_homing_func(_homing_axis_start));
-	}
-	// disable the limit switch parameter if there is no limit switch
-	if (get_switch_mode(hm.limit_switch_axis,hm.limit_switch_position) == SW_MODE_DISABLED) hm.limit_switch_axis = -1;
-	
-	hm.saved_jerk = cm_get_axis_jerk(axis);					// save the max jerk value
-	return (_set_homing_func(_homing_axis_clear));			// start the clear
-}
-
-//step one : clearing switches if it has been invoked before starting homing cycle
-static stat_t _homing_axis_clear(int8_t axis){
-	if (get_switch_state(hm.homing_switch_axis,hm.homing_switch_position) == SW_CLOSED) {
-		_homing_axis_move(axis, hm.latch_backoff, hm.search_velocity);
-	}else if(get_switch_state(hm.limit_switch_axis,hm.limit_switch_position) == SW_CLOSED) {
-		_homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);
-	}
-	return (_set_homing_func(_homing_axis_search));
-}
-
-//step two: search for homing switch
-static stat_t _homing_axis_search(int8_t axis){
-	cm_set_axis_jerk(axis, cm.a[axis].homing_jerk);			// use the homing jerk for search onward
-	_homing_axis_move(axis, hm.search_travel, hm.search_velocity);
-    return (_set_homing_func(_homing_axis_latch));
-}
-
-//step three: move away from switch at latch velocity
-static stat_t _homing_axis_latch(int8_t axis){
-	if (get_switch_state(hm.homing_switch_axis,hm.homing_switch_position) != SW_CLOSED)
-		return (_set_homing_func(_homing_abort));
-	_homing_axis_move(axis, hm.latch_backoff, hm.latch_velocity);
-	return (_set_homing_func(_homing_axis_zero_backoff));
-}
-
-//step four: zero backoff from switch
-static stat_t _homing_axis_zero_backoff(int8_t axis)		// backoff to zero position
-{
-	_homing_axis_move(axis, hm.zero_backoff, hm.search_velocity);
-	return (_set_homing_func(_homing_axis_set_zero));
-}
-
-//save the current position as origin if in SET cycle and skip it if in search cycle
-static stat_t _homing_axis_set_zero(int8_t axis)			// set zero and finish up
-{
-	if (hm.set_coordinates != false) {
-		cm_set_position(axis,0);
-		cm.homed[axis] = true;
-	} else {
-        // do not set axis if in G28.4 cycle
-		cm_set_position(axis, mp_get_runtime_position(axis));
-	}
-	cm_set_axis_jerk(axis, hm.saved_jerk);					// restore the max jerk value
-
-	return (_set_homing_func(_homing_axis_start));
-}
-
-static stat_t _homing_axis_move(int8_t axis, float target, float velocity){
-	float vect[] = {0,0,0,0,0,0};
-	float flags[] = {false, false, false, false, false, false};
-
-	vect[axis] = target;
-	flags[axis] = true;
-	cm.gm.feedrate = velocity;
-	mp_flush_planner();										
-	cm_request_cycle_start();
-	stat_t status = cm_straight_feed(vect, flags);
-	if(status!= STAT_OK) return status;
-	return (STAT_RC);
-}
-
-static stat_t _homing_abort(int8_t axis)
-{
-	cm_set_axis_jerk(axis, hm.saved_jerk);					// restore the max jerk value
-	_homing_finalize_exit(axis);
-	return (STAT_HOMING_CYCLE_FAILED);						// homing state remains HOMING_NOT_HOMED
-}
-
-static stat_t _set_homing_func(stat_t (*func)(int8_t axis)){
-	hm.func = func;
-	return STAT_RC;
-}
-
-static stat_t _homing_finalize_exit(int8_t axis){
-	mp_flush_planner(); 					// should be stopped, but in case of switch closure.
-													
-
-	cm_set_coord_system(hm.saved_coord_system);				// restore to work coordinate system
-	cm_select_unit_mode(hm.saved_units_mode);
-	cm_select_distance_mode(hm.saved_distance_mode);
-	cm_set_feed_rate_mode(hm.saved_feed_rate_mode);
-	cm.gm.feedrate = hm.saved_feed_rate;
-	cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
-	//cm_cycle_end();
-	cm.cycle_state = CYCLE_OFF;
-	return (STAT_OK);
-}
-
-static stat_t _homing_error_exit(stat_t status){
-	_homing_finalize_exit(0);
-	return (status);						// homing state remains HOMING_NOT_HOMED
-}
-
-
-static int8_t _get_next_axis(int8_t axis){
-	if (axis == -1) {	// inelegant brute force solution
-		if (fp_TRUE(cm.gf.target[Z_AXIS])) return (Z_AXIS);
-		if (fp_TRUE(cm.gf.target[X_AXIS])) return (X_AXIS);
-		if (fp_TRUE(cm.gf.target[Y_AXIS])) return (Y_AXIS);
-		return (-2);	// error
-	} else if (axis == Z_AXIS) {
-		if (fp_TRUE(cm.gf.target[X_AXIS])) return (X_AXIS);
-		if (fp_TRUE(cm.gf.target[Y_AXIS])) return (Y_AXIS);
-	} else if (axis == X_AXIS) {
-		if (fp_TRUE(cm.gf.target[Y_AXIS])) return (Y_AXIS);
-	}
-	return (-1);	// done
-}
-
-
-stat_t cm_homing_callback(void){
-	if (cm.cycle_state != CYCLE_HOMING) { return (STAT_NOOP);} 	// exit if not in a homing cycle
-	if (cm_get_runtime_busy() == true) { return (STAT_RC);}	// sync to planner move ends
-	return (hm.func(hm.axis));									// execute the current homing move
-}
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "switch.h"
+#include "util.h"
+
+/*
+	axes are homed in groups, Z alone first for safety and then the rest of the requested axes,
+	one at a time in HOMING_SEQUENTIAL mode and all together in HOMING_SIMULTANEOUS mode.
+	each phase (clear, search, latch, zero backoff) is a single move of the whole group at the
+	axes own velocities. a homing switch stops the move, the axes whose switch closed are done
+	searching and the search continues with the others from where they stopped.
+*/
+
+#define HOMING_TRAVEL_EPSILON 0.01f		//mm, search travel left that counts as exhausted
+
+enum homingPhase{
+	HOMING_PHASE_IDLE = 0,				// not in the current group
+	HOMING_PHASE_SEARCH,					// moving towards its homing switch
+	HOMING_PHASE_FOUND,						// homing switch closed, waiting for the rest of the group
+	HOMING_PHASE_LATCH,						// backing off at latch velocity
+	HOMING_PHASE_ZERO_BACKOFF,		// backing off to machine zero
+	HOMING_PHASE_DONE
+};
+
+typedef struct homingAxis{
+	uint8_t phase;								// homingPhase
+	int8_t homing_switch_position;
+	int8_t limit_switch_position;	// -1 if there's no limit switch
+	float search_travel;
+	float search_velocity;
+	float latch_velocity;
+	float latch_backoff;
+	float zero_backoff;
+	float search_start;						// runtime position at the search start
+	float search_left;						// search travel left when the last search move was queued
+	float saved_jerk;							// saved and restored for each axis homed
+}homingAxis_t;
+
+struct homingSingleton{
+	// state saved from gcode model
+	uint8_t saved_units_mode;		// G20,G21 global setting
+	uint8_t saved_coord_system;		// G54 - G59 setting
+	uint8_t saved_distance_mode;	// G90,G91 global setting
+	uint8_t saved_feed_rate_mode;   // G93,G94 global setting
+	float saved_feed_rate;			// F setting
+	
+	uint8_t set_coordinates;		// G28.4 flag. true = set coords to zero at the end of homing cycle
+	stat_t (*func)(void);				// binding for callback function state machine
+	
+	uint32_t requested;					// axes left to home, GF_BIT per axis
+	uint32_t group;							// axes being homed together
+	uint8_t search_moved;				// a search move of the group was queued
+	homingAxis_t ax[AXES];			// per axis phase and settings
+};
+
+static MACHINE_LOCAL struct homingSingleton hm;
+
+static stat_t _homing_group_start(void);
+static stat_t _homing_axis_start(int8_t axis);
+static stat_t _homing_clear(void);
+static stat_t _homing_search_start(void);
+static stat_t _homing_search(void);
+static stat_t _homing_latch(void);
+static stat_t _homing_zero_backoff(void);
+static stat_t _homing_set_zero(void);
+static stat_t _homing_move(float distance[], float velocity[]);
+static stat_t _homing_abort(void);
+static stat_t _homing_finalize_exit(void);
+static stat_t _homing_error_exit(stat_t status);
+static uint32_t _get_next_group(void);
+static stat_t _set_homing_func(stat_t (*func)(void));
+
+#define FOR_GROUP_AXES(axis) for(int8_t axis = X_AXIS; axis<AXES; ++axis) if(hm.group & GF_BIT(axis))
+
+stat_t cm_cycle_homing_start(void){
+	////save current state of the machince
+	hm.saved_coord_system = cm_get_coordinate_system(ACTIVE_MODEL);
+	hm.saved_distance_mode = cm_get_distance_mode(ACTIVE_MODEL);
+	hm.saved_feed_rate_mode = cm_get_feedrate_mode(ACTIVE_MODEL);
+	hm.saved_feed_rate = cm_get_feedrate(ACTIVE_MODEL);
+	hm.saved_units_mode = cm_get_units_mode(ACTIVE_MODEL);
+	
+	//set up homing state
+	cm_select_unit_mode(MILLIMETERS);
+	cm_select_distance_mode(INCREMENTAL_MODE);
+	cm_set_coord_system(ABSOLUTE_COORDS);	// homing is done in machine coordinates
+	cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);
+	hm.set_coordinates = true;
+	
+	hm.requested = cm.gf & GF_AXES_MASK;	// latched, the parser moves on to the next blocks
+	if(hm.requested == 0){
+		return _homing_error_exit(STAT_HOMING_BAD_OR_NO_AXIS_WORDS);
+	}
+	hm.group = 0;
+	hm.func = _homing_group_start;
+	cm.cycle_state = CYCLE_HOMING;
+	cm.homing_state = HOMING_NOT_HOMED;
+	return STAT_OK;
+}
+
+
+//step zero: homing intialization for the next group of axes
+static stat_t _homing_group_start(void){
+	
+	//if no axes are left then all the requested axes are homed
+	if((hm.group = _get_next_group()) == 0){
+		cm.homing_state = HOMING_HOMED;
+		_homing_finalize_exit();
+		return STAT_OK;
+	}
+	for(int8_t axis = X_AXIS; axis<AXES; ++axis){
+		hm.ax[axis].phase = HOMING_PHASE_IDLE;
+	}
+	FOR_GROUP_AXES(axis){
+		stat_t status = _homing_axis_start(axis);
+		if(status != STAT_OK) return _homing_error_exit(status);
+	}
+	if(hm.group == 0){
+		//none of the axes has a switch in homing mode.. skip to the next group
+		return (_set_homing_func(_homing_group_start));
+	}
+	return (_set_homing_func(_homing_clear));					// start the clear
+}
+
+//_homing_axis_start//
+//input : axis
+//output : STAT_OK or the configuration error
+//fuction : checks the homing settings of an axis and sets its search, latch and backoff moves
+//notes : an axis without a switch in homing mode is dropped from the group
+//additions: 
+//
+static stat_t _homing_axis_start(int8_t axis){
+	homingAxis_t *a = &hm.ax[axis];
+	cm.homed[axis] = false;
+	
+	if(fp_ZERO(cm.a[axis].search_velocity)){return STAT_HOMING_ZERO_SEARCH_VELOCITY;}
+	if(fp_ZERO(cm.a[axis].latch_velocity)){return STAT_HOMING_ZERO_LATCH_VELOCITY;}
+	if (cm.a[axis].latch_backoff < 0) return (STAT_HOMING_ERROR_NEGATIVE_LATCH_BACKOFF);
+	
+	float travel_distance = fabs(cm.a[axis].max_travel - cm.a[axis].min_travel) + cm.a[axis].latch_backoff;
+	if (fp_ZERO(travel_distance)) return (STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL);
+	
+	uint8_t min_mode = get_switch_mode(axis, SW_MIN);
+	uint8_t max_mode = get_switch_mode(axis, SW_MAX);
+	
+	//can't have two switches homing ... one limit and one home/r home&limit
+	if(((min_mode&HOMING_BIT)^(max_mode&HOMING_BIT)) == 0){
+		return STAT_HOMING_SWITCH_MISCONFIGURATION;
+	}
+	a->search_velocity = fabsf(cm.a[axis].search_velocity);	// search velocity is always positive
+	a->latch_velocity = fabsf(cm.a[axis].latch_velocity);	// latch velocity is always positive
+	//min switch is the homing switch 
+	if(min_mode&HOMING_BIT){
+		a->homing_switch_position = SW_MIN;				// the min is the homing switch
+		a->limit_switch_position = SW_MAX;					// the max would be the limit switch
+		a->search_travel = travel_distance;
+		a->latch_backoff = -cm.a[axis].latch_backoff;
+		a->zero_backoff = -cm.a[axis].zero_backoff;
+	}else{
+		a->homing_switch_position = SW_MAX;				// the max is the homing switch
+		a->limit_switch_position = SW_MIN;					// the min would be the limit switch
+		a->search_travel = -travel_distance;
+		a->latch_backoff = cm.a[axis].latch_backoff;
+		a->zero_backoff = cm.a[axis].zero_backoff;
+	}
+	
+	uint8_t sw_mode = get_switch_mode(axis,a->homing_switch_position);
+	if ((sw_mode != SW_MODE_HOMING) && (sw_mode != SW_MODE_HOMING_LIMIT)) {
+		//if the homing switch is not in homing mode.. skip the axis
+		hm.group &=~ GF_BIT(axis);
+		return STAT_OK;
+	}
+	// disable the limit switch parameter if there is no limit switch
+	if (get_switch_mode(axis,a->limit_switch_position) == SW_MODE_DISABLED) a->limit_switch_position = -1;
+	
+	a->saved_jerk = cm_get_axis_jerk(axis);					// save the max jerk value
+	a->phase = HOMING_PHASE_SEARCH;
+	return STAT_OK;
+}
+
+//step one : clearing switches if it has been invoked before starting homing cycle
+static stat_t _homing_clear(void){
+	float distance[AXES] = {0};
+	float velocity[AXES] = {0};
+	uint8_t closed = false;
+	FOR_GROUP_AXES(axis){
+		homingAxis_t *a = &hm.ax[axis];
+		velocity[axis] = a->search_velocity;
+		if (get_switch_state(axis,a->homing_switch_position) == SW_CLOSED) {
+			distance[axis] = a->latch_backoff;
+			closed = true;
+		}else if((a->limit_switch_position >= 0) && (get_switch_state(axis,a->limit_switch_position) == SW_CLOSED)) {
+			distance[axis] = -a->latch_backoff;
+			closed = true;
+		}
+	}
+	_set_homing_func(_homing_search_start);
+	if(closed){
+		return _homing_move(distance,velocity);
+	}
+	return STAT_RC;
+}
+
+//step two: search for the homing switches
+static stat_t _homing_search_start(void){
+	FOR_GROUP_AXES(axis){
+		cm_set_axis_jerk(axis, cm.a[axis].homing_jerk);			// use the homing jerk for search onward
+		hm.ax[axis].search_start = mp_get_runtime_position(axis);
+	}
+	hm.search_moved = false;
+	return (_set_homing_func(_homing_search));
+}
+
+//_homing_search//
+//input : none
+//output : STAT_RC while searching
+//fuction : one search move of the axes that haven't found their switch yet
+//notes : runs again every time the move stops. every axis moves at its own search velocity
+//as far as the axis with the least travel left can go, so none of them overruns its travel.
+//a search move that found no switch and moved no axis fails the cycle, it would be queued again
+//and again
+//additions: 
+//
+static stat_t _homing_search(void){
+	float distance[AXES] = {0};
+	float velocity[AXES] = {0};
+	float time = 0;
+	uint8_t searching = false;
+	uint8_t progress = (hm.search_moved == false);
+	FOR_GROUP_AXES(axis){
+		homingAxis_t *a = &hm.ax[axis];
+		if(a->phase != HOMING_PHASE_SEARCH) continue;
+		if(get_switch_state(axis,a->homing_switch_position) == SW_CLOSED){
+			a->phase = HOMING_PHASE_FOUND;				// this axis is stopped, the others carry on
+			progress = true;
+			continue;
+		}
+		float left = a->search_travel - (mp_get_runtime_position(axis) - a->search_start);
+		if((left*a->search_travel) <= 0 || fabsf(left) < HOMING_TRAVEL_EPSILON){
+			return (_homing_abort());							// whole travel searched without a switch
+		}
+		if(fabsf(a->search_left - left) >= HOMING_TRAVEL_EPSILON) progress = true;
+		a->search_left = left;
+		float axis_time = fabsf(left)/a->search_velocity;
+		if(!searching || (axis_time < time)) time = axis_time;
+		searching = true;
+	}
+	if(!searching){
+		return (_set_homing_func(_homing_latch));
+	}
+	if(!progress){
+		return (_homing_abort());								// the last search move didn't move
+	}
+	FOR_GROUP_AXES(axis){
+		homingAxis_t *a = &hm.ax[axis];
+		if(a->phase != HOMING_PHASE_SEARCH) continue;
+		velocity[axis] = a->search_velocity;
+		distance[axis] = copysignf(a->search_velocity*time,a->search_travel);
+	}
+	hm.search_moved = true;
+	return _homing_move(distance,velocity);
+}
+
+//step three: move away from switches at latch velocity
+static stat_t _homing_latch(void){
+	float distance[AXES] = {0};
+	float velocity[AXES] = {0};
+	FOR_GROUP_AXES(axis){
+		homingAxis_t *a = &hm.ax[axis];
+		if (get_switch_state(axis,a->homing_switch_position) != SW_CLOSED)
+			return (_homing_abort());
+		a->phase = HOMING_PHASE_LATCH;
+		distance[axis] = a->latch_backoff;
+		velocity[axis] = a->latch_velocity;
+	}
+	_set_homing_func(_homing_zero_backoff);
+	return _homing_move(distance,velocity);
+}
+
+//step four: zero backoff from switches
+static stat_t _homing_zero_backoff(void)		// backoff to zero position
+{
+	float distance[AXES] = {0};
+	float velocity[AXES] = {0};
+	FOR_GROUP_AXES(axis){
+		homingAxis_t *a = &hm.ax[axis];
+		a->phase = HOMING_PHASE_ZERO_BACKOFF;
+		distance[axis] = a->zero_backoff;
+		velocity[axis] = a->search_velocity;
+	}
+	_set_homing_func(_homing_set_zero);
+	return _homing_move(distance,velocity);
+}
+
+//save the current position as origin if in SET cycle and skip it if in search cycle
+static stat_t _homing_set_zero(void)			// set zero and finish up
+{
+	FOR_GROUP_AXES(axis){
+		if (hm.set_coordinates != false) {
+			cm_set_position(axis,0);
+			cm.homed[axis] = true;
+		} else {
+			// do not set axis if in G28.4 cycle
+			cm_set_position(axis, mp_get_runtime_position(axis));
+		}
+		cm_set_axis_jerk(axis, hm.ax[axis].saved_jerk);	// restore the max jerk value
+		hm.ax[axis].phase = HOMING_PHASE_DONE;
+	}
+	return (_set_homing_func(_homing_group_start));
+}
+
+//_homing_move//
+//input : per axis distance and velocity
+//output : STAT_RC or the error of the move
+//fuction : one straight move of the group where no axis exceeds its velocity
+//notes : the move takes as long as its slowest axis needs
+//additions: 
+//
+static stat_t _homing_move(float distance[], float velocity[]){
+	float time = 0;
+	float length = 0;
+	uint32_t flags = 0;
+	
+	FOR_GROUP_AXES(axis){
+		if(fp_ZERO(distance[axis])) continue;
+		float axis_time = fabsf(distance[axis])/velocity[axis];
+		if(axis_time > time) time = axis_time;
+		length += distance[axis]*distance[axis];
+		flags |= GF_BIT(axis);
+	}
+	if(flags == 0) return (STAT_RC);
+	cm.gm.feedrate = sqrtf(length)/time;
+	mp_flush_planner();										
+	cm_request_cycle_start();
+	stat_t status = cm_straight_feed(distance, flags);
+	if(status!= STAT_OK) return status;
+	return (STAT_RC);
+}
+
+static stat_t _homing_abort(void)
+{
+	FOR_GROUP_AXES(axis){
+		cm_set_axis_jerk(axis, hm.ax[axis].saved_jerk);	// restore the max jerk value
+	}
+	_homing_finalize_exit();
+	return (STAT_HOMING_CYCLE_FAILED);						// homing state remains HOMING_NOT_HOMED
+}
+
+static stat_t _set_homing_func(stat_t (*func)(void)){
+	hm.func = func;
+	return STAT_RC;
+}
+
+static stat_t _homing_finalize_exit(void){
+	mp_flush_planner(); 					// should be stopped, but in case of switch closure.
+													
+
+	cm_set_coord_system(hm.saved_coord_system);				// restore to work coordinate system
+	cm_select_unit_mode(hm.saved_units_mode);
+	cm_select_distance_mode(hm.saved_distance_mode);
+	cm_set_feed_rate_mode(hm.saved_feed_rate_mode);
+	cm.gm.feedrate = hm.saved_feed_rate;
+	cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
+	//cm_cycle_end();
+	cm.cycle_state = CYCLE_OFF;
+	return (STAT_OK);
+}
+
+static stat_t _homing_error_exit(stat_t status){
+	_homing_finalize_exit();
+	return (status);						// homing state remains HOMING_NOT_HOMED
+}
+
+//_get_next_group//
+//input : none
+//output : the axes to home next, 0 when all are done
+//fuction : Z goes first on its own so the tool is clear before anything else moves
+//notes : 
+//additions: 
+//
+static uint32_t _get_next_group(void){
+	uint32_t group = hm.requested;
+	if(group & GF_BIT(Z_AXIS)){
+		group = GF_BIT(Z_AXIS);
+	}else if(cm.homing_mode == HOMING_SEQUENTIAL){
+		group &= -group;								// lowest axis first, X then Y
+	}
+	hm.requested &=~ group;
+	return group;
+}
+
+
+stat_t cm_homing_callback(void){
+	if (cm.cycle_state != CYCLE_HOMING) { return (STAT_NOOP);} 	// exit if not in a homing cycle
+	if (cm_get_runtime_busy() == true) { return (STAT_RC);}	// sync to planner move ends
+	return (hm.func());											// execute the current homing move
+}
@@ -0,0 +1,222 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "profile.h"
+#include "plan_command.h"
+#include "util.h"
+
+/*
+	$J X Y Z (A B C) jogs at a velocity vector, every word is the velocity of its axis in units
+	per minute, $J alone or with every axis at 0 cancels. the cycle streams short continuous
+	moves along the vector and keeps just enough of them queued for the planner to stop within
+	them, so the ramps are the planner's jerk limited ones. a new vector takes the queued moves
+	back off the queue but the ones the planner needs to change to it, braking to the new velocity
+	along the same direction or to a stop for a turn, and is queued right behind them. a cancel
+	stops queueing, the queued moves end at 0 velocity. g-code blocks are refused while jogging.
+*/
+
+#define JOG_SEGMENT_TIME 0.0005f					//minutes of travel per queued move, 30ms
+#define JOG_BLOCKS_MAX 16									//queued moves at the highest jog velocity
+#define JOG_STOP_ITERATIONS 16						//doublings of the segment length to find the stopping distance
+#define JOG_SAME_DIRECTION 0.99f					//cosine above which a new vector only changes the velocity
+
+struct joggingSingleton{
+	// state saved from gcode model
+	uint8_t saved_coord_system;		// G54 - G59 setting
+	uint8_t saved_distance_mode;	// G90,G91 global setting
+	uint8_t saved_units_mode;			// G20,G21 global setting
+	uint8_t saved_feed_rate_mode;	// G93,G94 global setting
+	uint8_t saved_path_control;		// G61,G61.1,G64 global setting
+	float saved_feed_rate;				// F setting
+
+	uint8_t active;
+	volatile uint8_t cancel;			// set from the serial interrupt too
+	float unit[AXES];							// direction of the jog
+	float velocity;								// along unit, mm/min
+	float segment_length;					// length of a queued move
+	uint8_t blocks;								// queued moves that cover the stopping distance
+	uint8_t keep;									// queued moves a new vector keeps, 0 without one
+};
+
+static MACHINE_LOCAL struct joggingSingleton jg;
+
+static stat_t _jogging_finish(void);
+static float _jogging_stop_length(float velocity);
+static uint8_t _jogging_keep(float unit[], float velocity);
+
+//cm_jog_velocity//
+//input : velocity of each axis in the block units per minute, axes words of the block
+//output : STAT_OK or the error
+//fuction : starts jogging or changes the vector of the running jog
+//notes : the velocity is clamped to the feedrate limits of the moving axes
+//additions:
+//
+stat_t cm_jog_velocity(float velocity[], uint32_t flags){
+	if(cm.machine_state == MACHINE_ALARM){return STAT_MACHINE_ALARMED;}
+	if((cm.cycle_state == CYCLE_HOMING) || (cm.cycle_state == CYCLE_PROBE)){return STAT_JOG_CONFLICT;}
+	if(cm.gm.cutter_comp != CUTTER_COMP_OFF){return STAT_JOG_CONFLICT;}	// a compensated move may be held
+	if((jg.active == false) && ((cm_get_runtime_busy() == true) || (mp_get_run_buffer() != NULL))){
+		return STAT_JOG_CONFLICT;					// g-code motion still queued
+	}
+
+	float vector[AXES] = {0};
+	float velocity_square = 0;
+	uint8_t units_mode = (jg.active == true)? jg.saved_units_mode : cm.gm.units_mode;	// the jog runs in millimeters
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		if(flags & GF_BIT(axis)){
+			vector[axis] = ((units_mode == INCHES) && !AXIS_IS_ROTARY(axis))? velocity[axis]*MM_PER_INCH : velocity[axis];
+			velocity_square += square(vector[axis]);
+		}
+	}
+	if(fp_ZERO(velocity_square)){
+		cm_jog_cancel();
+		return STAT_OK;
+	}
+	float speed = _sqrtf(velocity_square);
+	float unit[AXES];
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		unit[axis] = vector[axis]/speed;
+		if(!fp_ZERO(unit[axis])){
+			speed = min(speed,cm.a[axis].max_feedrate/fabsf(unit[axis]));
+		}
+	}
+	jg.keep = ((jg.active == true) && (jg.cancel == false))? _jogging_keep(unit,speed) : 0;
+	copy_vector(jg.unit,unit);
+	jg.velocity = speed;
+	jg.segment_length = speed*JOG_SEGMENT_TIME;
+	uint32_t blocks = (uint32_t)(_jogging_stop_length(speed)/jg.segment_length) + 2;
+	jg.blocks = (blocks > JOG_BLOCKS_MAX)? JOG_BLOCKS_MAX : (uint8_t)blocks;
+	jg.cancel = false;
+
+	if(jg.active == false){
+		jg.saved_coord_system = cm_get_coordinate_system(ACTIVE_MODEL);
+		jg.saved_distance_mode = cm_get_distance_mode(ACTIVE_MODEL);
+		jg.saved_units_mode = cm_get_units_mode(ACTIVE_MODEL);
+		jg.saved_feed_rate_mode = cm_get_feedrate_mode(ACTIVE_MODEL);
+		jg.saved_path_control = cm.gm.path_control;
+		jg.saved_feed_rate = cm.gm.feedrate;
+		cm_select_unit_mode(MILLIMETERS);
+		cm_select_distance_mode(ABSOLUTE_MODE);
+		cm_set_coord_system(ABSOLUTE_COORDS);		// the moves are queued in machine coordinates
+		cm_set_absolute_override(true);				// without the G92 offset, as in G53
+		cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);
+		cm_select_path_control(PATH_CONTINUOUS);
+		cm.cycle_state = CYCLE_JOG;
+		jg.active = true;
+	}
+	return STAT_OK;
+}
+
+//cm_jog_cancel//
+//input : none
+//output : none
+//fuction : stops the jog at the end of the moves already queued
+//notes : interrupt safe, the jogging callback ends the cycle once the machine stopped
+//additions:
+//
+void cm_jog_cancel(void){
+	jg.cancel = true;
+}
+
+//cm_jogging_callback//
+//input : none
+//output : STAT_NOOP when there's nothing to queue, STAT_OK when a move was queued
+//fuction : keeps the jog moves queued
+//notes : never holds the controller loop, the command reader has to see the next $J. the moves a
+//new vector doesn't keep are dropped right before its first move is queued, the kept ones are
+//replanned to stop at their end and only that move lets them run on
+//additions:
+//
+stat_t cm_jogging_callback(void){
+	if(jg.active == false){return STAT_NOOP;}
+	if(jg.cancel == true){
+		if((cm_get_runtime_busy() == true) || (mp_get_run_buffer() != NULL)){return STAT_NOOP;}
+		return _jogging_finish();
+	}
+	if(jg.keep != 0){
+		if(mp_drop_queued_lines(jg.keep) != 0){
+			copy_vector(cm.position,mm.position);
+		}
+		jg.keep = 0;
+	}else if((PLANNER_BUFFER_POOL_SIZE - mp_get_available_buffers()) >= jg.blocks){
+		return STAT_NOOP;
+	}
+
+	float target[AXES];
+	float length = jg.segment_length;
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		target[axis] = cm.position[axis] + jg.unit[axis]*jg.segment_length;
+		if(cm.homed[axis] && (cm.a[axis].max_travel > cm.a[axis].min_travel)){	// soft limits
+			float clipped = max(min(target[axis],cm.a[axis].max_travel),cm.a[axis].min_travel);
+			if((clipped != target[axis]) && !fp_ZERO(jg.unit[axis])){
+				length = min(length,(clipped-cm.position[axis])/jg.unit[axis]);
+			}
+		}
+	}
+	if(length < EPSILON){						// the vector runs out of travel, stop there
+		cm_jog_cancel();
+		return STAT_OK;
+	}
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		target[axis] = cm.position[axis] + jg.unit[axis]*length;
+	}
+	cm.gm.feedrate = jg.velocity;
+	cm_straight_feed(target,GF_AXES_MASK);
+	return STAT_OK;
+}
+
+//_jogging_stop_length//
+//input : velocity
+//output : distance the planner needs to stop from it
+//fuction :
+//notes : taken from the planner's own velocity change estimate so it matches the ramps it plans
+//additions:
+//
+static float _jogging_stop_length(float velocity){
+	const mpProfile_t *profile = mp_get_profile(PATH_CONTINUOUS);
+	float length = jg.segment_length;
+	for(uint8_t i=0; i<JOG_STOP_ITERATIONS; ++i){
+		if(profile->estimate_deltav(profile->length_term(length,square(length))) >= velocity) break;
+		length *= 2;
+	}
+	return length;
+}
+
+//_jogging_keep//
+//input : unit vector and velocity of the new jog
+//output : queued moves the change to the new vector needs, 0 to keep them all
+//fuction :
+//notes : the kept moves cover the velocity change along the same direction, a stop otherwise
+//additions:
+//
+static uint8_t _jogging_keep(float unit[], float velocity){
+	float cosine = 0;
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		cosine += jg.unit[axis]*unit[axis];
+	}
+	float deltav = (cosine > JOG_SAME_DIRECTION)? (jg.velocity - velocity) : jg.velocity;
+	uint32_t blocks = 2;												// the running move and the one the runtime may be loading
+	if(deltav > 0){
+		blocks += (uint32_t)(_jogging_stop_length(deltav)/jg.segment_length) + 1;	// the part of a move counts
+	}
+	return (blocks >= PLANNER_BUFFER_POOL_SIZE)? 0 : (uint8_t)blocks;
+}
+
+static stat_t _jogging_finish(void){
+	cm_set_absolute_override(false);
+	cm_set_coord_system(jg.saved_coord_system);				// restore to work coordinate system
+	cm_select_unit_mode(jg.saved_units_mode);
+	cm_select_distance_mode(jg.saved_distance_mode);
+	cm_set_feed_rate_mode(jg.saved_feed_rate_mode);
+	cm_select_path_control(jg.saved_path_control);
+	cm.gm.feedrate = jg.saved_feed_rate;
+	cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
+	cm.cycle_state = CYCLE_OFF;
+	jg.active = false;
+	jg.keep = 0;
+	return STAT_OK;
+}
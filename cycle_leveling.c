@@ -0,0 +1,303 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "kinematics.h"
+#include "util.h"
+
+/*
+	G29 X Y I J Z probes a grid of I x J points between the current position and X Y, every point
+	with a G38.2 from the current Z down to Z at the current feed, and keeps the heights as a map
+	relative to the first point. G29.1 clears it.
+	while the map is enabled it's the Z correction of the kinematics stage so every segment the
+	runtime prepares has its Z corrected by bilinear interpolation of the map at its XY. long moves
+	are corrected along their length without touching the program, the planner never sees it.
+	the correction is switched only with the runtime idle. the tool stays where it is and its Z is
+	re-seated to what the new correction makes of it, so the next move takes the difference in at
+	its planned acceleration instead of its first segment jumping by it.
+*/
+
+#define LV_GRID_MAX 16						//points per side, 1KB of map
+
+struct levelingSingleton{
+	// state saved from gcode model
+	uint8_t saved_distance_mode;	// G90,G91 global setting
+	uint8_t saved_units_mode;			// G20,G21 global setting
+
+	uint8_t active;								// probing the grid
+	stat_t (*func)(void);					// binding for callback function state machine
+	uint16_t point;								// grid point being probed
+	float clearance;							// machine Z between the points
+	float depth;									// machine Z the probes run to
+	uint8_t grid_nx;							// grid of the G29 block, the map takes it once it's off
+	uint8_t grid_ny;
+	float grid_x1;								// far corner
+	float grid_y1;
+
+	// the map, in machine coordinates
+	uint8_t enabled;
+	uint8_t nx;
+	uint8_t ny;
+	float x0;
+	float y0;
+	float dx;
+	float dy;
+	float dx_recip;
+	float dy_recip;
+	float z[LV_GRID_MAX][LV_GRID_MAX];		// [y][x], height over the first point
+};
+
+static MACHINE_LOCAL struct levelingSingleton lv;
+
+static stat_t _leveling_start(void);
+static stat_t _leveling_move(void);
+static stat_t _leveling_probe(void);
+static stat_t _leveling_record(void);
+static stat_t _leveling_finish(void);
+static stat_t _leveling_enable(void);
+static stat_t _leveling_clear(void);
+static stat_t _leveling_exit(stat_t status);
+static void _leveling_point(float target[]);
+static void _lv_switch(float (*correction)(float x, float y));
+
+static stat_t _set_leveling_func(stat_t (*func)(void)){
+	lv.func = func;
+	return STAT_RC;
+}
+
+//cm_probe_grid//
+//input : far corner and depth, axes words of the block, I J points per side
+//output : STAT_OK or the block error
+//fuction : starts probing the height map
+//notes : the map is disabled once the runtime is idle and stays off until the whole grid is
+//probed. the points are machine coordinates, the cycle moves with absolute override (G53)
+//additions:
+//
+stat_t cm_probe_grid(float target[], uint32_t flags, float points[]){
+	uint32_t needed = GF_BIT(X_AXIS)|GF_BIT(Y_AXIS)|GF_BIT(Z_AXIS)|GF_BIT(GF_CENTER_OFFSET_I)|GF_BIT(GF_CENTER_OFFSET_J);
+	if((flags & needed) != needed){
+		return STAT_PROBE_GRID_SPECIFICATION;
+	}
+	if(fp_ZERO(cm.gm.feedrate) || (cm.gm.feedrate_mode == INVERSE_TIME_MODE)){
+		return STAT_GCODE_FEEDRATE_NOT_SPECIFIED;
+	}
+	uint8_t nx = (uint8_t)(points[0]+0.5f);
+	uint8_t ny = (uint8_t)(points[1]+0.5f);
+	if((nx < 2) || (ny < 2) || (nx > LV_GRID_MAX) || (ny > LV_GRID_MAX)){
+		return STAT_PROBE_GRID_SPECIFICATION;
+	}
+	cm_set_model_target_mask(target, flags & GF_AXES_MASK);	// far corner and depth in machine coordinates
+	lv.grid_x1 = cm.gm.target[X_AXIS];
+	lv.grid_y1 = cm.gm.target[Y_AXIS];
+	lv.depth = cm.gm.target[Z_AXIS];
+	copy_vector(cm.gm.target,cm.position);						// nothing moves in this block
+	if((fabsf(lv.grid_x1-cm.position[X_AXIS]) < MINIMUM_PROBE_DISTANCE) ||
+		 (fabsf(lv.grid_y1-cm.position[Y_AXIS]) < MINIMUM_PROBE_DISTANCE) ||
+		 (lv.depth > cm.position[Z_AXIS]-MINIMUM_PROBE_DISTANCE)){
+		return STAT_PROBE_GRID_SPECIFICATION;
+	}
+	lv.grid_nx = nx;
+	lv.grid_ny = ny;
+
+	lv.saved_distance_mode = cm_get_distance_mode(ACTIVE_MODEL);
+	lv.saved_units_mode = cm_get_units_mode(ACTIVE_MODEL);
+	cm_select_unit_mode(MILLIMETERS);
+	cm_select_distance_mode(ABSOLUTE_MODE);
+
+	lv.point = 0;
+	lv.active = true;
+	lv.func = _leveling_start;
+	return STAT_OK;
+}
+
+//cm_leveling_clear//
+//input : none
+//output : STAT_OK
+//fuction : G29.1, drops the map
+//notes : the correction goes once the runtime is idle, the moves queued before it keep it
+//additions:
+//
+stat_t cm_leveling_clear(void){
+	lv.active = true;
+	lv.func = _leveling_clear;
+	return STAT_OK;
+}
+
+stat_t cm_leveling_callback(void){
+	if (lv.active == false) { return (STAT_NOOP);}				// exit if not probing the grid
+	if ((cm.cycle_state == CYCLE_PROBE) || (cm.probe_state == PROBE_WAITING)) { return (STAT_RC);}
+	if (cm_get_runtime_busy() == true) { return (STAT_RC);}	// sync to planner move ends
+	return (lv.func());
+}
+
+//_leveling_point//
+//input : target
+//output : none
+//fuction : XY of the current grid point
+//notes : the rows are probed back and forth so the moves between the points stay short
+//additions:
+//
+static void _leveling_point(float target[]){
+	uint8_t j = lv.point / lv.nx;
+	uint8_t i = lv.point % lv.nx;
+	if(j & 1) i = lv.nx-1-i;
+	target[X_AXIS] = lv.x0 + i*lv.dx;
+	target[Y_AXIS] = lv.y0 + j*lv.dy;
+}
+
+//step zero: the map off and the grid from where the tool is, the first point is right under it
+static stat_t _leveling_start(void){
+	lv_disable();
+	cm_set_absolute_override(true);		// the grid is probed in machine coordinates
+	lv.clearance = cm.position[Z_AXIS];
+	lv.x0 = cm.position[X_AXIS];
+	lv.y0 = cm.position[Y_AXIS];
+	lv.nx = lv.grid_nx;
+	lv.ny = lv.grid_ny;
+	lv.dx = (lv.grid_x1-lv.x0)/(lv.nx-1);
+	lv.dy = (lv.grid_y1-lv.y0)/(lv.ny-1);
+	lv.dx_recip = 1/lv.dx;
+	lv.dy_recip = 1/lv.dy;
+	return _leveling_probe();
+}
+
+//step one: lift to the clearance and go over the next point
+static stat_t _leveling_move(void){
+	float target[AXES] = {0};
+	target[Z_AXIS] = lv.clearance;
+	stat_t status = cm_straight_traverse(target, GF_BIT(Z_AXIS));
+	if(status != STAT_OK) return _leveling_exit(status);
+	_leveling_point(target);
+	status = cm_straight_traverse(target, GF_BIT(X_AXIS)|GF_BIT(Y_AXIS));
+	if(status != STAT_OK) return _leveling_exit(status);
+	return (_set_leveling_func(_leveling_probe));
+}
+
+//step two: probe down, the probe cycle takes over until it's done
+static stat_t _leveling_probe(void){
+	float target[AXES] = {0};
+	_leveling_point(target);
+	target[Z_AXIS] = lv.depth;
+	stat_t status = cm_straight_probe(target, GF_BIT(X_AXIS)|GF_BIT(Y_AXIS)|GF_BIT(Z_AXIS), true, true);
+	if(status != STAT_OK) return _leveling_exit(status);
+	return (_set_leveling_func(_leveling_record));
+}
+
+//step three: keep the height and go on with the next point
+static stat_t _leveling_record(void){
+	if(cm.probe_state != PROBE_SUCCEEDED){
+		return _leveling_exit(STAT_PROBE_CYCLE_FAILED);
+	}
+	uint8_t j = lv.point / lv.nx;
+	uint8_t i = lv.point % lv.nx;
+	if(j & 1) i = lv.nx-1-i;
+	lv.z[j][i] = cm.probe_results[Z_AXIS];
+	if(++lv.point < lv.nx*lv.ny){
+		return (_set_leveling_func(_leveling_move));
+	}
+	return (_set_leveling_func(_leveling_finish));
+}
+
+//step four: back to the clearance
+static stat_t _leveling_finish(void){
+	float target[AXES] = {0};
+	target[Z_AXIS] = lv.clearance;
+	stat_t status = cm_straight_traverse(target, GF_BIT(Z_AXIS));
+	if(status != STAT_OK) return _leveling_exit(status);
+	return (_set_leveling_func(_leveling_enable));
+}
+
+//step five: enable the map, the runtime is idle. the clearance again takes the correction in
+static stat_t _leveling_enable(void){
+	float reference = lv.z[0][0];
+	for(uint8_t j=0; j<lv.ny; ++j){
+		for(uint8_t i=0; i<lv.nx; ++i){
+			lv.z[j][i] -= reference;
+		}
+	}
+	lv_enable();
+	float target[AXES] = {0};
+	target[Z_AXIS] = lv.clearance;
+	return _leveling_exit(cm_straight_traverse(target, GF_BIT(Z_AXIS)));
+}
+
+//G29.1, the runtime is idle
+static stat_t _leveling_clear(void){
+	lv_disable();
+	lv.nx = 0;
+	lv.active = false;
+	return STAT_OK;
+}
+
+static stat_t _leveling_exit(stat_t status){
+	cm_set_absolute_override(false);									// back to the work coordinates
+	cm_select_unit_mode(lv.saved_units_mode);
+	cm_select_distance_mode(lv.saved_distance_mode);
+	cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
+	lv.active = false;
+	return status;
+}
+
+//lv_enable//
+//input : none
+//output : none
+//fuction : applies the map to the segments the runtime prepares from now on
+//notes : only with the runtime idle, see _lv_switch
+//additions:
+//
+void lv_enable(void){
+	if(lv.nx == 0) return;
+	_lv_switch(lv_get_offset);
+	lv.enabled = true;
+}
+
+void lv_disable(void){
+	_lv_switch(NULL);
+	lv.enabled = false;
+}
+
+//_lv_switch//
+//input : Z correction, NULL for none
+//output : none
+//fuction : swaps the Z correction of the kinematics without moving the tool
+//notes : only with the runtime idle. Z is re-seated so Z plus the correction stays on the same
+//steps, cm_set_position takes the planner, the runtime and the step and encoder counts
+//(en_set_encoder_steps) along. the next move takes the difference in at its own acceleration
+//additions:
+//
+static void _lv_switch(float (*correction)(float x, float y)){
+	float x = cm.position[X_AXIS];
+	float y = cm.position[Y_AXIS];
+	float z = cm.position[Z_AXIS];
+	if(kn.z_correction != NULL){z += kn.z_correction(x,y);}
+	kn_set_z_correction(correction);
+	if(correction != NULL){z -= correction(x,y);}
+	cm_set_position(Z_AXIS,z);
+}
+
+//lv_get_offset//
+//input : machine XY
+//output : Z correction
+//fuction : bilinear interpolation of the map
+//notes : EXEC INTERRUPT, through the kinematics stage. constant time, the cell is found by scaling
+//with the reciprocal spacing. outside the grid the edge heights are extended
+//additions:
+//
+float lv_get_offset(float x, float y){
+	float u = (x - lv.x0)*lv.dx_recip;
+	float v = (y - lv.y0)*lv.dy_recip;
+	if(u < 0) u = 0; else if(u > lv.nx-1) u = lv.nx-1;
+	if(v < 0) v = 0; else if(v > lv.ny-1) v = lv.ny-1;
+	uint8_t i = (uint8_t)u;
+	uint8_t j = (uint8_t)v;
+	if(i > lv.nx-2) i = lv.nx-2;						// the far edge is the end of the last cell
+	if(j > lv.ny-2) j = lv.ny-2;
+	u -= i;
+	v -= j;
+	float z0 = lv.z[j][i] + (lv.z[j][i+1]-lv.z[j][i])*u;
+	float z1 = lv.z[j+1][i] + (lv.z[j+1][i+1]-lv.z[j+1][i])*u;
+	return z0 + (z1-z0)*v;
+}
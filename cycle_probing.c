@@ -1,144 +1,206 @@
-
-#include <stdint.h>
-#include <stdbool.h>
-#include <math.h>
-#include <string.h>
-#include "system.h"
-#include "canonical.h"
-#include "planner.h"
-#include "switch.h"
-#include "util.h"
-
-
-
-struct probeSingleton{
-	
-	uint8_t saved_coordinate;
-	uint8_t saved_distance_mode;
-	uint8_t saved_units_mode;
-	uint8_t saved_feedrate_mode;
-	uint8_t saved_feedrate;
-	float saved_jerk[AXES];
-	
-	stat_t (*func)(void);
-	
-	float start_position[AXES];
-	float target[AXES];
-	float flags[AXES];
-};
-
-static struct probeSingleton pb;
-
-static uint8_t _probing_init(void);
-static stat_t _probing_start(void);
-static stat_t _probing_finish(void);
-static void	_probe_restore_settings(void);
-static stat_t _probing_error_exit(stat_t status);
-static stat_t _probing_finalize(void);
-
-stat_t _set_pb_function(stat_t (*func)(void)){
-	pb.func = func;
-	return STAT_RC;
-}
-
-stat_t cm_straight_probe(float target[],float flags[]){
-	
-	if(cm.gm.feedrate_mode == INVERSE_TIME_MODE){
-		return STAT_PROBE_INVERSE_TIME_FEEDRATE;
-	}
-	
-	if ((cm.gm.feedrate_mode != INVERSE_TIME_MODE) && (fp_ZERO(cm.gm.feedrate))) {
-		return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
-	}
-	
-	if(fp_ZERO(flags[X_AXIS]) && fp_ZERO(flags[Y_AXIS]) && fp_ZERO(flags[Z_AXIS]))
-		return STAT_PROBE_ALL_AXES_OMITTED;
-	
-	copy_vector(pb.target, target);		// set probe move endpoint
-	copy_vector(pb.flags, flags);		// set axes involved on the move
-	clear_vector(cm.probe_results);		// clear the old probe position.
-										// NOTE: relying on probe_result will not detect a probe to 0,0,0.
-
-	cm.probe_state = PROBE_WAITING;		// wait until planner queue empties before completing initialization
-	pb.func = _probing_init; 			// bind probing initialization function
-	return (STAT_OK);
-}
-
-stat_t cm_probe_callback(void)
-{
-	if ((cm.cycle_state != CYCLE_PROBE) && (cm.probe_state != PROBE_WAITING)) {
-		return (STAT_NOOP);				// exit if not in a probe cycle or waiting for one
-	}
-	if (cm_get_runtime_busy() == true) { return (STAT_RC);}	// sync to planner move ends
-	return (pb.func());                                         // execute the current homing move
-}
-
-
-static stat_t _probing_init(void){
-	cm.cycle_state = CYCLE_PROBE;
-	cm.probe_state = PROBE_FAILED;
-	
-	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
-		pb.saved_jerk[axis] = cm_get_axis_jerk(axis);
-		pb.start_position[axis] = cm_get_absolute_position(ACTIVE_MODEL, axis);
-		cm_set_axis_jerk(axis,cm.a[axis].homing_jerk);
-	}
-	
-	if(get_vector_length(pb.target,pb.start_position) < MINIMUM_PROBE_DISTANCE){
-		_probing_error_exit(STAT_MINIMUM_PROBE_DISTANCE);
-	}
-	
-	pb.saved_coordinate = cm_get_coordinate_system(ACTIVE_MODEL);
-	pb.saved_distance_mode = cm_get_distance_mode(ACTIVE_MODEL);
-	cm_select_distance_mode(ABSOLUTE_MODE);
-	cm_set_coord_system(ABSOLUTE_COORDS);
-
-	//cm_spindle_control(SPINDLE_OFF);
-	return (_set_pb_function(_probing_start));							// start the move
-}
-
-static stat_t _probing_start(void){
-	if(get_probe_state() == SW_OPEN){
-		uint8_t status = cm_straight_feed(pb.target,pb.flags);
-		if(status != STAT_OK) return _probing_error_exit(status);
-	}
-	return (_set_pb_function(_probing_finish));
-}
-
-static stat_t _probing_finish(void){
-	cm.probe_state = (get_probe_state() == SW_CLOSED)? PROBE_SUCCEEDED:PROBE_FAILED;
-	for( uint8_t axis=0; axis<AXES; axis++ ) {
-		// if we got here because of a limit switch being hit we need to keep the model position correct
-		cm_set_position(axis, mp_get_runtime_work_position(axis));
-
-		// store the probe results
-		cm.probe_results[axis] = cm_get_absolute_position(ACTIVE_MODEL, axis);
-	}
-	return (_set_pb_function(_probing_finalize));
-}
-
-
-static stat_t _probing_finalize(void){
-	_probe_restore_settings();
-	return STAT_OK;
-}
-
-static stat_t _probing_error_exit(stat_t status){
-	_probe_restore_settings();
-	return status;
-}
-
-static void	_probe_restore_settings(void){
-	
-	mp_flush_planner();
-	
-	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
-		cm_set_axis_jerk(axis,pb.saved_jerk[axis]);
-	}
-	cm_select_distance_mode(pb.saved_distance_mode);
-	cm_set_coord_system(pb.saved_coordinate);
-	cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
-	//cm_cycle_end();
-	cm.cycle_state = CYCLE_OFF;
-}
-
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "switch.h"
+#include "encoder.h"
+#include "kinematics.h"
+#include "HAL.h"
+#include "util.h"
+
+/*
+	the probe position is latched in the probe capture interrupt (HAL.c) at the edge itself,
+	from the step counts of the motors, so it doesn't depend on how far the move runs before it
+	stops. the position the move stops at is only used to keep the model in step with the runtime.
+*/
+
+struct probeSingleton{
+	
+	uint8_t saved_coordinate;
+	uint8_t saved_distance_mode;
+	uint8_t saved_units_mode;
+	uint8_t saved_feedrate_mode;
+	uint8_t saved_feedrate;
+	float saved_jerk[AXES];
+	
+	stat_t (*func)(void);
+	
+	float start_position[AXES];
+	float target[AXES];
+	uint32_t flags;
+	
+	uint8_t failure_is_error;		// G38.2 and G38.4
+	int8_t contact;							// probe state that ends the probe, SW_OPEN when probing away
+	volatile uint8_t latched;		// set by the capture interrupt
+	int32_t latched_steps[MOTORS];
+};
+
+static MACHINE_LOCAL struct probeSingleton pb;
+
+static uint8_t _probing_init(void);
+static stat_t _probing_start(void);
+static stat_t _probing_finish(void);
+static void	_probe_restore_settings(void);
+static stat_t _probing_error_exit(stat_t status);
+static stat_t _probing_finalize(void);
+static void _probe_latched_position(float position[]);
+
+stat_t _set_pb_function(stat_t (*func)(void)){
+	pb.func = func;
+	return STAT_RC;
+}
+
+//cm_straight_probe//
+//input : target and the axes words of the block, G38.2 to G38.5 flavour
+//output : STAT_OK or the block error
+//fuction : queues a probe cycle, it starts once the planner queue empties
+//notes : toward probes until contact is made, away until it's lost
+//additions: 
+//
+stat_t cm_straight_probe(float target[],uint32_t flags, uint8_t failure_is_error, uint8_t toward){
+	
+	if(cm.gm.feedrate_mode == INVERSE_TIME_MODE){
+		return STAT_PROBE_INVERSE_TIME_FEEDRATE;
+	}
+	
+	if ((cm.gm.feedrate_mode != INVERSE_TIME_MODE) && (fp_ZERO(cm.gm.feedrate))) {
+		return (STAT_GCODE_FEEDRATE_NOT_SPECIFIED);
+	}
+	
+	if((flags & GF_AXES_MASK) == 0)
+		return STAT_PROBE_ALL_AXES_OMITTED;
+	
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){	// set probe move endpoint, words not in the block are 0
+		pb.target[axis] = (flags & GF_BIT(axis))? target[axis] : 0;
+	}
+	pb.flags = flags & GF_AXES_MASK;		// set axes involved on the move
+	pb.failure_is_error = failure_is_error;
+	pb.contact = (toward)? SW_CLOSED : SW_OPEN;
+	clear_vector(cm.probe_results);		// clear the old probe position.
+										// NOTE: relying on probe_result will not detect a probe to 0,0,0.
+
+	cm.probe_state = PROBE_WAITING;		// wait until planner queue empties before completing initialization
+	pb.func = _probing_init; 			// bind probing initialization function
+	return (STAT_OK);
+}
+
+stat_t cm_probe_callback(void)
+{
+	if ((cm.cycle_state != CYCLE_PROBE) && (cm.probe_state != PROBE_WAITING)) {
+		return (STAT_NOOP);				// exit if not in a probe cycle or waiting for one
+	}
+	if (cm_get_runtime_busy() == true) { return (STAT_RC);}	// sync to planner move ends
+	return (pb.func());                                         // execute the current homing move
+}
+
+
+static stat_t _probing_init(void){
+	cm.cycle_state = CYCLE_PROBE;
+	cm.probe_state = PROBE_FAILED;
+	
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		pb.saved_jerk[axis] = cm_get_axis_jerk(axis);
+		pb.start_position[axis] = cm_get_absolute_position(ACTIVE_MODEL, axis);
+		cm_set_axis_jerk(axis,cm.a[axis].homing_jerk);
+	}
+	
+	if(get_vector_length(pb.target,pb.start_position) < MINIMUM_PROBE_DISTANCE){
+		return _probing_error_exit(STAT_MINIMUM_PROBE_DISTANCE);
+	}
+	
+	pb.saved_coordinate = cm_get_coordinate_system(ACTIVE_MODEL);
+	pb.saved_distance_mode = cm_get_distance_mode(ACTIVE_MODEL);
+	cm_select_distance_mode(ABSOLUTE_MODE);
+	cm_set_coord_system(ABSOLUTE_COORDS);
+
+	//cm_spindle_control(SPINDLE_OFF);
+	return (_set_pb_function(_probing_start));							// start the move
+}
+
+static stat_t _probing_start(void){
+	pb.latched = false;
+	if(get_probe_state() != pb.contact){
+		probe_capture_arm();
+		uint8_t status = cm_straight_feed(pb.target,pb.flags);
+		if(status != STAT_OK) return _probing_error_exit(status);
+	}
+	return (_set_pb_function(_probing_finish));
+}
+
+//cm_probe_latch//
+//input : none
+//output : none
+//fuction : latches the step counts of the motors when the probe makes (or loses) contact
+//notes : PROBE CAPTURE INTERRUPT ONLY, the capture is armed for both edges so a bounce of the
+//other edge is ignored. the counts include the steps already run in the current segment
+//additions: 
+//
+void cm_probe_latch(void){
+	if(get_probe_state() != pb.contact) return;
+	probe_capture_disarm();
+	for(uint8_t motor=0; motor<MOTORS; ++motor){
+		pb.latched_steps[motor] = en.en[motor].encoder_position + en.en[motor].encoder_run;
+	}
+	pb.latched = true;
+}
+
+static stat_t _probing_finish(void){
+	uint8_t contact = pb.latched || (get_probe_state() == pb.contact);
+	cm.probe_state = (contact)? PROBE_SUCCEEDED:PROBE_FAILED;
+	for( uint8_t axis=0; axis<AXES; axis++ ) {
+		// if we got here because of a limit switch being hit we need to keep the model position correct
+		cm_set_position(axis, mp_get_runtime_work_position(axis));
+
+		// store the probe results
+		cm.probe_results[axis] = cm_get_absolute_position(ACTIVE_MODEL, axis);
+	}
+	if(pb.latched){
+		_probe_latched_position(cm.probe_results);	// where the probe tripped, not where it stopped
+	}
+	if(!contact && pb.failure_is_error){
+		return _probing_error_exit(STAT_PROBE_CYCLE_FAILED);
+	}
+	return (_set_pb_function(_probing_finalize));
+}
+
+//_probe_latched_position//
+//input : machine position of the axes
+//output : none
+//fuction : converts the latched step counts to the position of the axes driven by motors
+//notes : 
+//additions: 
+//
+static void _probe_latched_position(float position[]){
+	kn_forward_kinematics(pb.latched_steps,position);
+}
+
+
+static stat_t _probing_finalize(void){
+	_probe_restore_settings();
+	return STAT_OK;
+}
+
+static stat_t _probing_error_exit(stat_t status){
+	_probe_restore_settings();
+	return status;
+}
+
+static void	_probe_restore_settings(void){
+	
+	probe_capture_disarm();
+	mp_flush_planner();
+	
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		cm_set_axis_jerk(axis,pb.saved_jerk[axis]);
+	}
+	cm_select_distance_mode(pb.saved_distance_mode);
+	cm_set_coord_system(pb.saved_coordinate);
+	cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
+	//cm_cycle_end();
+	cm.cycle_state = CYCLE_OFF;
+}
+
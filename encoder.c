@@ -1,18 +1,71 @@
-
-#include <stdint.h>
-#include <string.h>
-#include <math.h>
-#include "system.h"
-#include "encoder.h"
-
-Encoders_t en;
-
-void encoder_init(void)
-{
-	memset(&en, 0, sizeof(en));		// clear all values, pointers and status
-}
-
-void en_set_encoder_steps(uint8_t motor, float steps)
-{
-	en.en[motor].encoder_position = (int32_t)roundf(steps);
-}
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "encoder.h"
+#include "debugging.h"
+#include "HAL.h"
+
+MACHINE_LOCAL Encoders_t en;
+
+static void _en_zero_feedback(void);
+
+void encoder_init(void)
+{
+	memset(&en, 0, sizeof(en));		// clear all values, pointers and status
+	en.fb.motor = EN_FEEDBACK_MOTOR;
+	en.fb.steps_per_count = EN_STEPS_PER_COUNT;
+	en.fb.limit = EN_FOLLOWING_ERROR_LIMIT;
+	_en_zero_feedback();
+}
+
+void en_set_encoder_steps(uint8_t motor, float steps)
+{
+	en.en[motor].encoder_position = (int32_t)roundf(steps);
+	if(motor == en.fb.motor){
+		_en_zero_feedback();
+	}
+}
+
+void en_set_following_error_limit(float limit){en.fb.limit = limit;}
+
+//_en_zero_feedback//
+//input : none
+//output : none
+//fuction : takes the current encoder count as the current commanded position
+//notes : the commanded position is set when the machine is homed or zeroed, so is the measured one
+//additions: 
+//
+static void _en_zero_feedback(void){
+#if defined(__ENCODER_FEEDBACK)
+	en.fb.zero_steps = en.en[en.fb.motor].encoder_position;
+	en.fb.zero_count = qei_read_position();
+	en.fb.following_error = 0;
+#endif
+}
+
+//en_check_following_error//
+//input : none
+//output : none
+//fuction : compares the commanded and the measured steps of the feedback motor
+//notes : called at every segment load (loader interrupt). the commanded steps include the steps
+//already run in the current segment so the error is only the lag of the motor behind the pulses
+//additions: 
+//
+void en_check_following_error(void){
+	db_start_session(FOLLOWING_ERROR_TIME);
+	Encoder_t *e = &en.en[en.fb.motor];
+	int32_t counts = (int32_t)(qei_read_position() - en.fb.zero_count);
+	int32_t commanded = e->encoder_position + e->encoder_run - en.fb.zero_steps;
+	en.fb.following_error = (float)commanded - (float)counts*en.fb.steps_per_count;
+	float magnitude = fabsf(en.fb.following_error);
+	if(magnitude > en.fb.max_following_error){
+		en.fb.max_following_error = magnitude;
+	}
+	if((en.fb.limit > 0) && (magnitude > en.fb.limit)){
+		en.fb.alarm = true;
+	}
+	db_end_session(FOLLOWING_ERROR_TIME);
+}
@@ -1,57 +1,90 @@
-//this is for debugging purposes 
-
-#ifndef ENCODER_H
-#define ENCODER_H
-
-#ifndef INLINE
-#define INLINE extern inline
-#endif
-
-typedef struct encoder{
-	int32_t encoder_position; //position of virtual encoder
-	int16_t encoder_run;		//steps run per segment
-	int8_t encoder_sign;		//direction of encoder
-	//has 1 char that won't affect size
-}Encoder_t;
-
-
-typedef struct encoders{
-	Encoder_t en[MOTORS];
-}Encoders_t;
-
-extern Encoders_t en;
-
-#define EN_SET_STEP_SIGN(motor,sign) en.en[motor].encoder_sign = sign
-#define EN_INCREMENT(motor) en.en[motor].encoder_run += en.en[motor].encoder_sign
-#define EN_ACCUMULATE(motor) en.en[motor].encoder_position += en.en[motor].encoder_run; en.en[motor].encoder_run = 0
-
-
-INLINE void en_set_step_sign(uint8_t motor, int8_t sign) __attribute__((always_inline));
-INLINE void en_increment(uint8_t motor) __attribute__((always_inline));
-INLINE void en_accumulate(uint8_t motor) __attribute__((always_inline));
-INLINE int32_t en_read_encoder(uint8_t motor) __attribute__((always_inline));
-void encoder_init(void);
-void en_set_encoder_steps(uint8_t motor, float steps);
-
-inline void en_set_step_sign(uint8_t motor, int8_t sign){
-	en.en[motor].encoder_sign = sign;
-}
-
-inline void en_increment(uint8_t motor){
-	en.en[motor].encoder_run += en.en[motor].encoder_sign;
-}
-
-inline void en_accumulate(uint8_t motor){
-	en.en[motor].encoder_position += en.en[motor].encoder_run;
-	en.en[motor].encoder_run = 0;
-}
-
-inline int32_t en_read_encoder(uint8_t motor){
-	return en.en[motor].encoder_position;
-}
-
-
-
-
-#endif
-
+//this is for debugging purposes 
+
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include "config.h"
+
+#ifndef INLINE
+#define INLINE extern inline
+#endif
+
+/*
+	the virtual encoders count the commanded steps. with __ENCODER_FEEDBACK defined (project
+	preprocessor symbols, like __STEPPER) one motor is also followed by a real quadrature encoder
+	on QEI0, at every segment load its commanded steps are compared with the measured ones and
+	a following error over the limit raises an alarm through the controller.
+*/
+
+#define EN_FEEDBACK_MOTOR MOTOR_1				//motor followed by the quadrature encoder
+#define EN_STEPS_PER_COUNT 0.8f					//3200 microsteps/rev, 1000 lines/rev decoded x4
+#define EN_FOLLOWING_ERROR_LIMIT 32.0f	//steps (2 full steps at 16 microsteps), 0 disables the alarm
+
+typedef struct encoder{
+	int32_t encoder_position; //position of virtual encoder
+	int16_t encoder_run;		//steps run per segment
+	int8_t encoder_sign;		//direction of encoder
+	//has 1 char that won't affect size
+}Encoder_t;
+
+
+typedef struct encoderFeedback{
+	uint8_t motor;							//motor followed by the quadrature encoder
+	volatile uint8_t alarm;			//set at the segment load, raised by the controller
+	float steps_per_count;
+	float limit;								//following error alarm threshold, steps
+	float following_error;			//commanded - measured steps at the last segment load
+	float max_following_error;	//largest magnitude seen
+	int32_t zero_steps;					//commanded steps when the count was taken as zero
+	uint32_t zero_count;
+}EncoderFeedback_t;
+
+typedef struct encoders{
+	Encoder_t en[MOTORS];
+	EncoderFeedback_t fb;
+}Encoders_t;
+
+extern MACHINE_LOCAL Encoders_t en;
+
+#define EN_SET_STEP_SIGN(motor,sign) en.en[motor].encoder_sign = sign
+#define EN_INCREMENT(motor) en.en[motor].encoder_run += en.en[motor].encoder_sign
+#define EN_ACCUMULATE(motor) en.en[motor].encoder_position += en.en[motor].encoder_run; en.en[motor].encoder_run = 0
+
+
+INLINE void en_set_step_sign(uint8_t motor, int8_t sign) __attribute__((always_inline));
+INLINE void en_increment(uint8_t motor) __attribute__((always_inline));
+INLINE void en_accumulate(uint8_t motor) __attribute__((always_inline));
+INLINE int32_t en_read_encoder(uint8_t motor) __attribute__((always_inline));
+void encoder_init(void);
+void en_set_encoder_steps(uint8_t motor, float steps);
+void en_set_following_error_limit(float limit);
+void en_check_following_error(void);
+
+#if defined(__ENCODER_FEEDBACK)
+#define EN_CHECK_FOLLOWING_ERROR() en_check_following_error()
+#else
+#define EN_CHECK_FOLLOWING_ERROR()
+#endif
+
+inline void en_set_step_sign(uint8_t motor, int8_t sign){
+	en.en[motor].encoder_sign = sign;
+}
+
+inline void en_increment(uint8_t motor){
+	en.en[motor].encoder_run += en.en[motor].encoder_sign;
+}
+
+inline void en_accumulate(uint8_t motor){
+	en.en[motor].encoder_position += en.en[motor].encoder_run;
+	en.en[motor].encoder_run = 0;
+}
+
+inline int32_t en_read_encoder(uint8_t motor){
+	return en.en[motor].encoder_position;
+}
+
+
+
+
+#endif
+
@@ -0,0 +1,152 @@
+/*
+ * events.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * controller loop events, see events.h
+ *
+ * a pass of the loop is
+ *
+ *	  events = ev_take()  ->  tasks of the taken events  ->  ev_wait()
+ *
+ *	a task that returns STAT_RC ends the pass and its events are deferred, they join the next
+ *	taken ones but don't keep the loop awake, the task waits for something new to be posted.
+ *	a task that returns STAT_OK did some work and may have more, it posts its event again.
+ *
+ *	the tick doesn't wake the loop every ms. a task that has to run at a time asks for EV_TICK
+ *	then with ev_tick_in, the deferred events ask for the next ms, and the tick interrupt is
+ *	masked while no post is due and no dwell counts down.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "system.h"
+#include "events.h"
+#include "HAL.h"
+
+void DisableInterrupts(void);
+void EnableInterrupts(void);
+void WaitForInterrupt(void);
+
+MACHINE_LOCAL evScheduler_t ev;
+
+//ev_init//
+//input : none
+//output : none
+//fuction : clears the events and posts the command reader so the loop starts reading
+//notes : EV_TICK is posted too, the reports ask for their next ones from it
+//additions:
+//
+void ev_init(void){
+	memset(&ev,0,sizeof(ev));
+	for(uint8_t event=0; event<EV_EVENTS; ++event){
+		ev.latency[event].event_min_time = 0xFFFFFFFF;
+	}
+	ev_post(EV_COMMAND);
+	ev_post(EV_TICK);
+}
+
+//ev_take//
+//input : none
+//output : events to dispatch on this pass
+//fuction : takes the posted events with the deferred ones and times the posted ones
+//notes :
+//additions:
+//
+uint32_t ev_take(void){
+	uint32_t now = WTIMER0_TAV_R;
+	long sr = StartCritical();
+	uint32_t events = ev.pending;
+	ev.pending = 0;
+	for(uint8_t event=0; event<EV_EVENTS; ++event){
+		if(events & EV_BIT(event)){
+			dbEvent_t *l = &ev.latency[event];
+			l->event_time = now - ev.posted[event];
+			l->event_max_time = maxl(l->event_time,l->event_max_time);
+			l->event_min_time = minl(l->event_time,l->event_min_time);
+			l->event_recalls++;
+		}
+	}
+	EndCritical(sr);
+	events |= ev.deferred;
+	ev.deferred = 0;
+	return events;
+}
+
+void ev_defer(uint32_t events){
+	ev.deferred |= events;
+	ev_tick_in(1);								//they run again on the next tick at the latest
+}
+
+//ev_tick_in//
+//input : ms from now
+//output : none
+//fuction : posts EV_TICK after ms, or keeps an earlier one already due
+//notes : any priority
+//additions:
+//
+void ev_tick_in(uint32_t ms){
+	if(ms == 0){ms = 1;}
+	long sr = StartCritical();
+	if((ev.tick_wait == 0) || (ms < ev.tick_wait)){ev.tick_wait = ms;}
+	ev_tick_wake();
+	EndCritical(sr);
+}
+
+//ev_tick_wake//
+//input : none
+//output : none
+//fuction : unmasks the tick interrupt for a dwell or a due EV_TICK
+//notes : any priority
+//additions:
+//
+void ev_tick_wake(void){
+	long sr = StartCritical();
+	ev.tick_woken = true;
+	tick_wake();
+	EndCritical(sr);
+}
+
+//ev_tick//
+//input : true while the caller still needs the tick, a running dwell
+//output : none
+//fuction : counts the due EV_TICK down and posts it on its last ms, masks the tick interrupt
+//when nothing needs it
+//notes : ONLY THE TICK INTERRUPT CAN INVOKE THIS FUNCTION. a wake from a higher priority after
+//the caller looked at its dwell keeps it awake one more ms, it looks again then
+//additions:
+//
+void ev_tick(uint8_t busy){
+	long sr = StartCritical();
+	if((ev.tick_wait != 0) && (--ev.tick_wait == 0)){
+		ev_post(EV_TICK);
+	}
+	if((busy == false) && (ev.tick_wait == 0) && (ev.tick_woken == false)){
+		tick_sleep();
+	}
+	ev.tick_woken = false;
+	EndCritical(sr);
+}
+
+//ev_wait//
+//input : none
+//output : none
+//fuction : sleeps until an interrupt if nothing is posted
+//notes : the check and the WFI run with the interrupts masked so a post can't slip in
+//between them, a masked interrupt still wakes the core and runs once they're enabled
+//additions:
+//
+void ev_wait(void){
+	DisableInterrupts();
+	if(ev.pending == 0){
+		ev.sleeps++;
+		WaitForInterrupt();
+	}
+	EnableInterrupts();
+}
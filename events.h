@@ -0,0 +1,84 @@
+// events.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	event flags of the controller loop. the interrupts and the tasks post events, the loop takes
+	the posted ones, runs only the tasks waiting on them and sleeps (WFI) when nothing is posted,
+	so a task runs when something it waits on changed instead of on every pass.
+	  - EV_TICK, the 1ms tick (WTIMER1A), reports. posted only when one is due, ev_tick_in, or a
+	    task was deferred. the tick interrupt sleeps while nothing is due and no dwell runs
+	  - EV_PLANNER, the runtime moved (exec and load interrupts) or a block was queued, the
+	    cycles and the command reader
+	  - EV_COMMAND, a line was received (UART0), see protocol.h
+	  - EV_FLIGHT_DUMP, the flight recorder dump was requested
+	the alarm flags (limits, following error) are checked on every wake and need no event.
+	the time from the first post of an event to its dispatch is kept in ev.latency, read it
+	with the debugger like the db events.
+*/
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#ifndef HOST_BUILD
+#include "tm4c123gh6pm.h"
+#endif
+#include "config.h"
+#include "debugging.h"
+
+#ifndef INLINE
+#define INLINE extern inline
+#endif
+
+enum evEvents{
+	EV_TICK = 0,
+	EV_PLANNER,
+	EV_COMMAND,
+	EV_FLIGHT_DUMP,
+	EV_EVENTS
+};
+
+#define EV_BIT(event) ((uint32_t)1 << (event))
+
+typedef struct evScheduler{
+	volatile uint32_t pending;			//posted and not taken yet
+	uint32_t deferred;							//taken by a pass that a task cut short, run on the next wake
+	volatile uint32_t tick_wait;		//ms until EV_TICK is posted, 0 with none due
+	volatile uint8_t tick_woken;		//woken since the tick last looked
+	uint32_t posted[EV_EVENTS];		//debug timer at the first post
+	dbEvent_t latency[EV_EVENTS];	//post to dispatch, debug timer ticks
+	uint32_t sleeps;
+}evScheduler_t;
+
+extern MACHINE_LOCAL evScheduler_t ev;
+
+long StartCritical(void);
+void EndCritical(long sr);
+
+void ev_init(void);
+uint32_t ev_take(void);
+void ev_defer(uint32_t events);
+void ev_wait(void);
+void ev_tick_in(uint32_t ms);
+void ev_tick_wake(void);
+void ev_tick(uint8_t busy);
+INLINE void ev_post(uint8_t event) __attribute__((always_inline));
+
+//ev_post//
+//input : event
+//output : none
+//fuction : marks the event posted and wakes the loop
+//notes : any priority. only the first post before the loop takes the event is timed
+//additions:
+//
+inline void ev_post(uint8_t event){
+	long sr = StartCritical();
+	if((ev.pending & EV_BIT(event)) == 0){
+		ev.posted[event] = WTIMER0_TAV_R;
+		ev.pending |= EV_BIT(event);
+	}
+	EndCritical(sr);
+}
+
+#endif
@@ -0,0 +1,77 @@
+// fastmath.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	single precision kernels for the planner, in place of the libm paths (cbrtf goes through
+	frexp and a division per step). both start from an exponent/mantissa guess made on the
+	float bits and refine it with Newton steps that only multiply, so they cost a handful of
+	FPU multiplies and one integer divide at most.
+	  - fast_cbrtf, refines x^(-1/3) then cbrt = x*r*r. max relative error 4.87e-7 over the
+	    normal floats, zero and the sign are kept
+	  - fast_rsqrtf, refines x^(-1/2). max relative error 4.74e-6 over the normal floats, x > 0
+	square roots themselves stay on _sqrtf, the M4F does them in one VSQRT.
+	the errors are over every normal float against the double precision libm on the host, the
+	host bench sweep samples every BENCH_SWEEP_STEP-th one. there are no reference timings, the
+	bench reports the cost against cbrtf and 1/sqrtf of the build it runs.
+*/
+
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#ifndef INLINE
+#define INLINE extern inline
+#endif
+
+#define FM_CBRT_MAGIC 0x54A23000			//x^(-1/3) guess, 3% before refinement
+#define FM_RSQRT_MAGIC 0x5F375A86			//x^(-1/2) guess, 3.5% before refinement
+
+typedef union fmBits{
+	float f;
+	uint32_t i;
+}fmBits_t;
+
+INLINE float fast_cbrtf(float x) __attribute__((always_inline));
+INLINE float fast_rsqrtf(float x) __attribute__((always_inline));
+
+//fast_cbrtf//
+//input : x
+//output : cube root of x
+//fuction :
+//notes : three Newton steps on r = x^(-1/3), r = r*(4 - x*r^3)/3, each one squares the error
+//additions:
+//
+inline float fast_cbrtf(float x){
+	fmBits_t u = {x};
+	uint32_t sign = u.i & 0x80000000;
+	u.i &= 0x7FFFFFFF;
+	if(u.i == 0) return x;
+	float a = u.f;
+	u.i = FM_CBRT_MAGIC - u.i/3;
+	float r = u.f;
+	r = r*(1.33333333f - 0.33333333f*a*r*r*r);
+	r = r*(1.33333333f - 0.33333333f*a*r*r*r);
+	r = r*(1.33333333f - 0.33333333f*a*r*r*r);
+	u.f = a*r*r;
+	u.i |= sign;
+	return u.f;
+}
+
+//fast_rsqrtf//
+//input : x > 0
+//output : 1/sqrt(x)
+//fuction :
+//notes : two Newton steps on r = x^(-1/2), r = r*(3 - x*r^2)/2
+//additions:
+//
+inline float fast_rsqrtf(float x){
+	fmBits_t u = {x};
+	u.i = FM_RSQRT_MAGIC - (u.i >> 1);
+	float r = u.f;
+	r = r*(1.5f - 0.5f*x*r*r);
+	r = r*(1.5f - 0.5f*x*r*r);
+	return r;
+}
+
+#endif
@@ -1,426 +1,713 @@
-/*
- * gcode_parser.c
- * This file is part of the X project
- *
- * Omar Emad El-Deen
- * Yossef Mohammed Hassanin
- * Mars, 2018
- */
-/*
- * this code is an implementation of g-code interpreter based on Kramer, Proctor and Messina's
- * interpreter as described in the NIST RS274/NGC v3
- *
- * g-code interpreter is the first layer of the controller it interprets the incoming g-code from recevied 
- * from a the main controller into a set of machine states.
- * the interpretation process is as follows:
- * 1- normalization of the g-code block : the block is changed into all caps form, all the white spaces are removed,
- * deleting leading zeros and signal a block delete if provided
- * 2- parsing : in the parsing process a set of functions are invoked to change the transational cononical machine inputs based
- * on the normalized block 
- * 3- execution : the execution follows the order of execution as provided by NIST RS274NGC, a set of functions are invoked
- * to alter the canonical machine state and start the planning process of coordinated motion
- */
-
-
-//*******includes*******//
-#include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-#include <stdbool.h>
-#include <math.h>
-#include "system.h"
-#include "canonical.h"
-#include "debugging.h"
-/////////////////////////
-
-//******Prototypes******//
-static void _normalize_gcode_block(char *str, uint8_t *d_flag);
-static stat_t _parse_gcode_block(char *block);
-static stat_t _execute_gcode_block(void);
-//////////////////////////
-
-
-//******Globals********//
-struct gcodeparseSingleton{
-	uint8_t MODAL[MODAL_GROUP_M8+1];
-};
-
-struct gcodeparseSingleton gc; //will be used for G-code validation
-/////////////////////////
-
-
-//gc_gcode_parser//
-//input : a gcode block in the form of string
-//output : state based on the execution of the process
-//fuction : interpretes a gcode block into a machine state or a coordinated motion
-//notes : ONLY THE MAIN CONTROLLER CAN INVOKE THIS FUNCTION
-//additions: if the machine is alarmed don't process the following g code
-//
-stat_t gc_gcode_parser(char *block){
-		
-	char *block_cpy = block;
-	uint8_t block_delete_flag;
-	db_start_session(BLOCK_PREPARE_TIME);
-	db_start_session(GCODE_PARSER_TIME);
-	if(cm.machine_state == MACHINE_ALARM){return STAT_MACHINE_ALARMED;}
-	
-	_normalize_gcode_block(block_cpy, &block_delete_flag);
-	
-	//if the block delete flag is on which is a / in the first space 
-	//ignor the block and return
-	if (block_delete_flag == true) {
-		return (STAT_NOOP);
-	}
-	return (_parse_gcode_block(block));
-}
-
-//_normalize_gcode_block//
-//input : a gcode block in the form of string
-//output : none
-//fuction : normalize the g-code block
-//the block is changed into all caps form, all the white spaces are removed,
-//deleting leading zeros and signal a block delete if provided
-//notes : ONLY ACCESSED BY gc_gcode_parser
-//additions: 
-//
-static void _normalize_gcode_block(char *str, uint8_t *d_flag){
-
-	char *read_p = str;
-	char *write_p = str;
-	
-//signaling block delete flag
-	if(*read_p == '/'){
-	*d_flag = true;
-	return;// why would you actually continue .. u will ignor the block
-	}
-	else{*d_flag = false;}
-	
-//deleting invalid charachters and whitespaces by ignoring them while changing the block into upper case
-	for(; *write_p != NUL; read_p++){
-		if(*read_p == NUL) *write_p = NUL;
-		else if(isalnum(*read_p)||strchr(".-",*read_p)){
-			*(write_p++) = (char)toupper(*read_p);
-		}
-	}
-//deleting leading zeros
-	read_p = str;
-	while(*read_p != NUL){
-		if(*read_p == '.'){
-			read_p++;
-			continue;
-		}
-		else if((!isdigit(*read_p))&&(*(read_p+1) == '0')&&(isdigit(*(read_p+2)))){
-			write_p = read_p+1;
-			while(*write_p != NUL){
-				*write_p = *(write_p+1);
-				write_p++;
-			}
-			continue;
-		}
-		read_p++;
-	}
-}
-
-//_get_next_code_word//
-//input : pointers to a char, float and an array of charachters
-//output : state based on the word interpretation
-//fuction : interpretes a word "N,M,G,X,Y,...." 
-//notes : 
-//additions: 
-//
-static stat_t _get_next_code_word(char **strp, char *letter, float *value){
-	char *end;
-	if(**strp == NUL){
-		return STAT_COMPLETE;
-	}
-	if(islower(**strp)){
-		return STAT_INVALID_CODE_FORM;
-	}
-	
-	*letter = **strp;
-	(*strp)++;
-	//special case when G0 is followed by X-axis word e.g G0X20 the normal get value routine
-	//will treat 0x20 as a hex decimal value and return 32
-	if((**strp == '0')&&(*(*strp+1) == 'X')){
-		*value = 0;
-		(*strp)++;
-		return STAT_OK;
-	}
-	// get value from string 
-	*value = strtof(*strp,&end);
-	if(*strp == end){
-		//no conversion has been done
-		return STAT_INVALID_NUMBER_FORM;
-	}
-	*strp = end;
-	return STAT_OK;
-}
-
-//_point//
-//input : a float value
-//output : the point value "G60.1  ---> point value 1"
-//fuction : returns the point value
-//notes : 
-//additions: 
-//
-static uint8_t _point(float value){
-	return (uint8_t)(((value*10)-(truncf(value)*10))+0.5f);
-}
-
-
-
-#define SET_MODAL(m,param,val) {cm.gn.param = val; cm.gf.param = 1; gc.MODAL[m]++; break;}
-#define SET_NON_MODAL(param,val) {cm.gn.param = val; cm.gf.param = 1; break;}
-
-//_parse_gcode_block//
-//input : normalized gcode block in the form of string
-//output : state based on the execution of parsing
-//fuction : invokes SET_MODAL and SET_NON_MODAL to set the cannonical machine gcode values and flags 
-//notes : 
-//additions: 
-//
-static stat_t _parse_gcode_block(char *block){
-	char* strp = block;
-	char letter;
-	float value = 0;
-	stat_t status = STAT_OK;
-	
-	memset(&gc,0,sizeof(gc));
-	memset(&cm.gf,0,sizeof(GIn_t));
-	memset(&cm.gn,0,sizeof(GIn_t));
-	cm.gn.motion_mode = cm_get_motion_mode(&cm.gm);
-	
-	while((status = _get_next_code_word(&strp,&letter,&value)) == STAT_OK){
-		switch(letter){
-			case 'N': SET_NON_MODAL(linenum,(uint32_t)value);
-			case 'G':{
-				switch((uint8_t)value){
-					case 0: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_STRAIGHT_TRAVERSE);
-					case 1: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_STRAIGHT_FEED);
-					case 2: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CW_ARC);
-					case 3: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CCW_ARC);
-					case 4: SET_NON_MODAL(next_action,ACTION_DWELL);
-					case 10: SET_MODAL(MODAL_GROUP_G0,next_action,ACTION_SET_COORD_DATA);
-					case 17: SET_MODAL(MODAL_GROUP_G2,plane_select,XY_PLANE);
-					case 18: SET_MODAL(MODAL_GROUP_G2,plane_select,XZ_PLANE);
-					case 19: SET_MODAL(MODAL_GROUP_G2,plane_select,YZ_PLANE);
-					case 20: SET_MODAL(MODAL_GROUP_G6,units_mode,INCHES);
-					case 21: SET_MODAL(MODAL_GROUP_G6,units_mode,MILLIMETERS);
-					case 28: {
-						switch(_point(value)){
-							case 0: SET_MODAL (MODAL_GROUP_G0, next_action, ACTION_GOTO_G28_POSITION);
-							case 1: SET_MODAL (MODAL_GROUP_G0, next_action, ACTION_SET_G28_POSITION);
-							case 2: SET_NON_MODAL (next_action, ACTION_SEARCH_HOME);
-							case 3: SET_NON_MODAL (next_action, ACTION_SET_ABSOLUTE_ORIGIN);
-							case 4: SET_NON_MODAL (next_action, ACTION_HOMING_NO_SET);
-							default: status = STAT_UNSUPPORTED_GCODE;
-						}
-						break;
-					}
-					case 30: {
-						switch (_point(value)) {
-							case 0: SET_MODAL (MODAL_GROUP_G0, next_action, ACTION_GOTO_G30_POSITION);
-							case 1: SET_MODAL (MODAL_GROUP_G0, next_action, ACTION_SET_G30_POSITION);
-							default: status = STAT_UNSUPPORTED_GCODE;
-						}
-						break;
-					}
-					case 38: {
-						switch (_point(value)) {
-							case 2: SET_NON_MODAL (next_action, ACTION_STRAIGHT_PROBE);
-							default: status = STAT_UNSUPPORTED_GCODE;
-						}
-						break;
-					}
-					//case 40
-					//case 41
-					//case 42
-					//case 43
-					//case 49
-					case 53: SET_NON_MODAL(absolute_override,true);
-					case 54: SET_MODAL(MODAL_GROUP_G12,coordinate_system,G54);
-					case 55: SET_MODAL(MODAL_GROUP_G12,coordinate_system,G55);
-					case 56: SET_MODAL(MODAL_GROUP_G12,coordinate_system,G56);
-					case 57: SET_MODAL(MODAL_GROUP_G12,coordinate_system,G57);
-					case 58: SET_MODAL(MODAL_GROUP_G12,coordinate_system,G58);
-					case 59: SET_MODAL(MODAL_GROUP_G12,coordinate_system,G59);
-					case 60:{ 
-						switch(_point(value)){
-							case 0: SET_MODAL(MODAL_GROUP_G13,path_control,PATH_EXACT_PATH);
-							case 1: SET_MODAL(MODAL_GROUP_G13,path_control,PATH_EXACT_STOP);
-							default: status = STAT_UNSUPPORTED_GCODE;
-						}
-						break;
-					}
-					case 80: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANCEL_MOTION_MODE);
-					case 81: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_81);
-					case 82: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_82);
-					case 83: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_83);
-					case 84: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_84);
-					case 85: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_85);
-					case 86: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_86);
-					case 87: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_87);
-					case 88: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_88);
-					case 89: SET_MODAL(MODAL_GROUP_G1,motion_mode,MOTION_MODE_CANNED_89);
-					case 90: SET_MODAL(MODAL_GROUP_G3,distance_mode,ABSOLUTE_MODE);
-					case 91: SET_MODAL(MODAL_GROUP_G3,distance_mode,INCREMENTAL_MODE);
-					case 92:{
-						switch(_point(value)){
-							case 0: SET_MODAL(MODAL_GROUP_G0,next_action,ACTION_SET_AXIS_OFFSETS);
-							case 1: SET_NON_MODAL(next_action,ACTION_RESET_AXIS_OFFSETS);
-							case 2: SET_NON_MODAL(next_action,ACTION_SUSPEND_AXIS_OFFSETS);
-							case 3: SET_NON_MODAL(next_action,ACTION_RESUME_AXIS_OFFSETS);
-						}
-						break;
-					}
-					case 93: SET_MODAL(MODAL_GROUP_G5,feedrate_mode,INVERSE_TIME_MODE);
-					case 94: SET_MODAL(MODAL_GROUP_G5,feedrate_mode,UNITS_PER_MINUTE_MODE);
-					//case 98
-					//case 99
-					default: status = STAT_UNSUPPORTED_GCODE;
-				}
-				break;
-			}
-			case 'M':{
-				switch((uint8_t)value){
-					case 0: SET_MODAL(MODAL_GROUP_M4,programflow,PROGRAM_STOP);
-					case 1: SET_MODAL(MODAL_GROUP_M4,programflow,PROGRAM_STOP);
-					case 2: SET_MODAL(MODAL_GROUP_M4,programflow,PROGRAM_END);
-					case 3: SET_MODAL(MODAL_GROUP_M7,spindle_mode,SPINDLE_CW);
-					case 4: SET_MODAL(MODAL_GROUP_M7,spindle_mode,SPINDLE_CCW);
-					case 5: SET_MODAL(MODAL_GROUP_M7,spindle_mode,SPINDLE_OFF);
-					case 6: SET_MODAL(MODAL_GROUP_M6,tool_change,true);
-					case 7: SET_MODAL(MODAL_GROUP_M8,mist_coolant,true);
-					case 8:	SET_MODAL(MODAL_GROUP_M8,flood_coolant,true);
-					case 9: SET_MODAL(MODAL_GROUP_M8,coolant_off,true);
-					case 30: SET_MODAL(MODAL_GROUP_M4,programflow,PROGRAM_END);
-					//case 48:
-					//case 49:
-					default: status = STAT_UNSUPPORTED_MCODE;
-				}
-				break;
-			}
-			case 'X': SET_NON_MODAL(target[X_AXIS],value);
-			case 'Y': SET_NON_MODAL(target[Y_AXIS],value);
-			case 'Z': SET_NON_MODAL(target[Z_AXIS],value);
-			case 'I': SET_NON_MODAL(center_offsets[0],value);
-			case 'J': SET_NON_MODAL(center_offsets[1],value);
-			case 'K': SET_NON_MODAL(center_offsets[2],value);
-			case 'F': SET_NON_MODAL(feedrate,value);
-			case 'S': SET_NON_MODAL(spindle_speed,value);
-			case 'R': SET_NON_MODAL(radius,value);
-			case 'P': SET_NON_MODAL(parameter,value);
-			case 'T': SET_NON_MODAL(tool_select,(uint8_t)(value+0.5f));
-			case 'L': break;
-			default: status = STAT_UNSUPPORTED_GCODE;
-				
-		}
-		if(status != STAT_OK) break;
-	}
-	if(status != STAT_OK && status != STAT_COMPLETE) return status;
-	//validation of modals 
-	return _execute_gcode_block();
-}
-
-
-//_execute_gcode_block//
-//input : none
-//output : state based on the execution of the execution process ^^
-//fuction : invokes EXEC_FUNC and cannonical machine function to set the gcode model of the cannonical machine
-// and starts the palanning of coordinated motions and dwells
-//notes : 
-//additions: 
-//
-/*
-order of execution as provided by NIST RS274NGC
-0.record line number //optional
-1. comment (includes message).
-2. set feed rate mode (G93, G94  inverse time or per minute).
-3. set feed rate (F).
-//override
-4. set spindle speed (S).
-//override
-5. select tool (T).
-6. change tool (M6).
-7. spindle on or off (M3, M4, M5).
-8. coolant on or off (M7, M8, M9).
-9. enable or disable overrides (M48, M49).
-10. dwell (G4).
-11. set active plane (G17, G18, G19).
-12. set length units (G20, G21).
-13. cutter radius compensation on or off (G40, G41, G42)
-14. cutter length compensation on or off (G43, G49)
-15. coordinate system selection (G54, G55, G56, G57, G58, G59, G59.1, G59.2, G59.3).
-16. set path control mode (G61, G61.1, G64)
-17. set distance mode (G90, G91).
-18. set retract mode (G98, G99).
-19. home (G28, G30) or
-change coordinate system data (G10) or
-set axis offsets (G92, G92.1, G92.2, G94).
-20. perform motion (G0 to G3, G80 to G89), as modified (possibly) by G53.
-21. stop (M0, M1, M2, M30, M60).
-*/
-#define EXEC_FUNC(f,v) if(((uint8_t)(cm.gf.v)) != false) { status = f(cm.gn.v);}
-static stat_t _execute_gcode_block(void){
-	stat_t status = STAT_OK;
-	cm_set_model_linenum(cm.gn.linenum);
-	EXEC_FUNC(cm_set_feed_rate_mode,feedrate_mode);
-	EXEC_FUNC(cm_set_feed_rate,feedrate);
-	//feed and traverse override factor 
-	//spindle speed
-	//spindle override enable and factor
-	//tool select T
-	//tool change M6
-	//spindle control
-	//coolant control
-	//overrides enable
-	if(cm.gn.next_action == ACTION_DWELL){
-		//dwell execution request
-	}
-	EXEC_FUNC(cm_select_plane,plane_select);
-	EXEC_FUNC(cm_select_unit_mode,units_mode);
-	//cutter radius compensation
-	//cutter length compensation
-	EXEC_FUNC(cm_set_coord_system,coordinate_system);
-	EXEC_FUNC(cm_select_path_control,path_control);
-	EXEC_FUNC(cm_select_distance_mode,distance_mode);
-	//retract mode
-	switch(cm.gn.next_action){
-		case ACTION_SET_COORD_DATA:{status = cm_set_coord_offsets(cm.gn.parameter,cm.gn.target,cm.gf.target); break;}
-		case ACTION_SET_AXIS_OFFSETS: {status = cm_set_origin_offsets(cm.gn.target,cm.gf.target); break;}
-		case ACTION_RESET_AXIS_OFFSETS: {status = cm_reset_origin_offsets(); break;}
-		case ACTION_SUSPEND_AXIS_OFFSETS: {status = cm_suspend_origin_offsets(); break;}
-		case ACTION_RESUME_AXIS_OFFSETS: {status = cm_resume_origin_offsets(); break;}
-		case ACTION_GOTO_G28_POSITION:
-		case ACTION_SET_G28_POSITION:
-		case ACTION_SEARCH_HOME:	{status = cm_cycle_homing_start(); break;}
-		case ACTION_SET_ABSOLUTE_ORIGIN:
-		case ACTION_HOMING_NO_SET:
-		case ACTION_GOTO_G30_POSITION:
-		case ACTION_SET_G30_POSITION:
-		case ACTION_STRAIGHT_PROBE:	{status = cm_straight_probe(cm.gn.target,cm.gf.target); break;}
-		case ACTION_DEFAULT: //it's a motion
-			cm_set_absolute_override(cm.gn.absolute_override);
-			db_end_session(GCODE_PARSER_TIME);
-			switch(cm.gn.motion_mode){
-				case MOTION_MODE_CANCEL_MOTION_MODE: {cm.gm.motion_mode = cm.gn.motion_mode; break;}
-				case MOTION_MODE_STRAIGHT_TRAVERSE:{status = cm_straight_traverse(cm.gn.target,cm.gf.target); break;}
-				case MOTION_MODE_STRAIGHT_FEED:{status = cm_straight_feed(cm.gn.target,cm.gf.target); break;}
-				case MOTION_MODE_CW_ARC : case MOTION_MODE_CCW_ARC :{
-					cm_arc_feed(cm.gn.target,cm.gf.target,cm.gn.center_offsets,cm.gn.radius);
-				}
-			}
-	}
-	cm_set_absolute_override(false);
-	if (cm.gf.programflow == true) {
-		if (cm.gn.programflow == PROGRAM_STOP) {
-			//cm_program_stop();
-		} else {
-			//cm_program_end();
-		}
-	}
-	db_end_session(BLOCK_PREPARE_TIME);
-	return status;
-}
-
+/*
+ * gcode_parser.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * this code is an implementation of g-code interpreter based on Kramer, Proctor and Messina's
+ * interpreter as described in the NIST RS274/NGC v3
+ *
+ * g-code interpreter is the first layer of the controller it interprets the incoming g-code from recevied 
+ * from a the main controller into a set of machine states.
+ * the interpretation process is as follows:
+ * 1- normalization of the g-code block : the block is changed into all caps form, all the white spaces are removed,
+ * deleting leading zeros and signal a block delete if provided
+ * 2- parsing : in the parsing process a set of functions are invoked to change the transational cononical machine inputs based
+ * on the normalized block 
+ * 3- execution : the execution follows the order of execution as provided by NIST RS274NGC, a set of functions are invoked
+ * to alter the canonical machine state and start the planning process of coordinated motion
+ */
+
+
+//*******includes*******//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "debugging.h"
+/////////////////////////
+
+//******Prototypes******//
+static void _normalize_gcode_block(char *str, uint8_t *d_flag);
+static stat_t _parse_gcode_block(char *block);
+static stat_t _execute_gcode_block(void);
+static stat_t _validate_gcode_block(void);
+static stat_t _parse_jog_block(char *block);
+//////////////////////////
+
+
+//******Globals********//
+struct gcodeparseSingleton{
+	uint16_t modal;				//MODAL_BIT of every modal group used in the block
+	uint8_t violation;		//a modal group was used twice
+	uint8_t cutter_comp_tool;	//G41 G42, D is a tool number and not a diameter
+};
+
+MACHINE_LOCAL struct gcodeparseSingleton gc; //will be used for G-code validation
+/////////////////////////
+
+
+//gc_gcode_parser//
+//input : a gcode block in the form of string
+//output : state based on the execution of the process
+//fuction : interpretes a gcode block into a machine state or a coordinated motion
+//notes : ONLY THE MAIN CONTROLLER CAN INVOKE THIS FUNCTION. STAT_RC when the M commands or the
+//dwell of the block don't fit the queue yet, the block changed nothing and is run again
+//additions: if the machine is alarmed don't process the following g code
+//
+stat_t gc_gcode_parser(char *block){
+		
+	char *block_cpy = block;
+	uint8_t block_delete_flag;
+	db_start_session(BLOCK_PREPARE_TIME);
+	db_start_session(GCODE_PARSER_TIME);
+	if(cm.machine_state == MACHINE_ALARM){return STAT_MACHINE_ALARMED;}
+	if((block[0] == '$') && (toupper((uint8_t)block[1]) == 'J')){	//jog command, not g-code
+		block_cpy = block+2;
+		_normalize_gcode_block(block_cpy, &block_delete_flag);
+		return (_parse_jog_block(block_cpy));
+	}
+	if(cm.cycle_state == CYCLE_JOG){return STAT_JOG_CONFLICT;}
+	
+	_normalize_gcode_block(block_cpy, &block_delete_flag);
+	
+	//if the block delete flag is on which is a / in the first space 
+	//ignor the block and return
+	if (block_delete_flag == true) {
+		return (STAT_NOOP);
+	}
+	return (_parse_gcode_block(block));
+}
+
+//_normalize_gcode_block//
+//input : a gcode block in the form of string
+//output : none
+//fuction : normalize the g-code block
+//the block is changed into all caps form, all the white spaces are removed,
+//deleting leading zeros and signal a block delete if provided
+//notes : ONLY ACCESSED BY gc_gcode_parser
+//additions: 
+//
+static void _normalize_gcode_block(char *str, uint8_t *d_flag){
+
+	char *read_p = str;
+	char *write_p = str;
+	
+//signaling block delete flag
+	if(*read_p == '/'){
+	*d_flag = true;
+	return;// why would you actually continue .. u will ignor the block
+	}
+	else{*d_flag = false;}
+	
+//deleting invalid charachters and whitespaces by ignoring them while changing the block into upper case
+	for(; *write_p != NUL; read_p++){
+		if(*read_p == NUL) *write_p = NUL;
+		else if(isalnum((uint8_t)*read_p)||strchr(".-",*read_p)){	//ctype only takes unsigned char values
+			*(write_p++) = (char)toupper((uint8_t)*read_p);
+		}
+	}
+//deleting leading zeros
+	read_p = str;
+	while(*read_p != NUL){
+		if(*read_p == '.'){
+			read_p++;
+			continue;
+		}
+		else if((!isdigit((uint8_t)*read_p))&&(*(read_p+1) == '0')&&(isdigit((uint8_t)*(read_p+2)))){
+			write_p = read_p+1;
+			while(*write_p != NUL){
+				*write_p = *(write_p+1);
+				write_p++;
+			}
+			continue;
+		}
+		read_p++;
+	}
+}
+
+#define NUMBER_DIGITS 15							//significant digits kept, 15 digits are exact in a double
+#define NUMBER_FRACTION 22							//fraction digits kept, 10^22 is the last power of ten exact in a double
+#define FLOAT_EXACT_INT 16777216UL			//2^24, integers below it are exact in a float
+#define FLOAT_EXACT_POW10 10						//10^10 is the last power of ten exact in a float
+
+static const float pow10f_tab[] = {1e0f,1e1f,1e2f,1e3f,1e4f,1e5f,1e6f,1e7f,1e8f,1e9f,1e10f};	//the M4 FPU is single precision
+static const double pow10_tab[] = {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+//_on_float_tie//
+//input : double precision value, the float it rounded to
+//output : true when the value is halfway between two floats
+//fuction : 
+//notes : 
+//additions: 
+//
+static uint8_t _on_float_tie(double value, float rounded){
+	if((double)rounded == value) return false;
+	float other = nextafterf(rounded,(value > rounded)? INFINITY : 0);
+	return (value == ((double)rounded + (double)other)/2);
+}
+
+//_get_number//
+//input : pointer to the string pointer, storage for the value
+//output : STAT_OK or STAT_INVALID_NUMBER_FORM
+//fuction : reads a plain decimal number [+-]ddd[.ddd] and advances the string pointer past it
+//notes : replaces strtof, the block is untrusted input so there is no exponent, hex, inf or nan form
+//and the number of digits is bounded. the digits are gathered as an integer and scaled by one
+//division, a single precision one while both operands are exact (the usual CAM output) and a
+//double one otherwise. a double quotient that lands halfway between two floats was rounded
+//twice, the exact remainder of the division picks the side. up to NUMBER_DIGITS significant
+//digits and NUMBER_FRACTION fraction digits the value is the one strtof gives, host/corpus.c
+//checks it. longer numbers are cut there, not rounded, and can be one float step off strtof
+//when they sit on a tie
+//additions: 
+//
+static stat_t _get_number(char **strp, float *value){
+	char *p = *strp;
+	uint64_t mantissa = 0;
+	uint8_t digits = 0;
+	uint8_t fraction = 0;
+	uint8_t negative = false;
+	uint8_t any = false;
+	
+	if((*p == '-')||(*p == '+')){
+		negative = (*p == '-');
+		p++;
+	}
+	for(; isdigit((uint8_t)*p); p++){
+		any = true;
+		if((mantissa == 0) && (*p == '0')) continue;		//leading zeros are not significant
+		if(++digits > NUMBER_DIGITS) return STAT_INVALID_NUMBER_FORM;
+		mantissa = mantissa*10 + (uint64_t)(*p - '0');
+	}
+	if(*p == '.'){
+		for(p++; isdigit((uint8_t)*p); p++){
+			any = true;
+			if((digits >= NUMBER_DIGITS)||(fraction >= NUMBER_FRACTION)) continue;
+			if((mantissa != 0) || (*p != '0')) digits++;
+			mantissa = mantissa*10 + (uint64_t)(*p - '0');
+			fraction++;
+		}
+	}
+	if(any == false) return STAT_INVALID_NUMBER_FORM;
+	if((mantissa < FLOAT_EXACT_INT) && (fraction <= FLOAT_EXACT_POW10)){
+		*value = (float)mantissa/pow10f_tab[fraction];		//both exact, one rounding in single precision
+	}else{
+		double quotient = (double)mantissa/pow10_tab[fraction];
+		*value = (float)quotient;
+		if(_on_float_tie(quotient,*value)){
+			double rest = fma(-quotient,pow10_tab[fraction],(double)mantissa);	//exact for a rounded quotient
+			if(rest != 0){*value = (float)nextafter(quotient,(rest > 0)? INFINITY : 0);}
+		}
+	}
+	if(negative) *value = -*value;
+	*strp = p;
+	return STAT_OK;
+}
+
+//_get_next_code_word//
+//input : pointers to a char, float and an array of charachters
+//output : state based on the word interpretation
+//fuction : interpretes a word "N,M,G,X,Y,...." 
+//notes : 
+//additions: 
+//
+static stat_t _get_next_code_word(char **strp, char *letter, float *value){
+	if(**strp == NUL){
+		return STAT_COMPLETE;
+	}
+	if(!isupper((uint8_t)**strp)){
+		return STAT_INVALID_CODE_FORM;
+	}
+	
+	*letter = **strp;
+	(*strp)++;
+	// get value from string, G0X20 needs no special case since there is no hex form
+	return _get_number(strp,value);
+}
+
+//_word_in_range//
+//input : word letter and value
+//output : false if the value can't be cast to the integer the parser casts it to
+//fuction : 
+//notes : out of range float to integer casts are undefined, G-1 or N-5 must not reach them
+//additions: 
+//
+static uint8_t _word_in_range(char letter, float value){
+	switch(letter){
+		case 'G': case 'M': return ((value >= 0) && (value < 256.0f));
+		case 'T': case 'H': case 'L': return ((value >= 0) && (value < 255.5f));			//rounded to the nearest integer
+		case 'N': return ((value >= 0) && (value < 4294967296.0f));
+		default: return true;
+	}
+}
+
+//_point//
+//input : a float value
+//output : the point value "G60.1  ---> point value 1"
+//fuction : returns the point value
+//notes : 
+//additions: 
+//
+static uint8_t _point(float value){
+	return (uint8_t)(((value*10)-(truncf(value)*10))+0.5f);
+}
+
+
+
+//_parse_jog_block//
+//input : normalized $J block without the $J
+//output : state based on the jog command
+//fuction : reads the axis velocities and hands them to the jogging cycle
+//notes : only axis words, in units per minute
+//additions:
+//
+static stat_t _parse_jog_block(char *block){
+	char *strp = block;
+	char letter;
+	float value;
+	float velocity[AXES] = {0};
+	uint32_t flags = 0;
+	stat_t status;
+	while((status = _get_next_code_word(&strp,&letter,&value)) == STAT_OK){
+		uint8_t axis;
+		switch(letter){
+			case 'X': axis = X_AXIS; break;
+			case 'Y': axis = Y_AXIS; break;
+			case 'Z': axis = Z_AXIS; break;
+#if (AXES > 3)
+			case 'A': axis = A_AXIS; break;
+#endif
+#if (AXES > 4)
+			case 'B': axis = B_AXIS; break;
+#endif
+#if (AXES > 5)
+			case 'C': axis = C_AXIS; break;
+#endif
+			default: return STAT_UNSUPPORTED_GCODE;
+		}
+		velocity[axis] = value;
+		flags |= GF_BIT(axis);
+	}
+	if(status != STAT_COMPLETE){
+		return status;
+	}
+	return (cm_jog_velocity(velocity,flags));
+}
+
+#define SET_MODAL(m,flag,param,val) {cm.gn.param = val; cm.gf |= GF_BIT(flag); gc.violation |= ((gc.modal & MODAL_BIT(m)) != 0); gc.modal |= MODAL_BIT(m); break;}
+#define SET_NON_MODAL(flag,param,val) {cm.gn.param = val; cm.gf |= GF_BIT(flag); break;}
+
+//_parse_gcode_block//
+//input : normalized gcode block in the form of string
+//output : state based on the execution of parsing
+//fuction : invokes SET_MODAL and SET_NON_MODAL to set the cannonical machine gcode values and flags 
+//notes : 
+//additions: 
+//
+static stat_t _parse_gcode_block(char *block){
+	char* strp = block;
+	char letter;
+	float value = 0;
+	stat_t status = STAT_OK;
+	
+	gc.modal = 0;
+	gc.violation = false;
+	gc.cutter_comp_tool = false;
+	cm.gf = 0;										//values are only read behind their flag, except these
+	cm.gn.next_action = ACTION_DEFAULT;
+	cm.gn.l_word = 0;
+	cm.gn.absolute_override = false;
+	cm.gn.parameter = 0;
+	cm.gn.radius = 0;
+	cm.gn.center_offsets[0] = 0;
+	cm.gn.center_offsets[1] = 0;
+	cm.gn.center_offsets[2] = 0;
+	cm.gn.motion_mode = cm_get_motion_mode(&cm.gm);
+	
+	while((status = _get_next_code_word(&strp,&letter,&value)) == STAT_OK){
+		if(_word_in_range(letter,value) == false){
+			status = STAT_INPUT_VALUE_OUT_OF_RANGE;
+			break;
+		}
+		switch(letter){
+			case 'N': SET_NON_MODAL(GF_LINENUM,linenum,(uint32_t)value);
+			case 'G':{
+				switch((uint8_t)value){
+					case 0: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_STRAIGHT_TRAVERSE);
+					case 1: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_STRAIGHT_FEED);
+#if FEATURE_ARCS
+					case 2: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CW_ARC);
+					case 3: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CCW_ARC);
+#endif
+					case 4: SET_MODAL(MODAL_GROUP_G0,GF_NEXT_ACTION,next_action,ACTION_DWELL);
+					case 10: SET_MODAL(MODAL_GROUP_G0,GF_NEXT_ACTION,next_action,ACTION_SET_COORD_DATA);
+					case 17: SET_MODAL(MODAL_GROUP_G2,GF_PLANE_SELECT,plane_select,XY_PLANE);
+					case 18: SET_MODAL(MODAL_GROUP_G2,GF_PLANE_SELECT,plane_select,XZ_PLANE);
+					case 19: SET_MODAL(MODAL_GROUP_G2,GF_PLANE_SELECT,plane_select,YZ_PLANE);
+					case 20: SET_MODAL(MODAL_GROUP_G6,GF_UNITS_MODE,units_mode,INCHES);
+					case 21: SET_MODAL(MODAL_GROUP_G6,GF_UNITS_MODE,units_mode,MILLIMETERS);
+					case 28: {
+						switch(_point(value)){
+							case 0: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_GOTO_G28_POSITION);
+							case 1: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_SET_G28_POSITION);
+							case 2: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_SEARCH_HOME);
+							case 3: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_SET_ABSOLUTE_ORIGIN);
+							case 4: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_HOMING_NO_SET);
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 29: {
+						switch (_point(value)) {
+							case 0: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_PROBE_GRID);
+							case 1: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_CLEAR_GRID);
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 30: {
+						switch (_point(value)) {
+							case 0: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_GOTO_G30_POSITION);
+							case 1: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_SET_G30_POSITION);
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 38: {
+						switch (_point(value)) {
+							case 2: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_STRAIGHT_PROBE);
+							case 3: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_STRAIGHT_PROBE_NO_ERROR);
+							case 4: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_STRAIGHT_PROBE_AWAY);
+							case 5: SET_MODAL (MODAL_GROUP_G0, GF_NEXT_ACTION, next_action, ACTION_STRAIGHT_PROBE_AWAY_NO_ERROR);
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 40: SET_MODAL(MODAL_GROUP_G7,GF_CUTTER_COMP,cutter_comp,CUTTER_COMP_OFF);
+					case 41: {
+						switch (_point(value)) {
+							case 0: gc.cutter_comp_tool = true; SET_MODAL (MODAL_GROUP_G7, GF_CUTTER_COMP, cutter_comp, CUTTER_COMP_LEFT);	//D is the tool
+							case 1: SET_MODAL (MODAL_GROUP_G7, GF_CUTTER_COMP, cutter_comp, CUTTER_COMP_LEFT);		//D is the diameter
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 42: {
+						switch (_point(value)) {
+							case 0: gc.cutter_comp_tool = true; SET_MODAL (MODAL_GROUP_G7, GF_CUTTER_COMP, cutter_comp, CUTTER_COMP_RIGHT);
+							case 1: SET_MODAL (MODAL_GROUP_G7, GF_CUTTER_COMP, cutter_comp, CUTTER_COMP_RIGHT);
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 43: {
+						switch (_point(value)) {
+							case 0: SET_MODAL (MODAL_GROUP_G8, GF_TOOL_LENGTH_COMP, tool_length_comp, TOOL_LENGTH_COMP_ON);	//H is the tool
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 49: SET_MODAL(MODAL_GROUP_G8,GF_TOOL_LENGTH_COMP,tool_length_comp,TOOL_LENGTH_COMP_OFF);
+#if FEATURE_ABSOLUTE_OVERRIDE
+					case 53: SET_MODAL(MODAL_GROUP_G0,GF_ABSOLUTE_OVERRIDE,absolute_override,true);
+#endif
+					case 54: SET_MODAL(MODAL_GROUP_G12,GF_COORDINATE_SYSTEM,coordinate_system,G54);
+					case 55: SET_MODAL(MODAL_GROUP_G12,GF_COORDINATE_SYSTEM,coordinate_system,G55);
+					case 56: SET_MODAL(MODAL_GROUP_G12,GF_COORDINATE_SYSTEM,coordinate_system,G56);
+					case 57: SET_MODAL(MODAL_GROUP_G12,GF_COORDINATE_SYSTEM,coordinate_system,G57);
+					case 58: SET_MODAL(MODAL_GROUP_G12,GF_COORDINATE_SYSTEM,coordinate_system,G58);
+					case 59: SET_MODAL(MODAL_GROUP_G12,GF_COORDINATE_SYSTEM,coordinate_system,G59);
+					case 60:{ 
+						switch(_point(value)){
+							case 0: SET_MODAL(MODAL_GROUP_G13,GF_PATH_CONTROL,path_control,PATH_EXACT_PATH);
+							case 1: SET_MODAL(MODAL_GROUP_G13,GF_PATH_CONTROL,path_control,PATH_EXACT_STOP);
+							default: status = STAT_UNSUPPORTED_GCODE;
+						}
+						break;
+					}
+					case 80: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANCEL_MOTION_MODE);
+					case 81: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_81);
+					case 82: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_82);
+					case 83: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_83);
+					case 84: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_84);
+					case 85: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_85);
+					case 86: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_86);
+					case 87: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_87);
+					case 88: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_88);
+					case 89: SET_MODAL(MODAL_GROUP_G1,GF_MOTION_MODE,motion_mode,MOTION_MODE_CANNED_89);
+					case 90: SET_MODAL(MODAL_GROUP_G3,GF_DISTANCE_MODE,distance_mode,ABSOLUTE_MODE);
+					case 91: SET_MODAL(MODAL_GROUP_G3,GF_DISTANCE_MODE,distance_mode,INCREMENTAL_MODE);
+					case 92:{
+						switch(_point(value)){
+							case 0: SET_MODAL(MODAL_GROUP_G0,GF_NEXT_ACTION,next_action,ACTION_SET_AXIS_OFFSETS);
+							case 1: SET_MODAL(MODAL_GROUP_G0,GF_NEXT_ACTION,next_action,ACTION_RESET_AXIS_OFFSETS);
+							case 2: SET_MODAL(MODAL_GROUP_G0,GF_NEXT_ACTION,next_action,ACTION_SUSPEND_AXIS_OFFSETS);
+							case 3: SET_MODAL(MODAL_GROUP_G0,GF_NEXT_ACTION,next_action,ACTION_RESUME_AXIS_OFFSETS);
+						}
+						break;
+					}
+#if FEATURE_INVERSE_TIME
+					case 93: SET_MODAL(MODAL_GROUP_G5,GF_FEEDRATE_MODE,feedrate_mode,INVERSE_TIME_MODE);
+#endif
+					case 94: SET_MODAL(MODAL_GROUP_G5,GF_FEEDRATE_MODE,feedrate_mode,UNITS_PER_MINUTE_MODE);
+					//case 98
+					//case 99
+					default: status = STAT_UNSUPPORTED_GCODE;
+				}
+				break;
+			}
+			case 'M':{
+				switch((uint8_t)value){
+					case 0: SET_MODAL(MODAL_GROUP_M4,GF_PROGRAMFLOW,programflow,PROGRAM_STOP);
+					case 1: SET_MODAL(MODAL_GROUP_M4,GF_PROGRAMFLOW,programflow,PROGRAM_STOP);
+					case 2: SET_MODAL(MODAL_GROUP_M4,GF_PROGRAMFLOW,programflow,PROGRAM_END);
+					case 3: SET_MODAL(MODAL_GROUP_M7,GF_SPINDLE_MODE,spindle_mode,SPINDLE_CW);
+					case 4: SET_MODAL(MODAL_GROUP_M7,GF_SPINDLE_MODE,spindle_mode,SPINDLE_CCW);
+					case 5: SET_MODAL(MODAL_GROUP_M7,GF_SPINDLE_MODE,spindle_mode,SPINDLE_OFF);
+					case 6: SET_MODAL(MODAL_GROUP_M6,GF_TOOL_CHANGE,tool_change,true);
+					case 7: case 8:{
+						uint8_t coolant = ((uint8_t)value == 7)? COOLANT_MIST : COOLANT_FLOOD;
+						if((gc.modal & MODAL_BIT(MODAL_GROUP_M8)) && (cm.gn.coolant != COOLANT_OFF) && (cm.gn.coolant != coolant)){
+							cm.gn.coolant = COOLANT_ON;		//M7 M8 in one block turn both on, M9 with either is a violation
+							break;
+						}
+						SET_MODAL(MODAL_GROUP_M8,GF_COOLANT,coolant,coolant);
+					}
+					case 9: SET_MODAL(MODAL_GROUP_M8,GF_COOLANT,coolant,COOLANT_OFF);
+					case 30: SET_MODAL(MODAL_GROUP_M4,GF_PROGRAMFLOW,programflow,PROGRAM_END);
+					//case 48:
+					//case 49:
+					default: status = STAT_UNSUPPORTED_MCODE;
+				}
+				break;
+			}
+			case 'X': SET_NON_MODAL(X_AXIS,target[X_AXIS],value);
+			case 'Y': SET_NON_MODAL(Y_AXIS,target[Y_AXIS],value);
+			case 'Z': SET_NON_MODAL(Z_AXIS,target[Z_AXIS],value);
+#if (AXES > 3)
+			case 'A': SET_NON_MODAL(A_AXIS,target[A_AXIS],value);
+#endif
+#if (AXES > 4)
+			case 'B': SET_NON_MODAL(B_AXIS,target[B_AXIS],value);
+#endif
+#if (AXES > 5)
+			case 'C': SET_NON_MODAL(C_AXIS,target[C_AXIS],value);
+#endif
+			case 'I': SET_NON_MODAL(GF_CENTER_OFFSET_I,center_offsets[0],value);
+			case 'J': SET_NON_MODAL(GF_CENTER_OFFSET_J,center_offsets[1],value);
+			case 'K': SET_NON_MODAL(GF_CENTER_OFFSET_K,center_offsets[2],value);
+			case 'F': SET_NON_MODAL(GF_FEEDRATE,feedrate,value);
+			case 'S': SET_NON_MODAL(GF_SPINDLE_SPEED,spindle_speed,value);
+			case 'R': SET_NON_MODAL(GF_RADIUS,radius,value);
+			case 'P': SET_NON_MODAL(GF_PARAMETER,parameter,value);
+			case 'T': SET_NON_MODAL(GF_TOOL_SELECT,tool_select,(uint8_t)(value+0.5f));
+			case 'D': SET_NON_MODAL(GF_D_WORD,d_word,value);
+			case 'H': SET_NON_MODAL(GF_H_WORD,h_word,(uint8_t)(value+0.5f));
+			case 'L': cm.gn.l_word = (uint8_t)(value+0.5f); break;		//no flag, 0 when the block has none
+			default: status = STAT_UNSUPPORTED_GCODE;
+				
+		}
+		if(status != STAT_OK) break;
+	}
+	if(status != STAT_OK && status != STAT_COMPLETE) return status;
+	if((status = _validate_gcode_block()) != STAT_OK) return status;
+	return _execute_gcode_block();
+}
+
+
+//_validate_gcode_block//
+//input : none
+//output : STAT_OK or the reason the block is rejected
+//fuction : rejects a block with two words of one modal group, or axis words nobody or two commands can take
+//notes : the modal groups are collected as bits by SET_MODAL so this is a handful of mask tests.
+//group 0 holds the non-modal commands, G4, G10, G28, G29, G30, G38.x, G53 and G92.x
+//additions: 
+//
+static stat_t _validate_gcode_block(void){
+	if(gc.violation){
+		return STAT_MODAL_GROUP_VIOLATION;
+	}
+	if((cm.gf & GF_BIT(GF_CUTTER_COMP)) && (cm.gn.cutter_comp != CUTTER_COMP_OFF)){
+		if(gc.cutter_comp_tool){								//G41 G42, the loaded tool without D
+			if((cm.gf & GF_BIT(GF_D_WORD)) && ((cm.gn.d_word < 0) || (cm.gn.d_word >= TOOLS))){
+				return STAT_INPUT_VALUE_OUT_OF_RANGE;
+			}
+		}else if(((cm.gf & GF_BIT(GF_D_WORD)) == 0) || (cm.gn.d_word <= 0)){
+			return STAT_CUTTER_COMP_SPECIFICATION;
+		}
+	}
+	if((cm.gf & GF_BIT(GF_H_WORD)) && (cm.gn.h_word >= TOOLS)){
+		return STAT_INPUT_VALUE_OUT_OF_RANGE;
+	}
+	if(cm.gn.next_action == ACTION_SET_COORD_DATA){
+		if(cm.gn.l_word > 2){
+			return STAT_UNSUPPORTED_GCODE;				//L1 tool table, L2 coordinate system
+		}
+		if((cm.gn.parameter < 0) || (cm.gn.parameter >= 256.0f)){
+			return STAT_INPUT_VALUE_OUT_OF_RANGE;
+		}
+	}
+	uint32_t axis_words = cm.gf & GF_AXES_MASK;
+	uint8_t takes_axes = (cm.gf & GF_BIT(GF_NEXT_ACTION)) && (ACTION_BIT(cm.gn.next_action) & ACTION_AXIS_WORDS);
+	if(takes_axes){
+		if(gc.modal & MODAL_BIT(MODAL_GROUP_G1)){			//e.g. G1 G92 X0
+			return STAT_AXIS_WORD_CONFLICT;
+		}
+		if((axis_words == 0) && (cm.gn.next_action == ACTION_SET_AXIS_OFFSETS)){
+			return STAT_AXIS_WORDS_MISSING;
+		}
+	}else if(axis_words && (cm.gn.motion_mode == MOTION_MODE_CANCEL_MOTION_MODE)){
+		return STAT_AXIS_WORDS_WITHOUT_MOTION;
+	}
+	return STAT_OK;
+}
+
+
+//_execute_gcode_block//
+//input : none
+//output : state based on the execution of the execution process ^^
+//fuction : invokes EXEC_FUNC and cannonical machine function to set the gcode model of the cannonical machine
+// and starts the palanning of coordinated motions and dwells
+//notes : 
+//additions: 
+//
+/*
+order of execution as provided by NIST RS274NGC
+0.record line number //optional
+1. comment (includes message).
+2. set feed rate mode (G93, G94  inverse time or per minute).
+3. set feed rate (F).
+//override
+4. set spindle speed (S).
+//override
+5. select tool (T).
+6. change tool (M6).
+7. spindle on or off (M3, M4, M5).
+8. coolant on or off (M7, M8, M9).
+9. enable or disable overrides (M48, M49).
+10. dwell (G4).
+11. set active plane (G17, G18, G19).
+12. set length units (G20, G21).
+13. cutter radius compensation on or off (G40, G41, G42)
+14. cutter length compensation on or off (G43, G49)
+15. coordinate system selection (G54, G55, G56, G57, G58, G59, G59.1, G59.2, G59.3).
+16. set path control mode (G61, G61.1, G64)
+17. set distance mode (G90, G91).
+18. set retract mode (G98, G99).
+19. home (G28, G30) or
+change coordinate system data (G10) or
+set axis offsets (G92, G92.1, G92.2, G94).
+20. perform motion (G0 to G3, G80 to G89), as modified (possibly) by G53.
+21. stop (M0, M1, M2, M30, M60).
+*/
+#define EXEC_FUNC(f,flag,v) if(cm.gf & GF_BIT(flag)) { status = f(cm.gn.v); if(status != STAT_OK){return status;}}
+static stat_t _execute_gcode_block(void){
+	stat_t status = STAT_OK;
+	uint8_t commands = ((cm.gf & GF_BIT(GF_TOOL_CHANGE))? 1 : 0) + ((cm.gf & GF_BIT(GF_SPINDLE_MODE))? 1 : 0) +
+										 ((cm.gf & GF_BIT(GF_COOLANT))? 1 : 0) + ((cm.gn.next_action == ACTION_DWELL)? 1 : 0);
+	if((commands != 0) && (cc_command_room(commands) == false)){
+		return STAT_RC;							//nothing changed yet, the block is run again
+	}
+	if(cm.gf & GF_BIT(GF_LINENUM)) {cm_set_model_linenum(cm.gn.linenum);}	//blocks without N keep the previous number
+	EXEC_FUNC(cm_set_feed_rate_mode,GF_FEEDRATE_MODE,feedrate_mode);
+	EXEC_FUNC(cm_set_feed_rate,GF_FEEDRATE,feedrate);
+	//feed and traverse override factor 
+	EXEC_FUNC(cm_set_spindle_speed,GF_SPINDLE_SPEED,spindle_speed);
+	//spindle override enable and factor
+	EXEC_FUNC(cm_select_tool,GF_TOOL_SELECT,tool_select);
+	EXEC_FUNC(cm_change_tool,GF_TOOL_CHANGE,tool_change);
+	EXEC_FUNC(cm_spindle_control,GF_SPINDLE_MODE,spindle_mode);
+	EXEC_FUNC(cm_coolant_control,GF_COOLANT,coolant);
+	//overrides enable
+	if(cm.gn.next_action == ACTION_DWELL){
+		status = cm_dwell(cm.gn.parameter);
+		if(status != STAT_OK){return status;}		//G4 P-1 G17 reports the dwell
+	}
+	EXEC_FUNC(cm_select_plane,GF_PLANE_SELECT,plane_select);
+	EXEC_FUNC(cm_select_unit_mode,GF_UNITS_MODE,units_mode);
+	if(cm.gf & GF_BIT(GF_CUTTER_COMP)){
+		if(gc.cutter_comp_tool){
+			status = cm_cutter_comp_tool(cm.gn.cutter_comp,(cm.gf & GF_BIT(GF_D_WORD))? (uint8_t)(cm.gn.d_word+0.5f) : cm.gm.tool);
+		}else{
+			status = cm_cutter_comp(cm.gn.cutter_comp,cm.gn.d_word);
+		}
+		if(status != STAT_OK){return status;}		//no move on an offset that wasn't set, G41 D99
+	}
+	if(cm.gf & GF_BIT(GF_TOOL_LENGTH_COMP)){
+		status = cm_tool_length_comp(cm.gn.tool_length_comp,(cm.gf & GF_BIT(GF_H_WORD))? cm.gn.h_word : TOOL_LOADED);
+		if(status != STAT_OK){return status;}
+	}
+	EXEC_FUNC(cm_set_coord_system,GF_COORDINATE_SYSTEM,coordinate_system);
+	EXEC_FUNC(cm_select_path_control,GF_PATH_CONTROL,path_control);
+	EXEC_FUNC(cm_select_distance_mode,GF_DISTANCE_MODE,distance_mode);
+	//retract mode
+	if((cm.gn.next_action != ACTION_DEFAULT) && (cm.gn.next_action != ACTION_DWELL)){
+		cc_flush();								//group 0 commands come after the held compensated move
+	}
+	switch(cm.gn.next_action){
+		case ACTION_SET_COORD_DATA:{
+			if(cm.gn.l_word == 1){
+				status = cm_set_tool_table((uint8_t)cm.gn.parameter,cm.gn.target,cm.gf,cm.gn.radius);
+			}else{
+				status = cm_set_coord_offsets((uint8_t)cm.gn.parameter,cm.gn.target,cm.gf);
+			}
+			break;
+		}
+		case ACTION_SET_AXIS_OFFSETS: {status = cm_set_origin_offsets(cm.gn.target,cm.gf); break;}
+		case ACTION_RESET_AXIS_OFFSETS: {status = cm_reset_origin_offsets(); break;}
+		case ACTION_SUSPEND_AXIS_OFFSETS: {status = cm_suspend_origin_offsets(); break;}
+		case ACTION_RESUME_AXIS_OFFSETS: {status = cm_resume_origin_offsets(); break;}
+		case ACTION_GOTO_G28_POSITION:
+		case ACTION_SET_G28_POSITION:
+		case ACTION_SEARCH_HOME:	{status = cm_cycle_homing_start(); break;}
+		case ACTION_SET_ABSOLUTE_ORIGIN:
+		case ACTION_HOMING_NO_SET:
+		case ACTION_GOTO_G30_POSITION:
+		case ACTION_SET_G30_POSITION:
+		case ACTION_STRAIGHT_PROBE:	{status = cm_straight_probe(cm.gn.target,cm.gf,true,true); break;}
+		case ACTION_STRAIGHT_PROBE_NO_ERROR: {status = cm_straight_probe(cm.gn.target,cm.gf,false,true); break;}
+		case ACTION_STRAIGHT_PROBE_AWAY: {status = cm_straight_probe(cm.gn.target,cm.gf,true,false); break;}
+		case ACTION_STRAIGHT_PROBE_AWAY_NO_ERROR: {status = cm_straight_probe(cm.gn.target,cm.gf,false,false); break;}
+		case ACTION_PROBE_GRID: {status = cm_probe_grid(cm.gn.target,cm.gf,cm.gn.center_offsets); break;}
+		case ACTION_CLEAR_GRID: {status = cm_leveling_clear(); break;}
+		case ACTION_DEFAULT: //it's a motion
+#if FEATURE_ABSOLUTE_OVERRIDE
+			cm_set_absolute_override(cm.gn.absolute_override);
+#endif
+			db_end_session(GCODE_PARSER_TIME);
+			switch(cm.gn.motion_mode){
+				case MOTION_MODE_CANCEL_MOTION_MODE: {cm.gm.motion_mode = cm.gn.motion_mode; break;}
+				case MOTION_MODE_STRAIGHT_TRAVERSE:{status = cm_straight_traverse(cm.gn.target,cm.gf); break;}
+				case MOTION_MODE_STRAIGHT_FEED:{status = cm_straight_feed(cm.gn.target,cm.gf); break;}
+#if FEATURE_ARCS
+				case MOTION_MODE_CW_ARC : case MOTION_MODE_CCW_ARC :{
+					cm.gm.motion_mode = cm.gn.motion_mode;		//the direction of a compensated arc
+					status = cm_arc_feed_mask(cm.gn.target,cm.gf,cm.gn.center_offsets,cm.gn.radius);
+					break;
+				}
+#endif
+			}
+	}
+#if FEATURE_ABSOLUTE_OVERRIDE
+	cm_set_absolute_override(false);
+#endif
+	if (cm.gf & GF_BIT(GF_PROGRAMFLOW)) {
+		if (cm.gn.programflow == PROGRAM_STOP) {
+			cc_flush();								//the held compensated move runs before the stop
+			//cm_program_stop();
+		} else {
+			cm_cutter_comp(CUTTER_COMP_OFF,0);		//M2 M30 end the compensation with the held move
+			//cm_program_end();
+		}
+	}
+	db_end_session(BLOCK_PREPARE_TIME);
+	return status;
+}
+
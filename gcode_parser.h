@@ -1,13 +1,13 @@
-// gcode_parser.h
-// Runs on TM4C123
-// Omar Emad El-Deen
-// Mars, 2016
-
-#ifndef GCODE_PARSER_H
-#define GCODE_PARSER_H
-
-stat_t gc_gcode_parser(char *block);
-
-#endif
-
-
+// gcode_parser.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2016
+
+#ifndef GCODE_PARSER_H
+#define GCODE_PARSER_H
+
+stat_t gc_gcode_parser(char *block);
+
+#endif
+
+
@@ -0,0 +1,238 @@
+/*
+ * arc_planner.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * host stand-in for the firmware's arc generator, which this snapshot doesn't carry, following
+ * what the firmware object does. cm_arc_feed works the arc out and cm_arc_callback feeds it to
+ * mp_plan_line one chord at a time from the controller loop, while the planner has room.
+ * chords are as short as the chordal tolerance, cm.arc_segment_len and MIN_ARC_SEGMENT_USEC ask
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "util.h"
+
+typedef struct arArcSingleton{
+	uint8_t move_state;
+
+	float position[AXES];				//chord start, the end of the last chord
+	float offset[3];						//IJK, center from the start
+	float length;								//helix length
+	float theta_start;
+	float theta_end;
+	float radius;
+	float angular_travel;				//radians, negative for CCW
+	float linear_travel;				//along the axis normal to the plane
+	float planar_travel;
+
+	uint32_t rotations;					//P, full turns on top of the arc
+	uint8_t full_circle;
+	uint8_t arc_axis_0;					//plane axes
+	uint8_t arc_axis_1;
+	uint8_t linear_axis;
+
+	float arc_time;							//minutes
+	float arc_segments;
+	int32_t arc_segment_count;
+	float arc_segment_theta;
+	float arc_segment_linear_travel;
+	float center_0;
+	float center_1;
+
+	GState_t gm;								//model of the chords
+}arc_t;
+
+MACHINE_LOCAL arc_t arc;
+
+static stat_t _compute_arc(void);
+static void _estimate_arc_time(void);
+
+//cm_arc_feed//
+//input : target, one float flag per axis word, IJK offsets, R
+//output : STAT_OK or the arc specification error
+//fuction : G2/G3, works the arc out and hands it to cm_arc_callback
+//notes : an arc with neither plane axis word is a full circle, P adds full turns
+//additions: 
+//
+stat_t cm_arc_feed(float target[], float flags[], float offsets[], float radius){
+	if((cm.gm.feedrate_mode != INVERSE_TIME_MODE) && fp_ZERO(cm.gm.feedrate)){
+		return STAT_GCODE_FEEDRATE_NOT_SPECIFIED;
+	}
+	if((cm.gf & (GF_AXES_MASK|GF_CENTER_OFFSETS_MASK|GF_BIT(GF_RADIUS))) == 0){
+		return STAT_OK;												//e.g. M2 under G2, nothing moves as with G1
+	}
+	uint8_t radius_f = ((cm.gf & GF_BIT(GF_RADIUS)) != 0);
+	if(radius_f && (fabsf(radius) < MIN_RADIUS_ARC)){
+		return STAT_MIN_RADIUS_ARC;
+	}
+	switch(cm.gm.plane_select){
+		case XY_PLANE: arc.arc_axis_0 = X_AXIS; arc.arc_axis_1 = Y_AXIS; arc.linear_axis = Z_AXIS; break;
+		case XZ_PLANE: arc.arc_axis_0 = X_AXIS; arc.arc_axis_1 = Z_AXIS; arc.linear_axis = Y_AXIS; break;
+		case YZ_PLANE: arc.arc_axis_0 = Y_AXIS; arc.arc_axis_1 = Z_AXIS; arc.linear_axis = X_AXIS; break;
+	}
+	uint8_t plane_0_f = (flags[arc.arc_axis_0] > 0.0f);
+	uint8_t plane_1_f = (flags[arc.arc_axis_1] > 0.0f);
+	if(cm.gf & GF_BIT(GF_CENTER_OFFSET_I + arc.linear_axis)){
+		return STAT_ARC_SPEC_ERROR;							//no offset along the helix axis
+	}
+	if(radius_f){
+		if(!(plane_0_f || plane_1_f)){
+			return STAT_ARC_AXIS_MISSING_FOR_SELECTED_PLANE;
+		}
+	}
+	cm_set_model_target(target,flags);
+	if(radius_f){
+		arc.radius = _TO_MILLI(radius);
+		if(fp_Equal(cm.position[arc.arc_axis_0],cm.gm.target[arc.arc_axis_0]) &&
+			 fp_Equal(cm.position[arc.arc_axis_1],cm.gm.target[arc.arc_axis_1])){
+			return STAT_ARC_RADIUS_MODE_END_IS_START;
+		}
+	}
+	cm_set_work_offsets(&cm.gm);
+	memcpy(&arc.gm,&cm.gm,sizeof(GState_t));
+	copy_vector(arc.position,cm.position);
+	arc.offset[0] = _AXIS_TO_MILLI(arc.arc_axis_0,offsets[arc.arc_axis_0]);
+	arc.offset[1] = _AXIS_TO_MILLI(arc.arc_axis_1,offsets[arc.arc_axis_1]);
+	arc.offset[2] = _AXIS_TO_MILLI(arc.linear_axis,offsets[arc.linear_axis]);
+	arc.rotations = (uint32_t)floorf(fabsf(cm.gn.parameter));
+	arc.full_circle = !(plane_0_f || plane_1_f);
+
+	stat_t status = _compute_arc();
+	if(status != STAT_OK){
+		return status;
+	}
+	if(fabsf(arc.length) < EPSILON){
+		return STAT_MINIMUM_LENGTH_MOVE;
+	}
+	arc.move_state = MOVE_RUN;
+	cm_cycle_start();
+	cm_finalize_move();
+	return STAT_OK;
+}
+
+//cm_arc_callback//
+//input : none
+//output : STAT_NOOP with no arc, STAT_RC while chords are left, STAT_OK on the last one
+//fuction : plans the next chord of the arc
+//notes : waits while the planner has fewer than PLANNER_BUFFER_LIMIT free buffers
+//additions: 
+//
+stat_t cm_arc_callback(void){
+	if(arc.move_state == MOVE_OFF){
+		return STAT_NOOP;
+	}
+	if(mp_get_available_buffers() < PLANNER_BUFFER_LIMIT){
+		return STAT_RC;
+	}
+	arc.theta_start += arc.arc_segment_theta;
+	arc.gm.target[arc.arc_axis_0] = arc.center_0 + sinf(arc.theta_start)*arc.radius;
+	arc.gm.target[arc.arc_axis_1] = arc.center_1 + cosf(arc.theta_start)*arc.radius;
+	arc.gm.target[arc.linear_axis] += arc.arc_segment_linear_travel;
+	mp_plan_line(&arc.gm);
+	copy_vector(arc.position,arc.gm.target);
+	if(--arc.arc_segment_count > 0){
+		return STAT_RC;
+	}
+	arc.move_state = MOVE_OFF;
+	return STAT_OK;
+}
+
+void cm_abort_arc(void){arc.move_state = MOVE_OFF;}
+
+//_compute_arc//
+//input : none, arc.gm holds the end point
+//output : STAT_OK, STAT_ARC_SPECIFICATION_ERROR when the end isn't on the circle
+//fuction : center, radius, angular travel and chords of the arc
+//notes : 
+//additions: 
+//
+static stat_t _compute_arc(void){
+	float x = arc.gm.target[arc.arc_axis_0] - arc.position[arc.arc_axis_0];
+	float y = arc.gm.target[arc.arc_axis_1] - arc.position[arc.arc_axis_1];
+	if(cm.gf & GF_BIT(GF_RADIUS)){						//center from R, the two centers are picked by its sign
+		float disc = 4*square(arc.radius) - (square(x) + square(y));
+		float h_x2_div_d = (disc > 0)? -sqrtf(disc)/hypotf(x,y) : 0;
+		if(cm.gm.motion_mode == MOTION_MODE_CCW_ARC){h_x2_div_d = -h_x2_div_d;}
+		if(arc.radius < 0){
+			h_x2_div_d = -h_x2_div_d;
+			arc.radius = -arc.radius;
+		}
+		arc.offset[0] = (x - (y*h_x2_div_d))/2;
+		arc.offset[1] = (y + (x*h_x2_div_d))/2;
+		arc.offset[2] = 0;
+	}else{
+		arc.radius = hypotf(arc.offset[0],arc.offset[1]);
+	}
+	float end_0 = x - arc.offset[0];						//end from the center
+	float end_1 = y - arc.offset[1];
+	float radius_error = fabsf(hypotf(end_0,end_1) - arc.radius);
+	if((radius_error > ARC_RADIUS_ERROR_MAX) ||
+		 ((radius_error > ARC_RADIUS_ERROR_MIN) && (radius_error > arc.radius*ARC_RADIUS_TOLERANCE))){
+		return STAT_ARC_SPECIFICATION_ERROR;
+	}
+
+	arc.theta_start = atan2f(-arc.offset[0],-arc.offset[1]);
+	arc.theta_end = atan2f(end_0,end_1);
+	arc.angular_travel = arc.theta_end - arc.theta_start;	//theta grows clockwise, x is its sine
+	if(cm.gm.motion_mode == MOTION_MODE_CW_ARC){
+		if(arc.angular_travel < 0){arc.angular_travel += 2*M_PI;}
+	}else{
+		if(arc.angular_travel > 0){arc.angular_travel -= 2*M_PI;}
+	}
+	uint32_t turns = arc.rotations;
+	if(arc.full_circle || fp_ZERO(arc.angular_travel)){		//the end is the start, a full turn at least
+		arc.angular_travel = 0;
+		turns = max(turns,1);
+	}
+	arc.angular_travel += ((cm.gm.motion_mode == MOTION_MODE_CW_ARC)? 2*M_PI : -2*M_PI)*turns;
+
+	arc.linear_travel = arc.gm.target[arc.linear_axis] - arc.position[arc.linear_axis];
+	arc.planar_travel = arc.angular_travel*arc.radius;
+	arc.length = hypotf(arc.planar_travel,arc.linear_travel);
+	if(fabsf(arc.length) < EPSILON){
+		return STAT_OK;
+	}
+	_estimate_arc_time();
+
+	float chord_tolerance = min(cm.chordal_tolerance,arc.radius);
+	float segments_chordal = arc.length/sqrtf(4*chord_tolerance*(2*arc.radius - chord_tolerance));
+	float segments_length = arc.length/cm.arc_segment_len;
+	float segments_time = arc.arc_time*MICROSECONDS_PER_MINUTE/MIN_ARC_SEGMENT_USEC;
+	arc.arc_segments = max(floorf(min3(segments_chordal,segments_length,segments_time)),1);
+	arc.gm.move_time = arc.arc_time/arc.arc_segments;
+	arc.arc_segment_count = (int32_t)arc.arc_segments;
+	arc.arc_segment_theta = arc.angular_travel/arc.arc_segments;
+	arc.arc_segment_linear_travel = arc.linear_travel/arc.arc_segments;
+	arc.center_0 = arc.position[arc.arc_axis_0] - sinf(arc.theta_start)*arc.radius;
+	arc.center_1 = arc.position[arc.arc_axis_1] - cosf(arc.theta_start)*arc.radius;
+	arc.gm.target[arc.linear_axis] = arc.position[arc.linear_axis];	//the chords step it
+	return STAT_OK;
+}
+
+//_estimate_arc_time//
+//input : none
+//output : none
+//fuction : arc.arc_time, from the feedrate and the feed limit of the helix axis
+//notes : in inverse time the chords are given the feedrate that keeps the arc on its time
+//additions: 
+//
+static void _estimate_arc_time(void){
+	if(arc.gm.feedrate_mode == INVERSE_TIME_MODE){
+		arc.arc_time = arc.gm.feedrate;
+		arc.gm.feedrate = arc.length/arc.arc_time;
+		arc.gm.feedrate_mode = UNITS_PER_MINUTE_MODE;
+	}else{
+		arc.arc_time = arc.length/arc.gm.feedrate;
+	}
+	arc.arc_time = max(arc.arc_time,fabsf(arc.linear_travel/cm.a[arc.linear_axis].max_feedrate));
+}
@@ -0,0 +1,359 @@
+/*
+ * bench.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * host micro benchmarks of the block path, timed with the same db_ sessions the firmware uses
+ * (host.h maps the debug timer to the cpu cycle counter) plus the wall clock per block.
+ *
+ * build:
+ *	make -C host bench
+ *
+ * usage:
+ *	bench [-n blocks] [cam files ...]
+ *
+ *	the files are the parser throughput corpus, every block is parsed, interpreted and planned
+ *	and the result is given in blocks/sec
+ *
+ * bench_loop is the same bench with FOR_AXES left as a loop, the CANONICAL_TIME and
+ * PLAN_LINE_TIME minimums of the two give what the axis specialization of config.h saves.
+ * with gcc -O2 on the host it is within the run to run noise, gcc unrolls the 3 axis loops by
+ * itself, the target build is where it counts. STEPPER_PREP_LINE is timed in stepper.c, which
+ * isn't on the host, so it can't be benched here
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "profile.h"
+#include "debugging.h"
+#include "gcode_parser.h"
+#include "encoder.h"
+#include "kinematics.h"
+#include "fastmath.h"
+
+#define BENCH_DEFAULT_BLOCKS 100000
+#define BENCH_LINE_SIZE 256
+#define BENCH_SEGMENTS 2000					//following error move, segments
+#define BENCH_LOST_STEPS 48					//injected mid move
+#define BENCH_SWEEP_STEP 127				//float bit patterns between fastmath samples
+
+typedef struct bench{
+	uint32_t blocks;
+	struct timespec start;
+}bench_t;
+
+static bench_t bn;
+
+static void _bench_start(void){
+	clock_gettime(CLOCK_MONOTONIC,&bn.start);
+}
+
+//_bench_stop//
+//input : benchmark name, number of blocks
+//output : none
+//fuction : prints the wall time per block and the blocks per second
+//notes : 
+//additions: 
+//
+static void _bench_stop(const char *name, uint32_t n){
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC,&end);
+	double wall = (end.tv_sec-bn.start.tv_sec) + (end.tv_nsec-bn.start.tv_nsec)*1e-9;
+	printf("%-28s %10.1f ns/block %12.0f blocks/s\n",name,wall*1e9/n,n/wall);
+}
+
+static void _bench_event(const char *name, uint8_t event){
+	dbEvent_t *e = &db.event[event];
+	printf("%-28s min %u  max %u  last %u cycles over %u calls\n",name,
+		e->event_min_time,e->event_max_time,e->event_time,e->event_recalls);
+}
+
+//_bench_target//
+//input : none
+//output : none
+//fuction : block target resolution alone, cm_set_model_target_mask and cm_set_work_offsets
+//notes : 
+//additions: 
+//
+static void _bench_target(void){
+	float target[AXES] = {0};
+	uint32_t flags = GF_BIT(X_AXIS)|GF_BIT(Y_AXIS)|GF_BIT(Z_AXIS);
+	volatile float sink = 0;
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i){
+		target[X_AXIS] = (float)(i & 0xFF);
+		target[Y_AXIS] = (float)((i >> 8) & 0xFF);
+		target[Z_AXIS] = (float)(i & 0x0F);
+		cm_set_model_target_mask(target,flags);
+		cm_set_work_offsets(&cm.gm);
+		sink += cm.gm.target[X_AXIS];
+	}
+	_bench_stop("target resolution",bn.blocks);
+}
+
+//_bench_canonical//
+//input : none
+//output : none
+//fuction : straight feeds through the canonical machine and the planner, CANONICAL_TIME session
+//notes : 
+//additions: 
+//
+static void _bench_canonical(void){
+	float target[AXES] = {0};
+	uint32_t flags = GF_BIT(X_AXIS)|GF_BIT(Y_AXIS);
+	cm_set_feed_rate(1000);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i){
+		target[X_AXIS] = (float)(i & 1)*10.0f;
+		target[Y_AXIS] = (float)((i >> 1) & 1)*10.0f;
+		host_drain(NULL);
+		cm_straight_feed(target,flags);
+	}
+	_bench_stop("canonical straight feed",bn.blocks);
+	_bench_event("CANONICAL_TIME",CANONICAL_TIME);
+	_bench_event("PLAN_LINE_TIME",PLAN_LINE_TIME);
+}
+
+//_bench_cutter_comp//
+//input : none
+//output : none
+//fuction : the square of _bench_canonical compensated, CUTTER_COMP_TIME session
+//notes : every block releases the one before it and half of the corners are outside arcs
+//additions: 
+//
+static void _bench_cutter_comp(void){
+	float target[AXES] = {0};
+	uint32_t flags = GF_BIT(X_AXIS)|GF_BIT(Y_AXIS);
+	static const float square_path[4][2] = {{10,0},{10,10},{0,10},{0,0}};
+	cm_set_feed_rate(1000);
+	cm_cutter_comp(CUTTER_COMP_LEFT,2);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i){
+		target[X_AXIS] = square_path[i & 3][0];
+		target[Y_AXIS] = square_path[i & 3][1];
+		host_drain(NULL);
+		cm_straight_feed(target,flags);
+		while(cm_cutter_comp_callback() == STAT_RC){
+			host_drain(NULL);
+		}
+	}
+	_bench_stop("cutter compensation",bn.blocks);
+	_bench_event("CUTTER_COMP_TIME",CUTTER_COMP_TIME);
+	_bench_event("CANONICAL_TIME",CANONICAL_TIME);
+	cm_cutter_comp(CUTTER_COMP_OFF,0);
+}
+
+//_bench_profile//
+//input : backend, name
+//output : none
+//fuction : short straight feeds planned with one velocity profile backend for the whole job
+//notes : the same blocks for every backend so their PLAN_LINE_TIME and PLAN_MOTION_PLANNING
+//sessions compare side by side
+//additions: 
+//
+static void _bench_profile(uint8_t backend, const char *name){
+	float target[AXES] = {0};
+	uint32_t flags = GF_BIT(X_AXIS)|GF_BIT(Y_AXIS);
+	char label[64];
+	mp_select_job_profile(backend);
+	cm_set_feed_rate(3000);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i){
+		target[X_AXIS] += 0.5f;
+		target[Y_AXIS] = (float)(i & 1)*0.5f;
+		host_drain(NULL);
+		cm_straight_feed(target,flags);
+	}
+	snprintf(label,sizeof(label),"%s profile",name);
+	_bench_stop(label,bn.blocks);
+	_bench_event("PLAN_LINE_TIME",PLAN_LINE_TIME);
+	_bench_event("PLAN_MOTION_PLANNING",PLAN_MOTION_PLANNING);
+}
+
+//_bench_following_error//
+//input : none
+//output : none
+//fuction : a trapezoid move of the feedback motor against the plant model, steps are lost half way
+//notes : the plant lags the pulses by a fraction of a segment, the alarm shall only come
+//with the lost steps. FOLLOWING_ERROR_TIME session
+//additions: 
+//
+static void _bench_following_error(void){
+	Encoder_t *e = &en.en[en.fb.motor];
+	float velocity = 0, max_before = 0;
+	uint32_t tripped = 0;
+	host_plant_init(1/en.fb.steps_per_count,0.8f);
+	for(uint32_t i=0; i<BENCH_SEGMENTS; ++i){
+		if(i < BENCH_SEGMENTS/4) velocity += 0.1f;				//steps per segment
+		else if(i >= 3*BENCH_SEGMENTS/4) velocity -= 0.1f;
+		e->encoder_position += (int32_t)velocity;
+		host_plant_update(e->encoder_position);
+		if(i == BENCH_SEGMENTS/2){
+			max_before = en.fb.max_following_error;
+			host_plant_lose_steps(BENCH_LOST_STEPS);
+		}
+		en_check_following_error();
+		if(en.fb.alarm && (tripped == 0)) tripped = i;
+	}
+	printf("%-28s %.1f steps max while tracking, %d steps lost at %u, alarm at %u\n",
+		"following error",max_before,BENCH_LOST_STEPS,BENCH_SEGMENTS/2,tripped);
+	_bench_event("FOLLOWING_ERROR_TIME",FOLLOWING_ERROR_TIME);
+}
+
+//_bench_kinematics//
+//input : kinematics model, name
+//output : none
+//fuction : segments through the kinematics stage, one at a time and in batches
+//notes : 
+//additions: 
+//
+static void _bench_kinematics(uint8_t model, const char *name){
+	float target[KN_BATCH_MAX][AXES];
+	float steps[KN_BATCH_MAX][MOTORS];
+	volatile float sink = 0;
+	char label[64];
+	kn_init(model);
+	for(uint8_t i=0; i<KN_BATCH_MAX; ++i){
+		for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+			target[i][axis] = (float)(i+axis);
+		}
+	}
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i){
+		target[0][X_AXIS] = (float)(i & 0xFF);
+		kn_inverse_kinematics(target[0],steps[0]);
+		sink += steps[0][MOTOR_1];
+	}
+	snprintf(label,sizeof(label),"%s segment",name);
+	_bench_stop(label,bn.blocks);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; i+=KN_BATCH_MAX){
+		target[0][X_AXIS] = (float)(i & 0xFF);
+		kn_inverse_kinematics_batch(target,steps,KN_BATCH_MAX);
+		sink += steps[0][MOTOR_1];
+	}
+	snprintf(label,sizeof(label),"%s batch of %d",name,KN_BATCH_MAX);
+	_bench_stop(label,bn.blocks);
+}
+
+//_bench_fastmath//
+//input : none
+//output : none
+//fuction : accuracy sweep of the fastmath kernels against the double libm, then their time
+//against the float libm
+//notes : the sweep steps through the bit patterns of the normal floats so every exponent is
+//covered with a spread of mantissas
+//additions: 
+//
+static void _bench_fastmath(void){
+	double cbrt_error = 0, rsqrt_error = 0;
+	for(uint32_t bits=0x00800000; bits<0x7F000000; bits+=BENCH_SWEEP_STEP){
+		fmBits_t u = {.i = bits};
+		double x = u.f;
+		double error = fabs(fast_cbrtf(u.f)/cbrt(x) - 1);
+		if(error > cbrt_error) cbrt_error = error;
+		error = fabs(fast_rsqrtf(u.f)*sqrt(x) - 1);
+		if(error > rsqrt_error) rsqrt_error = error;
+	}
+	printf("%-28s max relative error %.2e\n","fast_cbrtf",cbrt_error);
+	printf("%-28s max relative error %.2e\n","fast_rsqrtf",rsqrt_error);
+
+	volatile float sink = 0;
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i) sink += cbrtf((float)i + 0.5f);
+	_bench_stop("libm cbrtf",bn.blocks);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i) sink += fast_cbrtf((float)i + 0.5f);
+	_bench_stop("fast_cbrtf",bn.blocks);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i) sink += 1/sqrtf((float)i + 0.5f);
+	_bench_stop("libm 1/sqrtf",bn.blocks);
+	_bench_start();
+	for(uint32_t i=0; i<bn.blocks; ++i) sink += fast_rsqrtf((float)i + 0.5f);
+	_bench_stop("fast_rsqrtf",bn.blocks);
+}
+
+//_bench_parser//
+//input : cam file
+//output : none
+//fuction : parser throughput over a real program, in blocks/sec
+//notes : the file is read into memory first and each block is copied into a scratch buffer
+//since the parser works in place, so only the firmware path is timed
+//additions: 
+//
+static void _bench_parser(const char *path){
+	FILE *in = fopen(path,"r");
+	if(in == NULL){
+		perror(path);
+		return;
+	}
+	char line[BENCH_LINE_SIZE];
+	char block[BENCH_LINE_SIZE];
+	uint32_t count = 0, size = 1024;
+	char (*blocks)[BENCH_LINE_SIZE] = malloc(size*BENCH_LINE_SIZE);
+	while(fgets(line,sizeof(line),in) != NULL){
+		line[strcspn(line,"\r\n")] = NUL;
+		if(count == size){
+			size *= 2;
+			blocks = realloc(blocks,size*BENCH_LINE_SIZE);
+		}
+		memcpy(blocks[count++],line,BENCH_LINE_SIZE);
+	}
+	fclose(in);
+	
+	host_init();
+	_bench_start();
+	for(uint32_t i=0; i<count; ++i){
+		memcpy(block,blocks[i],BENCH_LINE_SIZE);
+		host_block(block,NULL,0);
+	}
+	_bench_stop(path,count);
+	_bench_event("GCODE_PARSER_TIME",GCODE_PARSER_TIME);
+	_bench_event("BLOCK_PREPARE_TIME",BLOCK_PREPARE_TIME);
+	free(blocks);
+}
+
+int main(int argc, char *argv[]){
+	int opt;
+	bn.blocks = BENCH_DEFAULT_BLOCKS;
+	while((opt = getopt(argc,argv,"n:")) != -1){
+		switch(opt){
+			case 'n': bn.blocks = (uint32_t)strtoul(optarg,NULL,10); break;
+			default:
+				fprintf(stderr,"usage: %s [-n blocks] [cam files ...]\n",argv[0]);
+				return 2;
+		}
+	}
+	host_init();
+	_bench_fastmath();
+	_bench_target();
+	host_init();
+	_bench_canonical();
+	host_init();
+	_bench_cutter_comp();
+	host_init();
+	_bench_profile(PROFILE_JERK,"jerk");
+	host_init();
+	_bench_profile(PROFILE_TRAPEZOID,"trapezoid");
+	host_init();
+	_bench_following_error();
+	_bench_kinematics(KINEMATICS_CARTESIAN,"cartesian");
+	_bench_kinematics(KINEMATICS_COREXY,"corexy");
+	kn_init(KINEMATICS_MODEL);
+	for(int i=optind; i<argc; ++i){
+		_bench_parser(argv[i]);
+	}
+	return 0;
+}
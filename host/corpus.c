@@ -0,0 +1,357 @@
+/*
+ * corpus.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * block corpus runner for gc_gcode_parser
+ *
+ * every line of the expected file of a corpus directory names a .nc file and the status its
+ * last block has to return, the blocks before it set the machine up and have to pass. each
+ * file starts from host_init and its blocks go through the canonical machine and the planner
+ * as they do on the target.
+ *	  # comment
+ *	  modal_motion.nc STAT_MODAL_GROUP_VIOLATION
+ * host/corpus/invalid holds the blocks the parser has to refuse, host/corpus/valid blocks that
+ * look like a conflict and aren't, M7 M8 in one block. the run fails on a status that doesn't
+ * match, a file that can't be read or an unknown status name.
+ *
+ * -n runs number words instead, the value _get_number reads for X of a G92 block has to be
+ * the float strtof gives for the same text, bit for bit. the numbers are the edge literals
+ * below, float ties printed with 15 digits and the text either side of them, and random words
+ * of up to 15 significant digits. the seed is fixed so a failure repeats.
+ *
+ * -j jogs X then Y at 600 mm/min from behind the offsets of each set up in corpus_jogs, then
+ * cancels. the jog moves in machine coordinates, every position the canonical machine reaches
+ * has to lie on that path from where it started, and the cancel has to give the offsets and
+ * the coordinate system back.
+ *
+ * build:
+ *	make -C host run_corpus, make -C host check runs both directories
+ *
+ * usage:
+ *	run_corpus [dir]		host/corpus/invalid by default
+ *	run_corpus -n [count]	number words, CORPUS_NUMBERS of each kind by default
+ *	run_corpus -j			jogs
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "gcode_parser.h"
+#include "planner.h"
+#include "util.h"
+
+#define CORPUS_DEFAULT_DIR "host/corpus/invalid"
+#define CORPUS_PATH_SIZE 256
+#define CORPUS_LINE_SIZE 256
+#define CORPUS_STAT(s) {#s,s}
+#define CORPUS_NUMBERS 100000
+#define CORPUS_NUMBER_SIZE 64
+#define CORPUS_NUMBER_SEED 7
+#define CORPUS_NUMBER_DIGITS 15				//NUMBER_DIGITS of gcode_parser.c
+#define CORPUS_JOG_STEPS 64						//jogging callback runs of each vector
+#define CORPUS_JOG_VELOCITY 600.0f			//mm/min
+#define CORPUS_JOG_SEGMENT 0.3f				//mm of a move at it, JOG_SEGMENT_TIME of cycle_jogging.c
+#define CORPUS_JOG_TOLERANCE 0.001f
+
+typedef struct corpusStatus{
+	const char *name;
+	stat_t status;
+}corpusStatus_t;
+
+static const corpusStatus_t corpus_status[] = {
+	CORPUS_STAT(STAT_OK),
+	CORPUS_STAT(STAT_INVALID_CODE_FORM),
+	CORPUS_STAT(STAT_INVALID_NUMBER_FORM),
+	CORPUS_STAT(STAT_INPUT_VALUE_OUT_OF_RANGE),
+	CORPUS_STAT(STAT_UNSUPPORTED_GCODE),
+	CORPUS_STAT(STAT_UNSUPPORTED_MCODE),
+	CORPUS_STAT(STAT_GCODE_FEEDRATE_NOT_SPECIFIED),
+	CORPUS_STAT(STAT_MODAL_GROUP_VIOLATION),
+	CORPUS_STAT(STAT_AXIS_WORD_CONFLICT),
+	CORPUS_STAT(STAT_AXIS_WORDS_WITHOUT_MOTION),
+	CORPUS_STAT(STAT_AXIS_WORDS_MISSING),
+	CORPUS_STAT(STAT_CUTTER_COMP_SPECIFICATION),
+	CORPUS_STAT(STAT_CUTTER_COMP_GOUGE)
+};
+
+static const char *const corpus_numbers[] = {
+	"0","-0","0.0",".5","5.","+1.5","-.25","00000000000001","16777216","16777217","16777216.5",
+	"0.000000000000001","0.0820000059902668","3.4028235","99999999999999.9","0.1","0.2","0.3",
+	"123456789012345","1.00000005960464","0.333333333333333"
+};
+
+static const char *const corpus_jogs[][4] = {
+	{"G92 X100 Y-50"},
+	{"G10 L2 P2 X30 Y40 Z-5","G55","G92 X5 Z2"},
+	{"G10 L1 P1 Z10","T1 M6","G43 H1","G92 Y7"},
+	{"G20","G91","G92 X1"}
+};
+
+//_corpus_status//
+//input : status name
+//output : false for a name the table doesn't have
+//fuction : looks the status up by its name
+//notes :
+//additions:
+//
+static uint8_t _corpus_status(const char *name, stat_t *status){
+	for(uint32_t i=0; i<sizeof(corpus_status)/sizeof(corpus_status[0]); ++i){
+		if(strcmp(name,corpus_status[i].name) == 0){
+			*status = corpus_status[i].status;
+			return true;
+		}
+	}
+	return false;
+}
+
+//_corpus_file//
+//input : path of a .nc file, status of its last block
+//output : 0 when every block returned what it had to
+//fuction : runs the blocks of the file from a fresh machine
+//notes : blank lines are skipped, the parser works in place on its own copy of each line
+//additions:
+//
+static int _corpus_file(const char *path, stat_t expected){
+	FILE *in = fopen(path,"r");
+	if(in == NULL){
+		perror(path);
+		return 1;
+	}
+	host_init();
+	char line[CORPUS_LINE_SIZE];
+	char block[CORPUS_LINE_SIZE];
+	uint32_t linenum = 0;
+	uint32_t last = 0;
+	stat_t status = STAT_OK;
+	int failed = 0;
+	while(fgets(line,sizeof(line),in) != NULL){
+		++linenum;
+		line[strcspn(line,"\r\n")] = NUL;
+		if(line[strspn(line," \t")] == NUL) continue;
+		if(last && (status != STAT_OK) && (status != STAT_NOOP)){		//a set up block failed
+			printf("FAIL %s:%u returned %u, only the last block may fail\n",path,last,status);
+			failed = 1;
+		}
+		strcpy(block,line);
+		status = host_block(block,NULL,0);
+		last = linenum;
+	}
+	fclose(in);
+	if(last == 0){
+		printf("FAIL %s has no block\n",path);
+		return 1;
+	}
+	if(status != expected){
+		printf("FAIL %s:%u returned %u, expected %u\n",path,last,status,expected);
+		failed = 1;
+	}
+	return failed;
+}
+
+//_corpus_number//
+//input : number word text
+//output : 1 when the parser reads it other than strtof, 0 otherwise
+//fuction : reads the text as X of a G92 block and compares the bits with strtof
+//notes : a word the parser refuses counts as a mismatch too, all of the generated ones are valid
+//additions:
+//
+static int _corpus_number(const char *text){
+	char block[CORPUS_LINE_SIZE];
+	snprintf(block,sizeof(block),"G92 X%s",text);
+	stat_t status = gc_gcode_parser(block);
+	if(status != STAT_OK){
+		printf("FAIL X%s returned %u\n",text,status);
+		return 1;
+	}
+	float parsed = cm.gn.target[X_AXIS];
+	float expected = strtof(text,NULL);
+	if(memcmp(&parsed,&expected,sizeof(float)) != 0){
+		printf("FAIL X%s read %.9g, strtof %.9g\n",text,parsed,expected);
+		return 1;
+	}
+	return 0;
+}
+
+//_corpus_numbers//
+//input : words of each generated kind
+//output : number of mismatched words
+//fuction : checks the edge literals, the float ties and random words against strtof
+//notes : a tie is printed with %.15g and nudged a relative 1e-13 either way, the printed text
+//        is what gets compared so the nudge only has to land near the tie
+//additions:
+//
+static uint32_t _corpus_numbers(uint32_t count){
+	char text[CORPUS_NUMBER_SIZE];
+	uint32_t words = 0;
+	uint32_t failed = 0;
+	host_init();
+	srand(CORPUS_NUMBER_SEED);
+	for(uint32_t i=0; i<sizeof(corpus_numbers)/sizeof(corpus_numbers[0]); ++i){
+		failed += _corpus_number(corpus_numbers[i]);
+		words++;
+	}
+	for(uint32_t i=0; i<count; ++i){
+		float below = (float)(rand()%2000000)/(float)(1 + rand()%1000);
+		double tie = ((double)below + (double)nextafterf(below,INFINITY))/2;
+		for(int side=-1; side<=1; ++side){
+			snprintf(text,sizeof(text),"%.15g",tie + side*1e-13*tie);
+			if(strchr(text,'e') != NULL) continue;		//no exponent in a gcode word
+			failed += _corpus_number(text);
+			words++;
+		}
+	}
+	for(uint32_t i=0; i<count; ++i){
+		int digits = 1 + rand()%CORPUS_NUMBER_DIGITS;
+		int fraction = rand()%(digits + 1);
+		char *c = text;
+		if(rand()%2) *c++ = '-';
+		for(int k=0; k<digits; ++k){
+			if((fraction > 0)&&(k == digits - fraction)) *c++ = '.';
+			*c++ = '0' + rand()%10;
+		}
+		*c = NUL;
+		failed += _corpus_number(text);
+		words++;
+	}
+	printf("%u numbers, %u failed\n",words,failed);
+	return failed;
+}
+
+//_corpus_jog_steps//
+//input : jog start position, vector the jog runs along, bound of the travel along the others
+//output : 1 when a position left the path, 0 otherwise
+//fuction : runs the jogging callback, retiring a queued move whenever it has nothing to queue
+//notes : the moves a turn drops take the position back along the path, never off it
+//additions:
+//
+static int _corpus_jog_steps(const float start[], uint8_t along, float travel[]){
+	for(uint32_t i=0; i<CORPUS_JOG_STEPS; ++i){
+		if((cm_jogging_callback() == STAT_NOOP) && (mp_get_run_buffer() != NULL)){
+			mp_free_run_buffer();
+		}
+		for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+			float moved = cm.position[axis] - start[axis];
+			float bound = (axis == along)? CORPUS_JOG_STEPS*CORPUS_JOG_SEGMENT : travel[axis];
+			if((moved < -CORPUS_JOG_TOLERANCE) || (moved > bound + CORPUS_JOG_TOLERANCE)){
+				printf("FAIL jog along %u, axis %u at %g from %g\n",along,axis,cm.position[axis],start[axis]);
+				return 1;
+			}
+		}
+	}
+	travel[along] = cm.position[along] - start[along];
+	return 0;
+}
+
+//_corpus_jog//
+//input : set up blocks, NULL ended
+//output : 0 when the jog stayed on its path and gave the model back
+//fuction : jogs X then Y behind the set up and cancels
+//notes :
+//additions:
+//
+static int _corpus_jog(const char *const setup[]){
+	char block[CORPUS_LINE_SIZE];
+	float start[AXES];
+	float offset[AXES];
+	float travel[AXES] = {0};
+	host_init();
+	for(uint32_t i=0; (i<4) && (setup[i] != NULL); ++i){
+		strcpy(block,setup[i]);
+		if(host_block(block,NULL,0) != STAT_OK){
+			printf("FAIL jog set up %s\n",setup[i]);
+			return 1;
+		}
+	}
+	while(mp_get_run_buffer() != NULL){		//a jog only starts on a stopped machine
+		mp_free_run_buffer();
+	}
+	copy_vector(start,cm.position);
+	copy_vector(offset,cm.active_offset);
+	uint8_t coord_system = cm.gm.coordinate_system;
+	uint8_t distance_mode = cm.gm.distance_mode;
+	float velocity = (cm.gm.units_mode == INCHES)? CORPUS_JOG_VELOCITY/MM_PER_INCH : CORPUS_JOG_VELOCITY;
+	for(uint8_t along=X_AXIS; along<=Y_AXIS; ++along){
+		snprintf(block,sizeof(block),"$J %c%.9g",'X'+along,velocity);
+		if(host_block(block,NULL,0) != STAT_OK){
+			printf("FAIL jog %s after %s\n",block,setup[0]);
+			return 1;
+		}
+		if(_corpus_jog_steps(start,along,travel) != 0){
+			printf("FAIL jog after %s\n",setup[0]);
+			return 1;
+		}
+		if(travel[along] < CORPUS_JOG_SEGMENT){
+			printf("FAIL jog after %s didn't move along %u\n",setup[0],along);
+			return 1;
+		}
+	}
+	strcpy(block,"$J");
+	host_block(block,NULL,0);
+	for(uint32_t i=0; (i<CORPUS_JOG_STEPS) && (cm.cycle_state == CYCLE_JOG); ++i){
+		while(mp_get_run_buffer() != NULL){
+			mp_free_run_buffer();
+		}
+		cm_jogging_callback();
+	}
+	if((cm.cycle_state != CYCLE_OFF) || (cm.gm.absolute_override != false) ||
+		 (cm.gm.coordinate_system != coord_system) || (cm.gm.distance_mode != distance_mode) ||
+		 (memcmp(offset,cm.active_offset,sizeof(offset)) != 0)){
+		printf("FAIL jog after %s didn't give the model back\n",setup[0]);
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[]){
+	if((argc > 1)&&(strcmp(argv[1],"-n") == 0)){
+		uint32_t count = (argc > 2)? (uint32_t)strtoul(argv[2],NULL,10) : CORPUS_NUMBERS;
+		return _corpus_numbers(count) != 0;
+	}
+	if((argc > 1)&&(strcmp(argv[1],"-j") == 0)){
+		uint32_t jogs = sizeof(corpus_jogs)/sizeof(corpus_jogs[0]);
+		uint32_t failed = 0;
+		for(uint32_t i=0; i<jogs; ++i){
+			failed += _corpus_jog(corpus_jogs[i]);
+		}
+		printf("%u jogs, %u failed\n",jogs,failed);
+		return failed != 0;
+	}
+	const char *dir = (argc > 1)? argv[1] : CORPUS_DEFAULT_DIR;
+	char path[CORPUS_PATH_SIZE];
+	snprintf(path,sizeof(path),"%s/expected",dir);
+	FILE *list = fopen(path,"r");
+	if(list == NULL){
+		perror(path);
+		return 2;
+	}
+	char line[CORPUS_LINE_SIZE];
+	uint32_t files = 0;
+	uint32_t failed = 0;
+	while(fgets(line,sizeof(line),list) != NULL){
+		char name[CORPUS_LINE_SIZE];
+		char status_name[CORPUS_LINE_SIZE];
+		if((line[0] == '#') || (sscanf(line,"%255s %255s",name,status_name) != 2)) continue;
+		stat_t expected;
+		if(_corpus_status(status_name,&expected) == false){
+			printf("FAIL %s, unknown status %s\n",name,status_name);
+			failed++;
+			continue;
+		}
+		snprintf(path,sizeof(path),"%s/%s",dir,name);
+		files++;
+		if(_corpus_file(path,expected) != 0) failed++;
+	}
+	fclose(list);
+	printf("%u files, %u failed\n",files,failed);
+	return (failed != 0) || (files == 0);
+}
@@ -0,0 +1 @@
+G1 G92 X0
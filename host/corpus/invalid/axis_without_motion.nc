@@ -0,0 +1,2 @@
+G80
+X10
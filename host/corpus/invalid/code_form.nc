@@ -0,0 +1 @@
+10 G1
@@ -0,0 +1,5 @@
+F1000
+G41.1 D4
+G1 X20
+G1 Y20
+G1 X19
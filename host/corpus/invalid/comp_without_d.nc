@@ -0,0 +1 @@
+G41.1
@@ -0,0 +1 @@
+G4 P-1 G17
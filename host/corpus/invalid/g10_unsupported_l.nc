@@ -0,0 +1 @@
+G10 L3 P1 X0
@@ -0,0 +1 @@
+G92
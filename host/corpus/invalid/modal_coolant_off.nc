@@ -0,0 +1 @@
+M7 M9
@@ -0,0 +1 @@
+G90 G91
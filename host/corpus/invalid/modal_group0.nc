@@ -0,0 +1 @@
+G4 P1 G92 X0
@@ -0,0 +1 @@
+G0 G1 X1
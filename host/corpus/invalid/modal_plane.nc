@@ -0,0 +1 @@
+G17 G18
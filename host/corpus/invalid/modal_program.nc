@@ -0,0 +1 @@
+M0 M2
@@ -0,0 +1 @@
+M3 M4
@@ -0,0 +1 @@
+G20 G21
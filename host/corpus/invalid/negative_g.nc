@@ -0,0 +1 @@
+G-1
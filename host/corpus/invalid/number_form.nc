@@ -0,0 +1 @@
+G1 X10 F100 XY
@@ -0,0 +1 @@
+G43 H99
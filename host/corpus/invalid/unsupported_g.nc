@@ -0,0 +1 @@
+G7
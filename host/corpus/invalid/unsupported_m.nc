@@ -0,0 +1 @@
+M99
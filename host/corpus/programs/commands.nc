@@ -0,0 +1,19 @@
+G21 G90 G17
+F1000
+G1 X10 M3 M8
+G4 P0.5
+G93 G1 X20 F2
+G1 X30 F4
+G94 F800
+G1 Y10
+G92 X0
+G2 X10 Y10 I5 J0
+M9
+G1 X40 S1200
+M7
+G3 X0 Y10 I-20 J0
+G92.1
+G0 Z5
+G0 X0 Y0
+M5
+M2
@@ -0,0 +1,553 @@
+G17 G21 G90 G94
+G0 Z5
+G0 X0 Y0
+G1 Z-1.0 F300
+G1 X98.000 Y0.000 F1200
+G3 X100.000 Y2.000 I0 J2.000
+G1 Y58.000
+G3 X98.000 Y60.000 I-2.000 J0
+G1 X2.000
+G3 X0.000 Y58.000 I0 J-2.000
+G1 Y4.000
+G3 X2.000 Y2.000 I2.000 J0
+G1 X2.000 Y2.000
+G1 X96.000 Y2.000 F1200
+G3 X98.000 Y4.000 I0 J2.000
+G1 Y56.000
+G3 X96.000 Y58.000 I-2.000 J0
+G1 X4.000
+G3 X2.000 Y56.000 I0 J-2.000
+G1 Y6.000
+G3 X4.000 Y4.000 I2.000 J0
+G1 X4.000 Y4.000
+G1 X94.000 Y4.000 F1200
+G3 X96.000 Y6.000 I0 J2.000
+G1 Y54.000
+G3 X94.000 Y56.000 I-2.000 J0
+G1 X6.000
+G3 X4.000 Y54.000 I0 J-2.000
+G1 Y8.000
+G3 X6.000 Y6.000 I2.000 J0
+G1 X6.000 Y6.000
+G1 X92.000 Y6.000 F1200
+G3 X94.000 Y8.000 I0 J2.000
+G1 Y52.000
+G3 X92.000 Y54.000 I-2.000 J0
+G1 X8.000
+G3 X6.000 Y52.000 I0 J-2.000
+G1 Y10.000
+G3 X8.000 Y8.000 I2.000 J0
+G1 X8.000 Y8.000
+G1 X90.000 Y8.000 F1200
+G3 X92.000 Y10.000 I0 J2.000
+G1 Y50.000
+G3 X90.000 Y52.000 I-2.000 J0
+G1 X10.000
+G3 X8.000 Y50.000 I0 J-2.000
+G1 Y12.000
+G3 X10.000 Y10.000 I2.000 J0
+G1 X10.000 Y10.000
+G1 X88.000 Y10.000 F1200
+G3 X90.000 Y12.000 I0 J2.000
+G1 Y48.000
+G3 X88.000 Y50.000 I-2.000 J0
+G1 X12.000
+G3 X10.000 Y48.000 I0 J-2.000
+G1 Y14.000
+G3 X12.000 Y12.000 I2.000 J0
+G1 X12.000 Y12.000
+G1 X86.000 Y12.000 F1200
+G3 X88.000 Y14.000 I0 J2.000
+G1 Y46.000
+G3 X86.000 Y48.000 I-2.000 J0
+G1 X14.000
+G3 X12.000 Y46.000 I0 J-2.000
+G1 Y16.000
+G3 X14.000 Y14.000 I2.000 J0
+G1 X14.000 Y14.000
+G1 X84.000 Y14.000 F1200
+G3 X86.000 Y16.000 I0 J2.000
+G1 Y44.000
+G3 X84.000 Y46.000 I-2.000 J0
+G1 X16.000
+G3 X14.000 Y44.000 I0 J-2.000
+G1 Y18.000
+G3 X16.000 Y16.000 I2.000 J0
+G1 X16.000 Y16.000
+G1 X82.000 Y16.000 F1200
+G3 X84.000 Y18.000 I0 J2.000
+G1 Y42.000
+G3 X82.000 Y44.000 I-2.000 J0
+G1 X18.000
+G3 X16.000 Y42.000 I0 J-2.000
+G1 Y20.000
+G3 X18.000 Y18.000 I2.000 J0
+G1 X18.000 Y18.000
+G1 X80.000 Y18.000 F1200
+G3 X82.000 Y20.000 I0 J2.000
+G1 Y40.000
+G3 X80.000 Y42.000 I-2.000 J0
+G1 X20.000
+G3 X18.000 Y40.000 I0 J-2.000
+G1 Y22.000
+G3 X20.000 Y20.000 I2.000 J0
+G1 X20.000 Y20.000
+G1 X78.000 Y20.000 F1200
+G3 X80.000 Y22.000 I0 J2.000
+G1 Y38.000
+G3 X78.000 Y40.000 I-2.000 J0
+G1 X22.000
+G3 X20.000 Y38.000 I0 J-2.000
+G1 Y24.000
+G3 X22.000 Y22.000 I2.000 J0
+G1 X22.000 Y22.000
+G1 X76.000 Y22.000 F1200
+G3 X78.000 Y24.000 I0 J2.000
+G1 Y36.000
+G3 X76.000 Y38.000 I-2.000 J0
+G1 X24.000
+G3 X22.000 Y36.000 I0 J-2.000
+G1 Y26.000
+G3 X24.000 Y24.000 I2.000 J0
+G1 X24.000 Y24.000
+G1 X74.000 Y24.000 F1200
+G3 X76.000 Y26.000 I0 J2.000
+G1 Y34.000
+G3 X74.000 Y36.000 I-2.000 J0
+G1 X26.000
+G3 X24.000 Y34.000 I0 J-2.000
+G1 Y28.000
+G3 X26.000 Y26.000 I2.000 J0
+G1 X26.000 Y26.000
+G1 X72.000 Y26.000 F1200
+G3 X74.000 Y28.000 I0 J2.000
+G1 Y32.000
+G3 X72.000 Y34.000 I-2.000 J0
+G1 X28.000
+G3 X26.000 Y32.000 I0 J-2.000
+G1 Y30.000
+G3 X28.000 Y28.000 I2.000 J0
+G1 X28.000 Y28.000
+G1 X70.000 Y28.000 F1200
+G3 X72.000 Y30.000 I0 J2.000
+G1 Y30.000
+G3 X70.000 Y32.000 I-2.000 J0
+G1 X30.000
+G3 X28.000 Y30.000 I0 J-2.000
+G1 Y32.000
+G3 X30.000 Y30.000 I2.000 J0
+G1 X30.000 Y30.000
+G1 X68.000 Y30.000 F1200
+G3 X70.000 Y32.000 I0 J2.000
+G1 Y28.000
+G3 X68.000 Y30.000 I-2.000 J0
+G1 X32.000
+G3 X30.000 Y28.000 I0 J-2.000
+G1 Y34.000
+G3 X32.000 Y32.000 I2.000 J0
+G1 X32.000 Y32.000
+G1 X66.000 Y32.000 F1200
+G3 X68.000 Y34.000 I0 J2.000
+G1 Y26.000
+G3 X66.000 Y28.000 I-2.000 J0
+G1 X34.000
+G3 X32.000 Y26.000 I0 J-2.000
+G1 Y36.000
+G3 X34.000 Y34.000 I2.000 J0
+G1 X34.000 Y34.000
+G1 X64.000 Y34.000 F1200
+G3 X66.000 Y36.000 I0 J2.000
+G1 Y24.000
+G3 X64.000 Y26.000 I-2.000 J0
+G1 X36.000
+G3 X34.000 Y24.000 I0 J-2.000
+G1 Y38.000
+G3 X36.000 Y36.000 I2.000 J0
+G1 X36.000 Y36.000
+G1 X62.000 Y36.000 F1200
+G3 X64.000 Y38.000 I0 J2.000
+G1 Y22.000
+G3 X62.000 Y24.000 I-2.000 J0
+G1 X38.000
+G3 X36.000 Y22.000 I0 J-2.000
+G1 Y40.000
+G3 X38.000 Y38.000 I2.000 J0
+G1 X38.000 Y38.000
+G1 X60.000 Y38.000 F1200
+G3 X62.000 Y40.000 I0 J2.000
+G1 Y20.000
+G3 X60.000 Y22.000 I-2.000 J0
+G1 X40.000
+G3 X38.000 Y20.000 I0 J-2.000
+G1 Y42.000
+G3 X40.000 Y40.000 I2.000 J0
+G1 X40.000 Y40.000
+G0 Z5
+G0 X0 Y0
+G1 Z-2.0 F300
+G1 X98.000 Y0.000 F1200
+G3 X100.000 Y2.000 I0 J2.000
+G1 Y58.000
+G3 X98.000 Y60.000 I-2.000 J0
+G1 X2.000
+G3 X0.000 Y58.000 I0 J-2.000
+G1 Y4.000
+G3 X2.000 Y2.000 I2.000 J0
+G1 X2.000 Y2.000
+G1 X96.000 Y2.000 F1200
+G3 X98.000 Y4.000 I0 J2.000
+G1 Y56.000
+G3 X96.000 Y58.000 I-2.000 J0
+G1 X4.000
+G3 X2.000 Y56.000 I0 J-2.000
+G1 Y6.000
+G3 X4.000 Y4.000 I2.000 J0
+G1 X4.000 Y4.000
+G1 X94.000 Y4.000 F1200
+G3 X96.000 Y6.000 I0 J2.000
+G1 Y54.000
+G3 X94.000 Y56.000 I-2.000 J0
+G1 X6.000
+G3 X4.000 Y54.000 I0 J-2.000
+G1 Y8.000
+G3 X6.000 Y6.000 I2.000 J0
+G1 X6.000 Y6.000
+G1 X92.000 Y6.000 F1200
+G3 X94.000 Y8.000 I0 J2.000
+G1 Y52.000
+G3 X92.000 Y54.000 I-2.000 J0
+G1 X8.000
+G3 X6.000 Y52.000 I0 J-2.000
+G1 Y10.000
+G3 X8.000 Y8.000 I2.000 J0
+G1 X8.000 Y8.000
+G1 X90.000 Y8.000 F1200
+G3 X92.000 Y10.000 I0 J2.000
+G1 Y50.000
+G3 X90.000 Y52.000 I-2.000 J0
+G1 X10.000
+G3 X8.000 Y50.000 I0 J-2.000
+G1 Y12.000
+G3 X10.000 Y10.000 I2.000 J0
+G1 X10.000 Y10.000
+G1 X88.000 Y10.000 F1200
+G3 X90.000 Y12.000 I0 J2.000
+G1 Y48.000
+G3 X88.000 Y50.000 I-2.000 J0
+G1 X12.000
+G3 X10.000 Y48.000 I0 J-2.000
+G1 Y14.000
+G3 X12.000 Y12.000 I2.000 J0
+G1 X12.000 Y12.000
+G1 X86.000 Y12.000 F1200
+G3 X88.000 Y14.000 I0 J2.000
+G1 Y46.000
+G3 X86.000 Y48.000 I-2.000 J0
+G1 X14.000
+G3 X12.000 Y46.000 I0 J-2.000
+G1 Y16.000
+G3 X14.000 Y14.000 I2.000 J0
+G1 X14.000 Y14.000
+G1 X84.000 Y14.000 F1200
+G3 X86.000 Y16.000 I0 J2.000
+G1 Y44.000
+G3 X84.000 Y46.000 I-2.000 J0
+G1 X16.000
+G3 X14.000 Y44.000 I0 J-2.000
+G1 Y18.000
+G3 X16.000 Y16.000 I2.000 J0
+G1 X16.000 Y16.000
+G1 X82.000 Y16.000 F1200
+G3 X84.000 Y18.000 I0 J2.000
+G1 Y42.000
+G3 X82.000 Y44.000 I-2.000 J0
+G1 X18.000
+G3 X16.000 Y42.000 I0 J-2.000
+G1 Y20.000
+G3 X18.000 Y18.000 I2.000 J0
+G1 X18.000 Y18.000
+G1 X80.000 Y18.000 F1200
+G3 X82.000 Y20.000 I0 J2.000
+G1 Y40.000
+G3 X80.000 Y42.000 I-2.000 J0
+G1 X20.000
+G3 X18.000 Y40.000 I0 J-2.000
+G1 Y22.000
+G3 X20.000 Y20.000 I2.000 J0
+G1 X20.000 Y20.000
+G1 X78.000 Y20.000 F1200
+G3 X80.000 Y22.000 I0 J2.000
+G1 Y38.000
+G3 X78.000 Y40.000 I-2.000 J0
+G1 X22.000
+G3 X20.000 Y38.000 I0 J-2.000
+G1 Y24.000
+G3 X22.000 Y22.000 I2.000 J0
+G1 X22.000 Y22.000
+G1 X76.000 Y22.000 F1200
+G3 X78.000 Y24.000 I0 J2.000
+G1 Y36.000
+G3 X76.000 Y38.000 I-2.000 J0
+G1 X24.000
+G3 X22.000 Y36.000 I0 J-2.000
+G1 Y26.000
+G3 X24.000 Y24.000 I2.000 J0
+G1 X24.000 Y24.000
+G1 X74.000 Y24.000 F1200
+G3 X76.000 Y26.000 I0 J2.000
+G1 Y34.000
+G3 X74.000 Y36.000 I-2.000 J0
+G1 X26.000
+G3 X24.000 Y34.000 I0 J-2.000
+G1 Y28.000
+G3 X26.000 Y26.000 I2.000 J0
+G1 X26.000 Y26.000
+G1 X72.000 Y26.000 F1200
+G3 X74.000 Y28.000 I0 J2.000
+G1 Y32.000
+G3 X72.000 Y34.000 I-2.000 J0
+G1 X28.000
+G3 X26.000 Y32.000 I0 J-2.000
+G1 Y30.000
+G3 X28.000 Y28.000 I2.000 J0
+G1 X28.000 Y28.000
+G1 X70.000 Y28.000 F1200
+G3 X72.000 Y30.000 I0 J2.000
+G1 Y30.000
+G3 X70.000 Y32.000 I-2.000 J0
+G1 X30.000
+G3 X28.000 Y30.000 I0 J-2.000
+G1 Y32.000
+G3 X30.000 Y30.000 I2.000 J0
+G1 X30.000 Y30.000
+G1 X68.000 Y30.000 F1200
+G3 X70.000 Y32.000 I0 J2.000
+G1 Y28.000
+G3 X68.000 Y30.000 I-2.000 J0
+G1 X32.000
+G3 X30.000 Y28.000 I0 J-2.000
+G1 Y34.000
+G3 X32.000 Y32.000 I2.000 J0
+G1 X32.000 Y32.000
+G1 X66.000 Y32.000 F1200
+G3 X68.000 Y34.000 I0 J2.000
+G1 Y26.000
+G3 X66.000 Y28.000 I-2.000 J0
+G1 X34.000
+G3 X32.000 Y26.000 I0 J-2.000
+G1 Y36.000
+G3 X34.000 Y34.000 I2.000 J0
+G1 X34.000 Y34.000
+G1 X64.000 Y34.000 F1200
+G3 X66.000 Y36.000 I0 J2.000
+G1 Y24.000
+G3 X64.000 Y26.000 I-2.000 J0
+G1 X36.000
+G3 X34.000 Y24.000 I0 J-2.000
+G1 Y38.000
+G3 X36.000 Y36.000 I2.000 J0
+G1 X36.000 Y36.000
+G1 X62.000 Y36.000 F1200
+G3 X64.000 Y38.000 I0 J2.000
+G1 Y22.000
+G3 X62.000 Y24.000 I-2.000 J0
+G1 X38.000
+G3 X36.000 Y22.000 I0 J-2.000
+G1 Y40.000
+G3 X38.000 Y38.000 I2.000 J0
+G1 X38.000 Y38.000
+G1 X60.000 Y38.000 F1200
+G3 X62.000 Y40.000 I0 J2.000
+G1 Y20.000
+G3 X60.000 Y22.000 I-2.000 J0
+G1 X40.000
+G3 X38.000 Y20.000 I0 J-2.000
+G1 Y42.000
+G3 X40.000 Y40.000 I2.000 J0
+G1 X40.000 Y40.000
+G0 Z5
+G0 X0 Y0
+G1 Z-3.0 F300
+G1 X98.000 Y0.000 F1200
+G3 X100.000 Y2.000 I0 J2.000
+G1 Y58.000
+G3 X98.000 Y60.000 I-2.000 J0
+G1 X2.000
+G3 X0.000 Y58.000 I0 J-2.000
+G1 Y4.000
+G3 X2.000 Y2.000 I2.000 J0
+G1 X2.000 Y2.000
+G1 X96.000 Y2.000 F1200
+G3 X98.000 Y4.000 I0 J2.000
+G1 Y56.000
+G3 X96.000 Y58.000 I-2.000 J0
+G1 X4.000
+G3 X2.000 Y56.000 I0 J-2.000
+G1 Y6.000
+G3 X4.000 Y4.000 I2.000 J0
+G1 X4.000 Y4.000
+G1 X94.000 Y4.000 F1200
+G3 X96.000 Y6.000 I0 J2.000
+G1 Y54.000
+G3 X94.000 Y56.000 I-2.000 J0
+G1 X6.000
+G3 X4.000 Y54.000 I0 J-2.000
+G1 Y8.000
+G3 X6.000 Y6.000 I2.000 J0
+G1 X6.000 Y6.000
+G1 X92.000 Y6.000 F1200
+G3 X94.000 Y8.000 I0 J2.000
+G1 Y52.000
+G3 X92.000 Y54.000 I-2.000 J0
+G1 X8.000
+G3 X6.000 Y52.000 I0 J-2.000
+G1 Y10.000
+G3 X8.000 Y8.000 I2.000 J0
+G1 X8.000 Y8.000
+G1 X90.000 Y8.000 F1200
+G3 X92.000 Y10.000 I0 J2.000
+G1 Y50.000
+G3 X90.000 Y52.000 I-2.000 J0
+G1 X10.000
+G3 X8.000 Y50.000 I0 J-2.000
+G1 Y12.000
+G3 X10.000 Y10.000 I2.000 J0
+G1 X10.000 Y10.000
+G1 X88.000 Y10.000 F1200
+G3 X90.000 Y12.000 I0 J2.000
+G1 Y48.000
+G3 X88.000 Y50.000 I-2.000 J0
+G1 X12.000
+G3 X10.000 Y48.000 I0 J-2.000
+G1 Y14.000
+G3 X12.000 Y12.000 I2.000 J0
+G1 X12.000 Y12.000
+G1 X86.000 Y12.000 F1200
+G3 X88.000 Y14.000 I0 J2.000
+G1 Y46.000
+G3 X86.000 Y48.000 I-2.000 J0
+G1 X14.000
+G3 X12.000 Y46.000 I0 J-2.000
+G1 Y16.000
+G3 X14.000 Y14.000 I2.000 J0
+G1 X14.000 Y14.000
+G1 X84.000 Y14.000 F1200
+G3 X86.000 Y16.000 I0 J2.000
+G1 Y44.000
+G3 X84.000 Y46.000 I-2.000 J0
+G1 X16.000
+G3 X14.000 Y44.000 I0 J-2.000
+G1 Y18.000
+G3 X16.000 Y16.000 I2.000 J0
+G1 X16.000 Y16.000
+G1 X82.000 Y16.000 F1200
+G3 X84.000 Y18.000 I0 J2.000
+G1 Y42.000
+G3 X82.000 Y44.000 I-2.000 J0
+G1 X18.000
+G3 X16.000 Y42.000 I0 J-2.000
+G1 Y20.000
+G3 X18.000 Y18.000 I2.000 J0
+G1 X18.000 Y18.000
+G1 X80.000 Y18.000 F1200
+G3 X82.000 Y20.000 I0 J2.000
+G1 Y40.000
+G3 X80.000 Y42.000 I-2.000 J0
+G1 X20.000
+G3 X18.000 Y40.000 I0 J-2.000
+G1 Y22.000
+G3 X20.000 Y20.000 I2.000 J0
+G1 X20.000 Y20.000
+G1 X78.000 Y20.000 F1200
+G3 X80.000 Y22.000 I0 J2.000
+G1 Y38.000
+G3 X78.000 Y40.000 I-2.000 J0
+G1 X22.000
+G3 X20.000 Y38.000 I0 J-2.000
+G1 Y24.000
+G3 X22.000 Y22.000 I2.000 J0
+G1 X22.000 Y22.000
+G1 X76.000 Y22.000 F1200
+G3 X78.000 Y24.000 I0 J2.000
+G1 Y36.000
+G3 X76.000 Y38.000 I-2.000 J0
+G1 X24.000
+G3 X22.000 Y36.000 I0 J-2.000
+G1 Y26.000
+G3 X24.000 Y24.000 I2.000 J0
+G1 X24.000 Y24.000
+G1 X74.000 Y24.000 F1200
+G3 X76.000 Y26.000 I0 J2.000
+G1 Y34.000
+G3 X74.000 Y36.000 I-2.000 J0
+G1 X26.000
+G3 X24.000 Y34.000 I0 J-2.000
+G1 Y28.000
+G3 X26.000 Y26.000 I2.000 J0
+G1 X26.000 Y26.000
+G1 X72.000 Y26.000 F1200
+G3 X74.000 Y28.000 I0 J2.000
+G1 Y32.000
+G3 X72.000 Y34.000 I-2.000 J0
+G1 X28.000
+G3 X26.000 Y32.000 I0 J-2.000
+G1 Y30.000
+G3 X28.000 Y28.000 I2.000 J0
+G1 X28.000 Y28.000
+G1 X70.000 Y28.000 F1200
+G3 X72.000 Y30.000 I0 J2.000
+G1 Y30.000
+G3 X70.000 Y32.000 I-2.000 J0
+G1 X30.000
+G3 X28.000 Y30.000 I0 J-2.000
+G1 Y32.000
+G3 X30.000 Y30.000 I2.000 J0
+G1 X30.000 Y30.000
+G1 X68.000 Y30.000 F1200
+G3 X70.000 Y32.000 I0 J2.000
+G1 Y28.000
+G3 X68.000 Y30.000 I-2.000 J0
+G1 X32.000
+G3 X30.000 Y28.000 I0 J-2.000
+G1 Y34.000
+G3 X32.000 Y32.000 I2.000 J0
+G1 X32.000 Y32.000
+G1 X66.000 Y32.000 F1200
+G3 X68.000 Y34.000 I0 J2.000
+G1 Y26.000
+G3 X66.000 Y28.000 I-2.000 J0
+G1 X34.000
+G3 X32.000 Y26.000 I0 J-2.000
+G1 Y36.000
+G3 X34.000 Y34.000 I2.000 J0
+G1 X34.000 Y34.000
+G1 X64.000 Y34.000 F1200
+G3 X66.000 Y36.000 I0 J2.000
+G1 Y24.000
+G3 X64.000 Y26.000 I-2.000 J0
+G1 X36.000
+G3 X34.000 Y24.000 I0 J-2.000
+G1 Y38.000
+G3 X36.000 Y36.000 I2.000 J0
+G1 X36.000 Y36.000
+G1 X62.000 Y36.000 F1200
+G3 X64.000 Y38.000 I0 J2.000
+G1 Y22.000
+G3 X62.000 Y24.000 I-2.000 J0
+G1 X38.000
+G3 X36.000 Y22.000 I0 J-2.000
+G1 Y40.000
+G3 X38.000 Y38.000 I2.000 J0
+G1 X38.000 Y38.000
+G1 X60.000 Y38.000 F1200
+G3 X62.000 Y40.000 I0 J2.000
+G1 Y20.000
+G3 X60.000 Y22.000 I-2.000 J0
+G1 X40.000
+G3 X38.000 Y20.000 I0 J-2.000
+G1 Y42.000
+G3 X40.000 Y40.000 I2.000 J0
+G1 X40.000 Y40.000
+G0 Z5
+G0 X0 Y0
+M2
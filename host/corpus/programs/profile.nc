@@ -0,0 +1,914 @@
+G17 G21 G90 G94
+G0 Z5
+G0 X0 Y0
+G1 Z-1 F300
+F2000
+G1 X73.000 Y40.000
+G1 X72.990 Y40.534
+G1 X72.961 Y41.067
+G1 X72.913 Y41.597
+G1 X72.846 Y42.123
+G1 X72.760 Y42.645
+G1 X72.655 Y43.161
+G1 X72.533 Y43.670
+G1 X72.394 Y44.171
+G1 X72.237 Y44.662
+G1 X72.065 Y45.143
+G1 X71.878 Y45.613
+G1 X71.676 Y46.072
+G1 X71.460 Y46.517
+G1 X71.232 Y46.949
+G1 X70.993 Y47.366
+G1 X70.742 Y47.769
+G1 X70.483 Y48.156
+G1 X70.215 Y48.527
+G1 X69.939 Y48.882
+G1 X69.658 Y49.221
+G1 X69.372 Y49.543
+G1 X69.082 Y49.848
+G1 X68.789 Y50.136
+G1 X68.495 Y50.408
+G1 X68.201 Y50.662
+G1 X67.908 Y50.901
+G1 X67.617 Y51.123
+G1 X67.330 Y51.330
+G1 X67.046 Y51.521
+G1 X66.768 Y51.698
+G1 X66.497 Y51.860
+G1 X66.232 Y52.009
+G1 X65.976 Y52.146
+G1 X65.729 Y52.271
+G1 X65.491 Y52.385
+G1 X65.264 Y52.489
+G1 X65.048 Y52.584
+G1 X64.844 Y52.671
+G1 X64.652 Y52.751
+G1 X64.472 Y52.826
+G1 X64.305 Y52.896
+G1 X64.151 Y52.962
+G1 X64.010 Y53.026
+G1 X63.882 Y53.088
+G1 X63.767 Y53.150
+G1 X63.665 Y53.214
+G1 X63.576 Y53.279
+G1 X63.500 Y53.348
+G1 X63.435 Y53.421
+G1 X63.383 Y53.500
+G1 X63.341 Y53.585
+G1 X63.310 Y53.677
+G1 X63.288 Y53.778
+G1 X63.276 Y53.888
+G1 X63.272 Y54.008
+G1 X63.275 Y54.138
+G1 X63.285 Y54.280
+G1 X63.301 Y54.434
+G1 X63.320 Y54.601
+G1 X63.343 Y54.780
+G1 X63.369 Y54.973
+G1 X63.396 Y55.180
+G1 X63.422 Y55.401
+G1 X63.448 Y55.635
+G1 X63.471 Y55.884
+G1 X63.491 Y56.146
+G1 X63.507 Y56.423
+G1 X63.517 Y56.713
+G1 X63.520 Y57.017
+G1 X63.515 Y57.333
+G1 X63.501 Y57.662
+G1 X63.477 Y58.003
+G1 X63.441 Y58.356
+G1 X63.394 Y58.719
+G1 X63.335 Y59.092
+G1 X63.261 Y59.474
+G1 X63.173 Y59.864
+G1 X63.069 Y60.262
+G1 X62.950 Y60.665
+G1 X62.815 Y61.074
+G1 X62.662 Y61.487
+G1 X62.492 Y61.903
+G1 X62.305 Y62.321
+G1 X62.099 Y62.739
+G1 X61.876 Y63.157
+G1 X61.634 Y63.574
+G1 X61.374 Y63.987
+G1 X61.096 Y64.396
+G1 X60.800 Y64.800
+G1 X60.487 Y65.198
+G1 X60.156 Y65.587
+G1 X59.809 Y65.968
+G1 X59.445 Y66.340
+G1 X59.065 Y66.700
+G1 X58.671 Y67.048
+G1 X58.262 Y67.383
+G1 X57.839 Y67.705
+G1 X57.404 Y68.012
+G1 X56.957 Y68.304
+G1 X56.500 Y68.579
+G1 X56.033 Y68.837
+G1 X55.557 Y69.079
+G1 X55.074 Y69.302
+G1 X54.584 Y69.507
+G1 X54.089 Y69.693
+G1 X53.590 Y69.861
+G1 X53.088 Y70.009
+G1 X52.585 Y70.139
+G1 X52.081 Y70.249
+G1 X51.578 Y70.341
+G1 X51.077 Y70.414
+G1 X50.580 Y70.468
+G1 X50.086 Y70.504
+G1 X49.598 Y70.522
+G1 X49.117 Y70.523
+G1 X48.643 Y70.508
+G1 X48.178 Y70.477
+G1 X47.723 Y70.430
+G1 X47.277 Y70.369
+G1 X46.843 Y70.295
+G1 X46.422 Y70.208
+G1 X46.012 Y70.109
+G1 X45.616 Y70.000
+G1 X45.234 Y69.881
+G1 X44.867 Y69.754
+G1 X44.514 Y69.620
+G1 X44.176 Y69.479
+G1 X43.853 Y69.333
+G1 X43.546 Y69.183
+G1 X43.254 Y69.031
+G1 X42.977 Y68.877
+G1 X42.716 Y68.723
+G1 X42.469 Y68.569
+G1 X42.237 Y68.417
+G1 X42.020 Y68.269
+G1 X41.816 Y68.124
+G1 X41.626 Y67.985
+G1 X41.448 Y67.851
+G1 X41.283 Y67.725
+G1 X41.128 Y67.606
+G1 X40.985 Y67.496
+G1 X40.850 Y67.396
+G1 X40.724 Y67.306
+G1 X40.606 Y67.226
+G1 X40.495 Y67.158
+G1 X40.389 Y67.102
+G1 X40.288 Y67.057
+G1 X40.190 Y67.026
+G1 X40.094 Y67.006
+G1 X40.000 Y67.000
+G1 X39.906 Y67.006
+G1 X39.810 Y67.026
+G1 X39.712 Y67.057
+G1 X39.611 Y67.102
+G1 X39.505 Y67.158
+G1 X39.394 Y67.226
+G1 X39.276 Y67.306
+G1 X39.150 Y67.396
+G1 X39.015 Y67.496
+G1 X38.872 Y67.606
+G1 X38.717 Y67.725
+G1 X38.552 Y67.851
+G1 X38.374 Y67.985
+G1 X38.184 Y68.124
+G1 X37.980 Y68.269
+G1 X37.763 Y68.417
+G1 X37.531 Y68.569
+G1 X37.284 Y68.723
+G1 X37.023 Y68.877
+G1 X36.746 Y69.031
+G1 X36.454 Y69.183
+G1 X36.147 Y69.333
+G1 X35.824 Y69.479
+G1 X35.486 Y69.620
+G1 X35.133 Y69.754
+G1 X34.766 Y69.881
+G1 X34.384 Y70.000
+G1 X33.988 Y70.109
+G1 X33.578 Y70.208
+G1 X33.157 Y70.295
+G1 X32.723 Y70.369
+G1 X32.277 Y70.430
+G1 X31.822 Y70.477
+G1 X31.357 Y70.508
+G1 X30.883 Y70.523
+G1 X30.402 Y70.522
+G1 X29.914 Y70.504
+G1 X29.420 Y70.468
+G1 X28.923 Y70.414
+G1 X28.422 Y70.341
+G1 X27.919 Y70.249
+G1 X27.415 Y70.139
+G1 X26.912 Y70.009
+G1 X26.410 Y69.861
+G1 X25.911 Y69.693
+G1 X25.416 Y69.507
+G1 X24.926 Y69.302
+G1 X24.443 Y69.079
+G1 X23.967 Y68.837
+G1 X23.500 Y68.579
+G1 X23.043 Y68.304
+G1 X22.596 Y68.012
+G1 X22.161 Y67.705
+G1 X21.738 Y67.383
+G1 X21.329 Y67.048
+G1 X20.935 Y66.700
+G1 X20.555 Y66.340
+G1 X20.191 Y65.968
+G1 X19.844 Y65.587
+G1 X19.513 Y65.198
+G1 X19.200 Y64.800
+G1 X18.904 Y64.396
+G1 X18.626 Y63.987
+G1 X18.366 Y63.574
+G1 X18.124 Y63.157
+G1 X17.901 Y62.739
+G1 X17.695 Y62.321
+G1 X17.508 Y61.903
+G1 X17.338 Y61.487
+G1 X17.185 Y61.074
+G1 X17.050 Y60.665
+G1 X16.931 Y60.262
+G1 X16.827 Y59.864
+G1 X16.739 Y59.474
+G1 X16.665 Y59.092
+G1 X16.606 Y58.719
+G1 X16.559 Y58.356
+G1 X16.523 Y58.003
+G1 X16.499 Y57.662
+G1 X16.485 Y57.333
+G1 X16.480 Y57.017
+G1 X16.483 Y56.713
+G1 X16.493 Y56.423
+G1 X16.509 Y56.146
+G1 X16.529 Y55.884
+G1 X16.552 Y55.635
+G1 X16.578 Y55.401
+G1 X16.604 Y55.180
+G1 X16.631 Y54.973
+G1 X16.657 Y54.780
+G1 X16.680 Y54.601
+G1 X16.699 Y54.434
+G1 X16.715 Y54.280
+G1 X16.725 Y54.138
+G1 X16.728 Y54.008
+G1 X16.724 Y53.888
+G1 X16.712 Y53.778
+G1 X16.690 Y53.677
+G1 X16.659 Y53.585
+G1 X16.617 Y53.500
+G1 X16.565 Y53.421
+G1 X16.500 Y53.348
+G1 X16.424 Y53.279
+G1 X16.335 Y53.214
+G1 X16.233 Y53.150
+G1 X16.118 Y53.088
+G1 X15.990 Y53.026
+G1 X15.849 Y52.962
+G1 X15.695 Y52.896
+G1 X15.528 Y52.826
+G1 X15.348 Y52.751
+G1 X15.156 Y52.671
+G1 X14.952 Y52.584
+G1 X14.736 Y52.489
+G1 X14.509 Y52.385
+G1 X14.271 Y52.271
+G1 X14.024 Y52.146
+G1 X13.768 Y52.009
+G1 X13.503 Y51.860
+G1 X13.232 Y51.698
+G1 X12.954 Y51.521
+G1 X12.670 Y51.330
+G1 X12.383 Y51.123
+G1 X12.092 Y50.901
+G1 X11.799 Y50.662
+G1 X11.505 Y50.408
+G1 X11.211 Y50.136
+G1 X10.918 Y49.848
+G1 X10.628 Y49.543
+G1 X10.342 Y49.221
+G1 X10.061 Y48.882
+G1 X9.785 Y48.527
+G1 X9.517 Y48.156
+G1 X9.258 Y47.769
+G1 X9.007 Y47.366
+G1 X8.768 Y46.949
+G1 X8.540 Y46.517
+G1 X8.324 Y46.072
+G1 X8.122 Y45.613
+G1 X7.935 Y45.143
+G1 X7.763 Y44.662
+G1 X7.606 Y44.171
+G1 X7.467 Y43.670
+G1 X7.345 Y43.161
+G1 X7.240 Y42.645
+G1 X7.154 Y42.123
+G1 X7.087 Y41.597
+G1 X7.039 Y41.067
+G1 X7.010 Y40.534
+G1 X7.000 Y40.000
+G1 X7.010 Y39.466
+G1 X7.039 Y38.933
+G1 X7.087 Y38.403
+G1 X7.154 Y37.877
+G1 X7.240 Y37.355
+G1 X7.345 Y36.839
+G1 X7.467 Y36.330
+G1 X7.606 Y35.829
+G1 X7.763 Y35.338
+G1 X7.935 Y34.857
+G1 X8.122 Y34.387
+G1 X8.324 Y33.928
+G1 X8.540 Y33.483
+G1 X8.768 Y33.051
+G1 X9.007 Y32.634
+G1 X9.258 Y32.231
+G1 X9.517 Y31.844
+G1 X9.785 Y31.473
+G1 X10.061 Y31.118
+G1 X10.342 Y30.779
+G1 X10.628 Y30.457
+G1 X10.918 Y30.152
+G1 X11.211 Y29.864
+G1 X11.505 Y29.592
+G1 X11.799 Y29.338
+G1 X12.092 Y29.099
+G1 X12.383 Y28.877
+G1 X12.670 Y28.670
+G1 X12.954 Y28.479
+G1 X13.232 Y28.302
+G1 X13.503 Y28.140
+G1 X13.768 Y27.991
+G1 X14.024 Y27.854
+G1 X14.271 Y27.729
+G1 X14.509 Y27.615
+G1 X14.736 Y27.511
+G1 X14.952 Y27.416
+G1 X15.156 Y27.329
+G1 X15.348 Y27.249
+G1 X15.528 Y27.174
+G1 X15.695 Y27.104
+G1 X15.849 Y27.038
+G1 X15.990 Y26.974
+G1 X16.118 Y26.912
+G1 X16.233 Y26.850
+G1 X16.335 Y26.786
+G1 X16.424 Y26.721
+G1 X16.500 Y26.652
+G1 X16.565 Y26.579
+G1 X16.617 Y26.500
+G1 X16.659 Y26.415
+G1 X16.690 Y26.323
+G1 X16.712 Y26.222
+G1 X16.724 Y26.112
+G1 X16.728 Y25.992
+G1 X16.725 Y25.862
+G1 X16.715 Y25.720
+G1 X16.699 Y25.566
+G1 X16.680 Y25.399
+G1 X16.657 Y25.220
+G1 X16.631 Y25.027
+G1 X16.604 Y24.820
+G1 X16.578 Y24.599
+G1 X16.552 Y24.365
+G1 X16.529 Y24.116
+G1 X16.509 Y23.854
+G1 X16.493 Y23.577
+G1 X16.483 Y23.287
+G1 X16.480 Y22.983
+G1 X16.485 Y22.667
+G1 X16.499 Y22.338
+G1 X16.523 Y21.997
+G1 X16.559 Y21.644
+G1 X16.606 Y21.281
+G1 X16.665 Y20.908
+G1 X16.739 Y20.526
+G1 X16.827 Y20.136
+G1 X16.931 Y19.738
+G1 X17.050 Y19.335
+G1 X17.185 Y18.926
+G1 X17.338 Y18.513
+G1 X17.508 Y18.097
+G1 X17.695 Y17.679
+G1 X17.901 Y17.261
+G1 X18.124 Y16.843
+G1 X18.366 Y16.426
+G1 X18.626 Y16.013
+G1 X18.904 Y15.604
+G1 X19.200 Y15.200
+G1 X19.513 Y14.802
+G1 X19.844 Y14.413
+G1 X20.191 Y14.032
+G1 X20.555 Y13.660
+G1 X20.935 Y13.300
+G1 X21.329 Y12.952
+G1 X21.738 Y12.617
+G1 X22.161 Y12.295
+G1 X22.596 Y11.988
+G1 X23.043 Y11.696
+G1 X23.500 Y11.421
+G1 X23.967 Y11.163
+G1 X24.443 Y10.921
+G1 X24.926 Y10.698
+G1 X25.416 Y10.493
+G1 X25.911 Y10.307
+G1 X26.410 Y10.139
+G1 X26.912 Y9.991
+G1 X27.415 Y9.861
+G1 X27.919 Y9.751
+G1 X28.422 Y9.659
+G1 X28.923 Y9.586
+G1 X29.420 Y9.532
+G1 X29.914 Y9.496
+G1 X30.402 Y9.478
+G1 X30.883 Y9.477
+G1 X31.357 Y9.492
+G1 X31.822 Y9.523
+G1 X32.277 Y9.570
+G1 X32.723 Y9.631
+G1 X33.157 Y9.705
+G1 X33.578 Y9.792
+G1 X33.988 Y9.891
+G1 X34.384 Y10.000
+G1 X34.766 Y10.119
+G1 X35.133 Y10.246
+G1 X35.486 Y10.380
+G1 X35.824 Y10.521
+G1 X36.147 Y10.667
+G1 X36.454 Y10.817
+G1 X36.746 Y10.969
+G1 X37.023 Y11.123
+G1 X37.284 Y11.277
+G1 X37.531 Y11.431
+G1 X37.763 Y11.583
+G1 X37.980 Y11.731
+G1 X38.184 Y11.876
+G1 X38.374 Y12.015
+G1 X38.552 Y12.149
+G1 X38.717 Y12.275
+G1 X38.872 Y12.394
+G1 X39.015 Y12.504
+G1 X39.150 Y12.604
+G1 X39.276 Y12.694
+G1 X39.394 Y12.774
+G1 X39.505 Y12.842
+G1 X39.611 Y12.898
+G1 X39.712 Y12.943
+G1 X39.810 Y12.974
+G1 X39.906 Y12.994
+G1 X40.000 Y13.000
+G1 X40.094 Y12.994
+G1 X40.190 Y12.974
+G1 X40.288 Y12.943
+G1 X40.389 Y12.898
+G1 X40.495 Y12.842
+G1 X40.606 Y12.774
+G1 X40.724 Y12.694
+G1 X40.850 Y12.604
+G1 X40.985 Y12.504
+G1 X41.128 Y12.394
+G1 X41.283 Y12.275
+G1 X41.448 Y12.149
+G1 X41.626 Y12.015
+G1 X41.816 Y11.876
+G1 X42.020 Y11.731
+G1 X42.237 Y11.583
+G1 X42.469 Y11.431
+G1 X42.716 Y11.277
+G1 X42.977 Y11.123
+G1 X43.254 Y10.969
+G1 X43.546 Y10.817
+G1 X43.853 Y10.667
+G1 X44.176 Y10.521
+G1 X44.514 Y10.380
+G1 X44.867 Y10.246
+G1 X45.234 Y10.119
+G1 X45.616 Y10.000
+G1 X46.012 Y9.891
+G1 X46.422 Y9.792
+G1 X46.843 Y9.705
+G1 X47.277 Y9.631
+G1 X47.723 Y9.570
+G1 X48.178 Y9.523
+G1 X48.643 Y9.492
+G1 X49.117 Y9.477
+G1 X49.598 Y9.478
+G1 X50.086 Y9.496
+G1 X50.580 Y9.532
+G1 X51.077 Y9.586
+G1 X51.578 Y9.659
+G1 X52.081 Y9.751
+G1 X52.585 Y9.861
+G1 X53.088 Y9.991
+G1 X53.590 Y10.139
+G1 X54.089 Y10.307
+G1 X54.584 Y10.493
+G1 X55.074 Y10.698
+G1 X55.557 Y10.921
+G1 X56.033 Y11.163
+G1 X56.500 Y11.421
+G1 X56.957 Y11.696
+G1 X57.404 Y11.988
+G1 X57.839 Y12.295
+G1 X58.262 Y12.617
+G1 X58.671 Y12.952
+G1 X59.065 Y13.300
+G1 X59.445 Y13.660
+G1 X59.809 Y14.032
+G1 X60.156 Y14.413
+G1 X60.487 Y14.802
+G1 X60.800 Y15.200
+G1 X61.096 Y15.604
+G1 X61.374 Y16.013
+G1 X61.634 Y16.426
+G1 X61.876 Y16.843
+G1 X62.099 Y17.261
+G1 X62.305 Y17.679
+G1 X62.492 Y18.097
+G1 X62.662 Y18.513
+G1 X62.815 Y18.926
+G1 X62.950 Y19.335
+G1 X63.069 Y19.738
+G1 X63.173 Y20.136
+G1 X63.261 Y20.526
+G1 X63.335 Y20.908
+G1 X63.394 Y21.281
+G1 X63.441 Y21.644
+G1 X63.477 Y21.997
+G1 X63.501 Y22.338
+G1 X63.515 Y22.667
+G1 X63.520 Y22.983
+G1 X63.517 Y23.287
+G1 X63.507 Y23.577
+G1 X63.491 Y23.854
+G1 X63.471 Y24.116
+G1 X63.448 Y24.365
+G1 X63.422 Y24.599
+G1 X63.396 Y24.820
+G1 X63.369 Y25.027
+G1 X63.343 Y25.220
+G1 X63.320 Y25.399
+G1 X63.301 Y25.566
+G1 X63.285 Y25.720
+G1 X63.275 Y25.862
+G1 X63.272 Y25.992
+G1 X63.276 Y26.112
+G1 X63.288 Y26.222
+G1 X63.310 Y26.323
+G1 X63.341 Y26.415
+G1 X63.383 Y26.500
+G1 X63.435 Y26.579
+G1 X63.500 Y26.652
+G1 X63.576 Y26.721
+G1 X63.665 Y26.786
+G1 X63.767 Y26.850
+G1 X63.882 Y26.912
+G1 X64.010 Y26.974
+G1 X64.151 Y27.038
+G1 X64.305 Y27.104
+G1 X64.472 Y27.174
+G1 X64.652 Y27.249
+G1 X64.844 Y27.329
+G1 X65.048 Y27.416
+G1 X65.264 Y27.511
+G1 X65.491 Y27.615
+G1 X65.729 Y27.729
+G1 X65.976 Y27.854
+G1 X66.232 Y27.991
+G1 X66.497 Y28.140
+G1 X66.768 Y28.302
+G1 X67.046 Y28.479
+G1 X67.330 Y28.670
+G1 X67.617 Y28.877
+G1 X67.908 Y29.099
+G1 X68.201 Y29.338
+G1 X68.495 Y29.592
+G1 X68.789 Y29.864
+G1 X69.082 Y30.152
+G1 X69.372 Y30.457
+G1 X69.658 Y30.779
+G1 X69.939 Y31.118
+G1 X70.215 Y31.473
+G1 X70.483 Y31.844
+G1 X70.742 Y32.231
+G1 X70.993 Y32.634
+G1 X71.232 Y33.051
+G1 X71.460 Y33.483
+G1 X71.676 Y33.928
+G1 X71.878 Y34.387
+G1 X72.065 Y34.857
+G1 X72.237 Y35.338
+G1 X72.394 Y35.829
+G1 X72.533 Y36.330
+G1 X72.655 Y36.839
+G1 X72.760 Y37.355
+G1 X72.846 Y37.877
+G1 X72.913 Y38.403
+G1 X72.961 Y38.933
+G1 X72.990 Y39.466
+G4 P0.5
+G0 Z5
+G92 X0 Y0
+G1 Z-1 F300
+G91 F1500
+G1 X0.500 Y0.000
+G1 X0.498 Y0.050
+G1 X0.490 Y0.099
+G1 X0.478 Y0.148
+G1 X0.461 Y0.195
+G1 X0.439 Y0.240
+G1 X0.413 Y0.282
+G1 X0.382 Y0.322
+G1 X0.348 Y0.359
+G1 X0.311 Y0.392
+G1 X0.270 Y0.421
+G1 X0.227 Y0.446
+G1 X0.181 Y0.466
+G1 X0.134 Y0.482
+G1 X0.085 Y0.493
+G1 X0.035 Y0.499
+G1 X-0.015 Y0.500
+G1 X-0.064 Y0.496
+G1 X-0.114 Y0.487
+G1 X-0.162 Y0.473
+G1 X-0.208 Y0.455
+G1 X-0.252 Y0.432
+G1 X-0.294 Y0.404
+G1 X-0.333 Y0.373
+G1 X-0.369 Y0.338
+G1 X-0.401 Y0.299
+G1 X-0.428 Y0.258
+G1 X-0.452 Y0.214
+G1 X-0.471 Y0.167
+G1 X-0.485 Y0.120
+G1 X-0.495 Y0.071
+G1 X-0.500 Y0.021
+G1 X-0.499 Y-0.029
+G1 X-0.494 Y-0.079
+G1 X-0.483 Y-0.128
+G1 X-0.468 Y-0.175
+G1 X-0.448 Y-0.221
+G1 X-0.424 Y-0.265
+G1 X-0.395 Y-0.306
+G1 X-0.363 Y-0.344
+G1 X-0.327 Y-0.378
+G1 X-0.287 Y-0.409
+G1 X-0.245 Y-0.436
+G1 X-0.200 Y-0.458
+G1 X-0.154 Y-0.476
+G1 X-0.105 Y-0.489
+G1 X-0.056 Y-0.497
+G1 X-0.006 Y-0.500
+G1 X0.044 Y-0.498
+G1 X0.093 Y-0.491
+G1 X0.142 Y-0.479
+G1 X0.189 Y-0.463
+G1 X0.234 Y-0.442
+G1 X0.277 Y-0.416
+G1 X0.317 Y-0.386
+G1 X0.354 Y-0.353
+G1 X0.388 Y-0.316
+G1 X0.417 Y-0.275
+G1 X0.443 Y-0.232
+G1 X0.464 Y-0.187
+G1 X0.480 Y-0.140
+G1 X0.492 Y-0.091
+G1 X0.498 Y-0.042
+G1 X0.500 Y0.008
+G1 X0.497 Y0.058
+G1 X0.488 Y0.108
+G1 X0.475 Y0.156
+G1 X0.457 Y0.202
+G1 X0.435 Y0.247
+G1 X0.408 Y0.289
+G1 X0.377 Y0.328
+G1 X0.342 Y0.364
+G1 X0.304 Y0.397
+G1 X0.263 Y0.425
+G1 X0.219 Y0.449
+G1 X0.173 Y0.469
+G1 X0.126 Y0.484
+G1 X0.077 Y0.494
+G1 X0.027 Y0.499
+G1 X-0.023 Y0.499
+G1 X-0.073 Y0.495
+G1 X-0.122 Y0.485
+G1 X-0.170 Y0.470
+G1 X-0.216 Y0.451
+G1 X-0.260 Y0.427
+G1 X-0.301 Y0.399
+G1 X-0.339 Y0.367
+G1 X-0.374 Y0.331
+G1 X-0.406 Y0.292
+G1 X-0.433 Y0.251
+G1 X-0.456 Y0.206
+G1 X-0.474 Y0.160
+G1 X-0.487 Y0.111
+G1 X-0.496 Y0.062
+G1 X-0.500 Y0.012
+G1 X-0.499 Y-0.038
+G1 X-0.492 Y-0.087
+G1 X-0.481 Y-0.136
+G1 X-0.465 Y-0.183
+G1 X-0.445 Y-0.229
+G1 X-0.420 Y-0.272
+G1 X-0.390 Y-0.313
+G1 X-0.357 Y-0.350
+G1 X-0.320 Y-0.384
+G1 X-0.280 Y-0.414
+G1 X-0.238 Y-0.440
+G1 X-0.193 Y-0.461
+G1 X-0.146 Y-0.478
+G1 X-0.097 Y-0.490
+G1 X-0.048 Y-0.498
+G1 X0.002 Y-0.500
+G1 X0.052 Y-0.497
+G1 X0.102 Y-0.490
+G1 X0.150 Y-0.477
+G1 X0.197 Y-0.460
+G1 X0.242 Y-0.438
+G1 X0.284 Y-0.411
+G1 X0.324 Y-0.381
+G1 X0.360 Y-0.347
+G1 X0.393 Y-0.309
+G1 X0.422 Y-0.268
+G1 X0.447 Y-0.225
+G1 X0.467 Y-0.179
+G1 X0.482 Y-0.132
+G1 X0.493 Y-0.083
+G1 X0.499 Y-0.033
+G1 X0.500 Y0.017
+G1 X0.496 Y0.067
+G1 X0.486 Y0.116
+G1 X0.472 Y0.164
+G1 X0.454 Y0.210
+G1 X0.430 Y0.254
+G1 X0.403 Y0.296
+G1 X0.371 Y0.335
+G1 X0.336 Y0.370
+G1 X0.297 Y0.402
+G1 X0.256 Y0.430
+G1 X0.212 Y0.453
+G1 X0.165 Y0.472
+G1 X0.117 Y0.486
+G1 X0.068 Y0.495
+G1 X0.019 Y0.500
+G1 X-0.031 Y0.499
+G1 X-0.081 Y0.493
+G1 X-0.130 Y0.483
+G1 X-0.177 Y0.467
+G1 X-0.223 Y0.447
+G1 X-0.267 Y0.423
+G1 X-0.308 Y0.394
+G1 X-0.345 Y0.361
+G1 X-0.380 Y0.325
+G1 X-0.410 Y0.286
+G1 X-0.437 Y0.243
+G1 X-0.459 Y0.198
+G1 X-0.476 Y0.152
+G1 X-0.489 Y0.103
+G1 X-0.497 Y0.054
+G1 X-0.500 Y0.004
+G1 X-0.498 Y-0.046
+G1 X-0.491 Y-0.095
+G1 X-0.479 Y-0.144
+G1 X-0.462 Y-0.191
+G1 X-0.441 Y-0.236
+G1 X-0.415 Y-0.279
+G1 X-0.385 Y-0.319
+G1 X-0.351 Y-0.356
+G1 X-0.314 Y-0.389
+G1 X-0.273 Y-0.419
+G1 X-0.230 Y-0.444
+G1 X-0.185 Y-0.465
+G1 X-0.138 Y-0.481
+G1 X-0.089 Y-0.492
+G1 X-0.039 Y-0.498
+G1 X0.011 Y-0.500
+G1 X0.060 Y-0.496
+G1 X0.110 Y-0.488
+G1 X0.158 Y-0.474
+G1 X0.204 Y-0.456
+G1 X0.249 Y-0.434
+G1 X0.291 Y-0.407
+G1 X0.330 Y-0.375
+G1 X0.366 Y-0.341
+G1 X0.398 Y-0.302
+G1 X0.426 Y-0.261
+G1 X0.450 Y-0.217
+G1 X0.470 Y-0.171
+G1 X0.485 Y-0.123
+G1 X0.494 Y-0.074
+G1 X0.499 Y-0.025
+G1 X0.499 Y0.025
+G1 X0.494 Y0.075
+G1 X0.484 Y0.124
+G1 X0.470 Y0.172
+G1 X0.450 Y0.218
+G1 X0.426 Y0.262
+G1 X0.398 Y0.303
+G1 X0.366 Y0.341
+G1 X0.330 Y0.376
+G1 X0.291 Y0.407
+G1 X0.249 Y0.434
+G90 G20 F40
+G1 X0.0000 Y0.0000
+G1 X0.0200 Y0.0591
+G1 X0.0400 Y0.1129
+G1 X0.0600 Y0.1567
+G1 X0.0800 Y0.1864
+G1 X0.1000 Y0.1995
+G1 X0.1200 Y0.1948
+G1 X0.1400 Y0.1726
+G1 X0.1600 Y0.1351
+G1 X0.1800 Y0.0855
+G1 X0.2000 Y0.0282
+G1 X0.2200 Y-0.0315
+G1 X0.2400 Y-0.0885
+G1 X0.2600 Y-0.1376
+G1 X0.2800 Y-0.1743
+G1 X0.3000 Y-0.1955
+G1 X0.3200 Y-0.1992
+G1 X0.3400 Y-0.1852
+G1 X0.3600 Y-0.1546
+G1 X0.3800 Y-0.1101
+G1 X0.4000 Y-0.0559
+G1 X0.4200 Y0.0034
+G1 X0.4400 Y0.0623
+G1 X0.4600 Y0.1157
+G1 X0.4800 Y0.1587
+G1 X0.5000 Y0.1876
+G1 X0.5200 Y0.1997
+G1 X0.5400 Y0.1940
+G1 X0.5600 Y0.1709
+G1 X0.5800 Y0.1326
+G1 X0.6000 Y0.0824
+G1 X0.6200 Y0.0249
+G1 X0.6400 Y-0.0349
+G1 X0.6600 Y-0.0915
+G1 X0.6800 Y-0.1400
+G1 X0.7000 Y-0.1759
+G1 X0.7200 Y-0.1962
+G1 X0.7400 Y-0.1989
+G1 X0.7600 Y-0.1839
+G1 X0.7800 Y-0.1524
+G1 X0.8000 Y-0.1073
+G1 X0.8200 Y-0.0526
+G1 X0.8400 Y0.0067
+G1 X0.8600 Y0.0655
+G1 X0.8800 Y0.1184
+G1 X0.9000 Y0.1608
+G1 X0.9200 Y0.1887
+G1 X0.9400 Y0.1999
+G1 X0.9600 Y0.1931
+G1 X0.9800 Y0.1691
+G1 X1.0000 Y0.1301
+G1 X1.0200 Y0.0793
+G1 X1.0400 Y0.0216
+G1 X1.0600 Y-0.0382
+G1 X1.0800 Y-0.0945
+G1 X1.1000 Y-0.1424
+G1 X1.1200 Y-0.1775
+G1 X1.1400 Y-0.1968
+G1 X1.1600 Y-0.1985
+G1 X1.1800 Y-0.1825
+G1 X1.2000 Y-0.1502
+G1 X1.2200 Y-0.1045
+G1 X1.2400 Y-0.0494
+G1 X1.2600 Y0.0101
+G1 X1.2800 Y0.0687
+G1 X1.3000 Y0.1211
+G1 X1.3200 Y0.1627
+G1 X1.3400 Y0.1898
+G1 X1.3600 Y0.2000
+G1 X1.3800 Y0.1922
+G1 X1.4000 Y0.1673
+G1 X1.4200 Y0.1275
+G1 X1.4400 Y0.0763
+G1 X1.4600 Y0.0182
+G1 X1.4800 Y-0.0415
+G1 X1.5000 Y-0.0974
+G1 X1.5200 Y-0.1447
+G1 X1.5400 Y-0.1790
+G1 X1.5600 Y-0.1974
+G1 X1.5800 Y-0.1981
+G1 X1.6000 Y-0.1811
+G1 X1.6200 Y-0.1480
+G1 X1.6400 Y-0.1016
+G1 X1.6600 Y-0.0461
+G1 X1.6800 Y0.0134
+G1 X1.7000 Y0.0718
+G1 X1.7200 Y0.1238
+G1 X1.7400 Y0.1647
+G1 X1.7600 Y0.1909
+G1 X1.7800 Y0.2000
+G1 X1.8000 Y0.1913
+G1 X1.8200 Y0.1655
+G1 X1.8400 Y0.1249
+G1 X1.8600 Y0.0731
+G1 X1.8800 Y0.0149
+G1 X1.9000 Y-0.0448
+G1 X1.9200 Y-0.1004
+G1 X1.9400 Y-0.1470
+G1 X1.9600 Y-0.1805
+G1 X1.9800 Y-0.1979
+G21 G92.1
+G0 Z5
+M2
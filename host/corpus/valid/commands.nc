@@ -0,0 +1,4 @@
+F1000
+G1 X10 M3 M8
+G4 P0.5
+G92 X0
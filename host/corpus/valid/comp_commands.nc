@@ -0,0 +1,7 @@
+G21 G90 G17 F600
+G41.1 D2
+G1 X10 Y0
+G2 X20 Y10 I0 J10
+T1 M6 M3 M8 G4 P0.1
+G1 X30 Y10
+G40 G1 X40 Y0
@@ -0,0 +1,2 @@
+M7 M8
+M9
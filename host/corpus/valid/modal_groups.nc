@@ -0,0 +1 @@
+G17 G21 G90 G94 G40 G49 G80
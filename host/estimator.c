@@ -0,0 +1,365 @@
+/*
+ * estimator.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * offline cycle time estimator
+ *
+ * runs a g-code file through the firmware chain itself, gc_gcode_parser -> canonical machine
+ * -> mp_plan_line/_plan_block_list -> mp_motion_planning, with the per-axis configuration
+ * from config.c. nothing is handed to the runtime, whenever the planner queue reaches the
+ * point where the controller would wait on _sync_to_planner the oldest block is retired and
+ * its planned head, body and tail times are accumulated. so jerk limits, junction slowdowns
+ * and MIN_BLOCK_TIME rejections are all accounted for exactly as the machine plans them.
+ *
+ * block times are reported per range of lines, line numbers are the N words when the program
+ * has them and the file lines otherwise.
+ *
+ * build:
+ *	make -C host estimator
+ *
+ * usage:
+ *	estimator [-r lines_per_range] [-k slowest_ranges] [-q] [-p] [-j jobs] [-t] file.nc ...
+ *
+ *	-p parses, plans and accounts on three threads over rings (pipeline.c), the report is the
+ *	   same and the cpu time of every stage is printed with the throughput
+ *	-j estimates several files at once, each worker thread has its own machine (MACHINE_LOCAL),
+ *	   the reports come out in argument order as they do without it
+ *	-t writes the planner trace of every block (trace.h) to file.nc.csv next to each file
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "system.h"
+#include "canonical.h"
+#include "gcode_parser.h"
+#include "planner.h"
+#include "plan_command.h"
+#include "trace.h"
+#include "estimator.h"
+
+#define EST_DEFAULT_RANGE 1000
+#define EST_DEFAULT_SLOWEST 10
+#define EST_LENGTH_TOLERANCE 1e-4f			//relative, head+body+tail against the block length
+#define EST_USAGE "usage: %s [-r lines_per_range] [-k slowest_ranges] [-q] [-p] [-j jobs] [-t] file.nc ...\n"
+
+MACHINE_LOCAL est_t est;
+
+//est_block_time//
+//input : a planned buffer
+//output : execution time of the buffer in minutes
+//fuction : sums the times of the head, body and tail sections as the runtime will run them
+//notes : head and tail are velocity transitions, their time is the length over the mean velocity
+//additions:
+//
+float est_block_time(mpBuf_t *bf){
+	float time = 0;
+	if(bf->head_length > 0){
+		time += (2*bf->head_length)/(bf->entry_velocity + bf->cruise_velocity);
+	}
+	if(bf->body_length > 0){
+		time += bf->body_length/bf->cruise_velocity;
+	}
+	if(bf->tail_length > 0){
+		time += (2*bf->tail_length)/(bf->cruise_velocity + bf->exit_velocity);
+	}
+	return time;
+}
+
+//est_account//
+//input : estimate to add to, line number of the block and its time in minutes
+//output : none
+//fuction : adds a block time to the total and to its line range
+//notes : takes the estimate explicitly, the exec stage of the pipeline runs on another thread
+//additions:
+//
+void est_account(est_t *e, uint32_t linenum, float time){
+	uint32_t range = linenum/e->range_size;
+	if(range >= e->ranges){
+		uint32_t ranges = (range+1)*2;
+		e->range_time = realloc(e->range_time,ranges*sizeof(double));
+		memset(&e->range_time[e->ranges],0,(ranges-e->ranges)*sizeof(double));
+		e->ranges = ranges;
+	}
+	e->range_time[range] += time;
+	e->total_time += time;
+	e->blocks++;
+	if(range+1 > e->used_ranges){e->used_ranges = range+1;}
+}
+
+//_est_check_profile//
+//input : a planned buffer
+//output : none
+//fuction : counts a move whose head, body and tail don't add up to its length
+//notes : a profile that doesn't cover its block would run the block short or long, or at an
+//acceleration the axes don't have. command and dwell blocks have no sections
+//additions:
+//
+static void _est_check_profile(mpBuf_t *bf){
+	if(MP_IS_COMMAND(bf)) return;
+	float sections = bf->head_length + bf->body_length + bf->tail_length;
+	if(fabsf(sections - bf->length) > EST_LENGTH_TOLERANCE*bf->length){
+		if(est.profile_errors++ == 0){est.first_profile_error_line = bf->gm.linenum;}
+	}
+}
+
+//est_retire//
+//input : none
+//output : false if the queue is empty
+//fuction : retires the oldest planned buffer as if the runtime had executed it
+//notes :
+//additions:
+//
+uint8_t est_retire(void){
+	mpBuf_t *bf;
+	if((bf = mp_get_run_buffer()) == NULL){
+		return false;
+	}
+	_est_check_profile(bf);
+	est.retire_hook(&est,bf->gm.linenum,est_block_time(bf));
+	if(est.trace != NULL){
+		ptRecord_t rec;
+		PT_RECORD(bf);
+		while(pt_read(&rec)){pt_write_csv(est.trace,&rec);}
+	}
+	mp_free_run_buffer();
+	return true;
+}
+
+//est_block//
+//input : a g-code block and its file line
+//output : parser status
+//fuction : interprets a block and runs any arc it started to completion
+//notes :
+//additions:
+//
+stat_t est_block(char *block, uint32_t line){
+	cm_set_model_linenum(line);					//an N word in the block overrides it
+	stat_t status = host_block(block,est_retire,0);
+	if((status != STAT_OK) && (status != STAT_NOOP) && (status != STAT_COMPLETE)){
+		if(est.errors++ == 0){est.first_error_line = line;}
+	}
+	return status;
+}
+
+//est_finish//
+//input : none
+//output : none
+//fuction : executes whatever is left in the planner queue
+//notes :
+//additions:
+//
+void est_finish(void){
+	while(est_retire() != false){}
+}
+
+//est_init//
+//input : lines per reported range, 0 for the default
+//output : none
+//fuction : resets the estimate and brings up the machine as main() does
+//notes :
+//additions:
+//
+void est_init(uint32_t range_size){
+	free(est.range_time);
+	memset(&est,0,sizeof(est));
+	est.range_size = (range_size == 0)? EST_DEFAULT_RANGE : range_size;
+	est.retire_hook = est_account;
+	host_init();
+}
+
+//est_report//
+//input : output stream, number of slowest ranges to list, print all ranges flag
+//output : none
+//fuction : prints the totals, the per range times and the slowest ranges
+//notes :
+//additions:
+//
+void est_report(FILE *out, uint32_t slowest, uint8_t all_ranges){
+	fprintf(out,"blocks: %u  errors: %u",est.blocks,est.errors);
+	if(est.errors){fprintf(out,"  first error at line %u",est.first_error_line);}
+	if(est.profile_errors){
+		fprintf(out,"\nprofile errors: %u  first at line %u",est.profile_errors,est.first_profile_error_line);
+	}
+	fprintf(out,"\ncycle time: %.3f s\n",est.total_time*60.0);
+	if(all_ranges){
+		fprintf(out,"\n%-24s %12s\n","lines","time [s]");
+		for(uint32_t r=0; r<est.used_ranges; ++r){
+			if(est.range_time[r] == 0) continue;
+			fprintf(out,"%10u - %-11u %12.3f\n",r*est.range_size,(r+1)*est.range_size-1,est.range_time[r]*60.0);
+		}
+	}
+	if(slowest > est.used_ranges){slowest = est.used_ranges;}
+	uint32_t *order = malloc(est.used_ranges*sizeof(uint32_t));
+	for(uint32_t r=0; r<est.used_ranges; ++r){order[r] = r;}
+	fprintf(out,"\nslowest sections:\n");
+	for(uint32_t i=0; i<slowest; ++i){			//partial selection sort, only k are needed
+		for(uint32_t j=i+1; j<est.used_ranges; ++j){
+			if(est.range_time[order[j]] > est.range_time[order[i]]){
+				uint32_t tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+			}
+		}
+		uint32_t r = order[i];
+		if(est.range_time[r] == 0) break;
+		fprintf(out,"%10u - %-11u %12.3f s  %5.1f%%\n",r*est.range_size,(r+1)*est.range_size-1,
+			est.range_time[r]*60.0,100.0*est.range_time[r]/est.total_time);
+	}
+	free(order);
+}
+
+//est_file//
+//input : g-code file, options, stream for the report
+//output : 0 if every block was accepted and planned, 1 on parser or profile errors, -1 if the
+//file could not be read
+//fuction : estimates one program on the calling thread's machine
+//notes : the whole machine is MACHINE_LOCAL so any number of threads can run this at once
+//additions:
+//
+int est_file(const char *path, const estOptions_t *opt, FILE *out){
+	FILE *in = fopen(path,"r");
+	if(in == NULL){
+		fprintf(out,"%s: cannot open\n",path);
+		return -1;
+	}
+	char line[EST_LINE_SIZE];
+	uint32_t lines = 0;
+	struct timespec start, end;
+	double stage_cpu[3];
+
+	est_init(opt->range_size);
+	if(opt->trace){
+		char name[EST_LINE_SIZE];
+		snprintf(name,sizeof(name),"%s.csv",path);
+		if((est.trace = fopen(name,"w")) != NULL){
+			pt_write_csv_header(est.trace);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	if(opt->pipelined){
+		lines = est_pipeline(in,stage_cpu);
+	}else{
+		while(fgets(line,sizeof(line),in) != NULL){
+			line[strcspn(line,"\r\n")] = NUL;
+			est_block(line,++lines);
+		}
+		est_finish();
+	}
+	clock_gettime(CLOCK_MONOTONIC,&end);
+	fclose(in);
+	if(est.trace != NULL){
+		fclose(est.trace);
+		est.trace = NULL;
+	}
+
+	double wall = (end.tv_sec-start.tv_sec) + (end.tv_nsec-start.tv_nsec)*1e-9;
+	fprintf(out,"%s\n",path);
+	est_report(out,opt->slowest,opt->all_ranges);
+	fprintf(out,"\nestimated %u lines in %.3f s (%.0f lines/s)",lines,wall,lines/wall);
+	if(opt->pipelined){			//the staged run takes as long as its slowest stage with a core each
+		fprintf(out,", cpu parse %.3f s  plan %.3f s  exec %.3f s",stage_cpu[0],stage_cpu[1],stage_cpu[2]);
+	}
+	fputs("\n",out);
+	return ((est.errors != 0) || (est.profile_errors != 0));
+}
+
+typedef struct estBatch{
+	char **files;
+	uint32_t count;
+	_Atomic uint32_t next;			//next file to be taken by a worker
+	const estOptions_t *opt;
+	char **reports;							//per file report, printed in argument order
+	int *results;
+}estBatch_t;
+
+//_est_worker//
+//input : the batch
+//output : none
+//fuction : takes files off the batch until none is left, each one on this thread's own machine
+//notes :
+//additions:
+//
+static void *_est_worker(void *arg){
+	estBatch_t *b = arg;
+	uint32_t i;
+	while((i = atomic_fetch_add(&b->next,1)) < b->count){
+		size_t size;
+		FILE *out = open_memstream(&b->reports[i],&size);
+		b->results[i] = est_file(b->files[i],b->opt,out);
+		fclose(out);
+	}
+	return NULL;
+}
+
+//est_batch//
+//input : files, number of files, options, number of worker threads
+//output : number of files with errors
+//fuction : estimates many programs in parallel, one simulated machine per worker
+//notes : the reports are printed in argument order, separated the way the single thread run
+//separates them
+//additions:
+//
+uint32_t est_batch(char **files, uint32_t count, const estOptions_t *opt, uint32_t jobs){
+	estBatch_t b = {files,count,0,opt,calloc(count,sizeof(char*)),calloc(count,sizeof(int))};
+	pthread_t *workers = malloc(jobs*sizeof(pthread_t));
+	uint32_t failed = 0;
+	for(uint32_t j=0; j<jobs; ++j){
+		pthread_create(&workers[j],NULL,_est_worker,&b);
+	}
+	for(uint32_t j=0; j<jobs; ++j){
+		pthread_join(workers[j],NULL);
+	}
+	for(uint32_t i=0; i<count; ++i){
+		fputs(b.reports[i],stdout);
+		if(i+1 < count) fputs("\n",stdout);
+		free(b.reports[i]);
+		if(b.results[i] != 0) failed++;
+	}
+	free(workers);
+	free(b.reports);
+	free(b.results);
+	return failed;
+}
+
+int main(int argc, char *argv[]){
+	estOptions_t opt = {EST_DEFAULT_RANGE,EST_DEFAULT_SLOWEST,true,false,false};
+	uint32_t jobs = 1;
+	int o;
+	while((o = getopt(argc,argv,"r:k:qpj:t")) != -1){
+		switch(o){
+			case 'r': opt.range_size = (uint32_t)strtoul(optarg,NULL,10); break;
+			case 'k': opt.slowest = (uint32_t)strtoul(optarg,NULL,10); break;
+			case 'q': opt.all_ranges = false; break;
+			case 'p': opt.pipelined = true; break;
+			case 'j': jobs = (uint32_t)strtoul(optarg,NULL,10); break;
+			case 't': opt.trace = true; break;
+			default:
+				fprintf(stderr,EST_USAGE,argv[0]);
+				return 2;
+		}
+	}
+	if(optind >= argc){
+		fprintf(stderr,EST_USAGE,argv[0]);
+		return 2;
+	}
+	uint32_t count = argc-optind;
+	if(jobs > count){jobs = count;}
+	if(jobs <= 1){
+		uint32_t failed = 0;
+		for(uint32_t i=0; i<count; ++i){
+			if(est_file(argv[optind+i],&opt,stdout) != 0) failed++;
+			if(i+1 < count) fputs("\n",stdout);
+		}
+		return (failed != 0);
+	}
+	return (est_batch(&argv[optind],count,&opt,jobs) != 0);
+}
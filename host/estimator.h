@@ -0,0 +1,50 @@
+// estimator.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+#ifndef ESTIMATOR_H
+#define ESTIMATOR_H
+
+#include <stdio.h>
+#include "config.h"
+
+#define EST_LINE_SIZE 256
+
+typedef struct estimator{
+	uint32_t range_size;			//lines per reported range
+	uint32_t ranges;					//allocated ranges
+	uint32_t used_ranges;
+	double *range_time;				//minutes per range
+	double total_time;				//minutes
+	uint32_t blocks;
+	uint32_t errors;
+	uint32_t first_error_line;
+	uint32_t profile_errors;	//planned blocks whose head, body and tail don't add up to their length
+	uint32_t first_profile_error_line;
+	FILE *trace;							//planner trace csv, NULL when off
+	void (*retire_hook)(struct estimator *e, uint32_t linenum, float time);	//est_account, or the exec stage of the pipeline
+}est_t;
+
+typedef struct estOptions{
+	uint32_t range_size;
+	uint32_t slowest;					//slowest ranges listed
+	uint8_t all_ranges;
+	uint8_t pipelined;
+	uint8_t trace;
+}estOptions_t;
+
+extern MACHINE_LOCAL est_t est;
+
+void est_init(uint32_t range_size);
+stat_t est_block(char *block, uint32_t line);
+uint8_t est_retire(void);
+void est_finish(void);
+float est_block_time(mpBuf_t *bf);
+void est_account(est_t *e, uint32_t linenum, float time);
+void est_report(FILE *out, uint32_t slowest, uint8_t all_ranges);
+uint32_t est_pipeline(FILE *in, double stage_cpu[3]);
+int est_file(const char *path, const estOptions_t *opt, FILE *out);
+uint32_t est_batch(char **files, uint32_t count, const estOptions_t *opt, uint32_t jobs);
+
+#endif
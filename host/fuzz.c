@@ -0,0 +1,162 @@
+/*
+ * fuzz.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * libFuzzer target for gc_gcode_parser. an input is split into lines and every line is an
+ * untrusted block, copied into a buffer of exactly its size plus the terminator so the
+ * sanitizers catch any access the in place normalization or the number reader make past the
+ * block. blocks go all the way through the canonical machine and the planner as they do on
+ * the target, so whole CAM files make a good seed corpus.
+ *
+ * gcc has no libFuzzer, FUZZ_STANDALONE gives the target its own main: it runs every seed
+ * file, then mutates them with a fixed seed, so a crash repeats, under the sanitizers.
+ *
+ * build:
+ *	make -C host fuzz											standalone, gcc
+ *	make -C host fuzz CC=clang FUZZ_ENGINE=-fsanitize=fuzzer,address,undefined
+ *
+ * run:
+ *	fuzz [-r runs] seed_files...					standalone, make -C host check runs it on the corpus
+ *	fuzz -max_len=4096 corpus_dir/ cam_files_dir/		libFuzzer
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "system.h"
+#include "canonical.h"
+#include "gcode_parser.h"
+#include "planner.h"
+
+#define FUZZ_ARC_SEGMENTS 10000			//bound on an arc so one input can't run forever
+#define FUZZ_MAX_LEN 4096
+#define FUZZ_RUNS 100000							//mutated inputs of a standalone run
+#define FUZZ_SEED 1
+#define FUZZ_SEEDS 64								//seed files a standalone run keeps
+#define FUZZ_MUTATIONS 8							//at most, on one input
+
+int LLVMFuzzerInitialize(int *argc, char ***argv){
+	host_init();
+	return 0;
+}
+
+//_fuzz_block//
+//input : a block, not terminated, and its length
+//output : none
+//fuction : runs one block and any arc it starts
+//notes : 
+//additions: 
+//
+static void _fuzz_block(const uint8_t *data, size_t size){
+	char *block = malloc(size+1);
+	memcpy(block,data,size);
+	block[size] = NUL;
+	
+	host_block(block,NULL,FUZZ_ARC_SEGMENTS);
+	cm_abort_arc();
+	if(cm.machine_state == MACHINE_ALARM){cm.machine_state = MACHINE_READY;}	//keep exploring past alarms
+	
+	free(block);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size){
+	const uint8_t *end = data+size;
+	while(data < end){
+		const uint8_t *eol = memchr(data,'\n',end-data);
+		if(eol == NULL) eol = end;
+		_fuzz_block(data,eol-data);
+		data = eol+1;
+	}
+	return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+
+static const char fuzz_dict[] = "GMNXYZIJKRFPSTDHL0123456789.-+ ()%;\n";
+
+//_fuzz_mutate//
+//input : input to mutate, its length
+//output : new length, never above FUZZ_MAX_LEN
+//fuction : changes, inserts, deletes or repeats bytes of the input
+//notes : inserted bytes come from fuzz_dict most of the time so the blocks stay close to gcode
+//additions:
+//
+static size_t _fuzz_mutate(uint8_t *data, size_t size){
+	int mutations = 1 + rand()%FUZZ_MUTATIONS;
+	for(int i=0; i<mutations; ++i){
+		size_t at = (size == 0)? 0 : (size_t)rand()%size;
+		uint8_t byte = (rand()%4)? (uint8_t)fuzz_dict[rand()%(sizeof(fuzz_dict)-1)] : (uint8_t)rand();
+		switch(rand()%4){
+			case 0:																						//change
+				if(size != 0) data[at] = byte;
+				break;
+			case 1:																						//insert
+				if(size >= FUZZ_MAX_LEN) break;
+				memmove(data+at+1,data+at,size-at);
+				data[at] = byte;
+				size++;
+				break;
+			case 2:																						//delete
+				if(size == 0) break;
+				memmove(data+at,data+at+1,size-at-1);
+				size--;
+				break;
+			default:{																					//repeat a run of bytes
+				size_t len = 1 + rand()%16;
+				if((at+len > size)||(size+len > FUZZ_MAX_LEN)) break;
+				memmove(data+at+len,data+at,size-at);
+				size += len;
+				break;
+			}
+		}
+	}
+	return size;
+}
+
+int main(int argc, char *argv[]){
+	static uint8_t seeds[FUZZ_SEEDS][FUZZ_MAX_LEN];
+	static size_t seed_size[FUZZ_SEEDS];
+	static uint8_t input[FUZZ_MAX_LEN];
+	uint32_t runs = FUZZ_RUNS;
+	uint32_t count = 0;
+	
+	LLVMFuzzerInitialize(&argc,&argv);
+	for(int i=1; i<argc; ++i){
+		if((strcmp(argv[i],"-r") == 0)&&(i+1 < argc)){
+			runs = (uint32_t)strtoul(argv[++i],NULL,10);
+			continue;
+		}
+		if(count == FUZZ_SEEDS) break;
+		FILE *in = fopen(argv[i],"rb");
+		if(in == NULL){
+			perror(argv[i]);
+			return 2;
+		}
+		seed_size[count] = fread(seeds[count],1,FUZZ_MAX_LEN,in);
+		fclose(in);
+		LLVMFuzzerTestOneInput(seeds[count],seed_size[count]);
+		count++;
+	}
+	if(count == 0){
+		printf("usage: fuzz [-r runs] seed_files...\n");
+		return 2;
+	}
+	srand(FUZZ_SEED);
+	for(uint32_t i=0; i<runs; ++i){
+		uint32_t seed = (uint32_t)rand()%count;
+		memcpy(input,seeds[seed],seed_size[seed]);
+		size_t size = _fuzz_mutate(input,seed_size[seed]);
+		LLVMFuzzerTestOneInput(input,size);
+	}
+	printf("%u seeds, %u runs\n",count,runs);
+	return 0;
+}
+
+#endif
@@ -0,0 +1,73 @@
+// host.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	host build shim, force included in every translation unit of the host tools
+	(-include host/host.h) so the portable firmware layers compile unchanged with gcc.
+	hardware layers (HAL, loader, stepper, switch) are replaced by host_stubs.c
+*/
+
+#ifndef HOST_H
+#define HOST_H
+
+#define HOST_BUILD
+#define MACHINE_REENTRANT					//one machine per thread, see config.h
+#define __PLANNER_TRACE						//planner trace for the estimator -t export, see trace.h
+#define __ENCODER_FEEDBACK				//following error check against the plant model below, see encoder.h
+
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#define _sqrtf sqrtf						//armcc VSQRT intrinsic
+#define INLINE static inline				//armcc extern inline, gcc would emit a definition per translation unit
+
+//host_timer_read//
+//input : none
+//output : free running 32 bit timestamp
+//fuction : stands in for the WTIMER0 debug timer so db_ sessions measure host time
+//notes : cpu cycles on x86 hosts, nanoseconds elsewhere
+//additions: 
+//
+static inline uint32_t host_timer_read(void){
+#if defined(__x86_64__) || defined(__i386__)
+	return (uint32_t)__builtin_ia32_rdtsc();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (uint32_t)(ts.tv_sec*1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+//host_tick_read//
+//input : none
+//output : milliseconds tick
+//fuction : stands in for the WTIMER1 tick clock
+//notes : 
+//additions: 
+//
+static inline uint32_t host_tick_read(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (uint32_t)(ts.tv_sec*1000ULL + ts.tv_nsec/1000000);
+}
+
+//quadrature encoder plant model, host_stubs.c
+//the motor follows the commanded steps with a first order lag, lost steps offset it for good
+void host_plant_init(float counts_per_step, float gain);
+void host_plant_update(int32_t commanded_steps);
+void host_plant_lose_steps(int32_t steps);
+uint32_t host_qei_read(void);
+
+#define WTIMER0_TAV_R (host_timer_read())
+#define WTIMER1_TBR_R (host_tick_read())
+#define QEI0_POS_R (host_qei_read())
+
+//block path of the host tools, host_stubs.c
+void host_init(void);
+void host_drain(uint8_t (*retire)(void));
+uint8_t host_block(char *block, uint8_t (*retire)(void), uint32_t limit);		//stat_t, system.h comes later
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * host_stubs.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * hardware layer stand-ins for the host tools, the planner never hands a move to the
+ * runtime so the actuator is always idle and switches are always open
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "profile.h"
+#include "loader.h"
+#include "stepper.h"
+#include "switch.h"
+#include "config.h"
+#include "debugging.h"
+#include "trace.h"
+#include "encoder.h"
+#include "recorder.h"
+#include "HAL.h"
+#include "events.h"
+#include "gcode_parser.h"
+
+MACHINE_LOCAL debug_t db;
+MACHINE_LOCAL load_t ld;
+MACHINE_LOCAL stpCfg_t st_cfg;
+
+typedef struct hostPlant{
+	float position;							//steps the motor actually is at
+	float gain;									//fraction of the lag recovered per update, 1 follows exactly
+	float counts_per_step;
+	int32_t lost;								//steps lost for good
+}hostPlant_t;
+
+static MACHINE_LOCAL hostPlant_t plant;
+
+static uint8_t _host_runtime_isbusy(void){return false;}
+
+void st_init(void){}
+void fr_freeze(void){}
+stat_t mp_exec_line(mpBuf_t *bf){return STAT_NOOP;}
+int8_t get_switch_state(int8_t axis, int8_t position){return SW_OPEN;}
+uint8_t get_switch_mode(int8_t axis, int8_t position){return SW_MODE_DISABLED;}
+int8_t get_probe_state(void){return SW_OPEN;}
+void probe_capture_arm(void){}
+void probe_capture_disarm(void){}
+void spindle_set(uint8_t spindle_mode){}
+void coolant_set(uint8_t mist, uint8_t flood){}
+void ld_prep_command(void){}
+void ld_prep_dwell(float seconds){}
+long StartCritical(void){return 0;}			//the runtime isn't an interrupt on the host
+void EndCritical(long sr){}
+void ev_tick_in(uint32_t ms){}				//no tick interrupt to wake on the host
+
+//host_init//
+//input : none
+//output : none
+//fuction : brings up the portable layers the same way main does on the target
+//notes : the target powers up with its memory zeroed, the machine and planner positions are
+//        cleared the same way so every call starts a new machine, whatever ran before it
+//additions: 
+//
+void host_init(void){
+	memset(&cm,0,sizeof(cm));
+	memset(&mm,0,sizeof(mm));
+	memset(&mr,0,sizeof(mr));
+	cm_abort_arc();
+	memset(&db,0,sizeof(db));
+	for(uint8_t i=0; i<EVENTS; ++i){
+		db.event[i].event_min_time = 0xFFFFFFFF;
+	}
+	ld.actuator_runtime_isbusy = _host_runtime_isbusy;
+	mp_init_buffers();
+	canonical_init();
+	config_init();
+	mp_profile_init();
+	config_motors_init();
+	host_plant_init(1/EN_STEPS_PER_COUNT,1.0f);
+	encoder_init();
+	PT_INIT();
+}
+
+//_host_retire//
+//input : none
+//output : false if the queue is empty
+//fuction : frees the oldest planned buffer as if the runtime had executed it
+//notes : the retire of host_drain when the tool doesn't look at the buffers
+//additions:
+//
+static uint8_t _host_retire(void){
+	if(mp_get_run_buffer() == NULL) return false;
+	mp_free_run_buffer();
+	return true;
+}
+
+//host_drain//
+//input : retire function, NULL to only free the buffers
+//output : none
+//fuction : retires planned buffers until the queue is as deep as the controller keeps it
+//notes : the controller waits on PLANNER_BUFFER_LIMIT free buffers before it reads a block,
+//        the host tools drain to it instead so the canonical machine never waits on the planner
+//additions:
+//
+void host_drain(uint8_t (*retire)(void)){
+	if(retire == NULL) retire = _host_retire;
+	while(mp_get_available_buffers() < PLANNER_BUFFER_LIMIT){
+		if(retire() == false) break;
+	}
+}
+
+//host_block//
+//input : block, retire function of host_drain, bound on the callback runs, 0 for none
+//output : parser status
+//fuction : runs one block through the parser, then the cutter compensation and arc
+//          callbacks until they are done, draining the queue between runs
+//notes : the parser works in place, the block is changed. the bound keeps an untrusted arc
+//        from running forever, it is left unfinished then. a block the parser runs again
+//        waits for the compensated move it let go, as the controller does. it's normalized
+//        already and normalizes to itself
+//additions:
+//
+uint8_t host_block(char *block, uint8_t (*retire)(void), uint32_t limit){
+	host_drain(retire);
+	stat_t status = gc_gcode_parser(block);
+	for(uint32_t i=0; ((limit == 0)||(i < limit)) && (status == STAT_RC); ++i){
+		host_drain(retire);
+		if(cm_cutter_comp_callback() != STAT_RC){
+			status = gc_gcode_parser(block);
+		}
+	}
+	for(uint32_t i=0; ((limit == 0)||(i < limit)) && (cm_cutter_comp_callback() == STAT_RC); ++i){
+		host_drain(retire);					//compensated arcs and corners are cut behind the block
+	}
+	for(uint32_t i=0; ((limit == 0)||(i < limit)) && (cm_arc_callback() != STAT_NOOP); ++i){
+		host_drain(retire);					//and arcs are generated after them
+	}
+	return status;
+}
+
+void host_plant_init(float counts_per_step, float gain){
+	memset(&plant,0,sizeof(plant));
+	plant.counts_per_step = counts_per_step;
+	plant.gain = gain;
+}
+
+//host_plant_update//
+//input : steps commanded so far
+//output : none
+//fuction : moves the plant motor one update towards the commanded position
+//notes : 
+//additions: 
+//
+void host_plant_update(int32_t commanded_steps){
+	plant.position += ((float)(commanded_steps - plant.lost) - plant.position)*plant.gain;
+}
+
+void host_plant_lose_steps(int32_t steps){plant.lost += steps;}
+
+uint32_t host_qei_read(void){
+	return (uint32_t)(int32_t)lroundf(plant.position*plant.counts_per_step);
+}
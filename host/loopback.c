@@ -0,0 +1,432 @@
+/*
+ * loopback.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * loopback of the command stream, see protocol.h
+ *
+ * a sender streams a g-code file, or a generated program of short segments, through a
+ * simulated serial link into pc_receive. the controller side reads it the way the controller
+ * loop does, and the reply frames come back through serial_write. the framing, checksums,
+ * sequence checks and the receive ring are the firmware's own code.
+ *
+ *	  sender -> [uplink]   -> pc_receive ... pc_command_callback -> parser -> planner
+ *	     ^                                        |
+ *	     +---- [downlink] <- serial_write <- sr_send_frame
+ *
+ * each link direction sends one byte per 10 bits at the baudrate, SERIAL_BAUDRATE by default,
+ * after a fixed latency.
+ * the runtime retires one planned block every -x microseconds. with the stream keeping the
+ * planner full, the block rate is the runtime's and the planner never starves.
+ * -w streams send and wait instead, one line in flight at a time, for comparison.
+ * -e corrupts one byte of every Nth line on the wire to exercise the resend.
+ *
+ * the run fails if a line is lost, executed twice or out of order, or if the receive ring
+ * overflows.
+ *
+ * build:
+ *	make -C host loopback
+ *	it has no reference figures, its block rates are only comparable between runs of the same build.
+ *
+ * usage:
+ *	loopback [-w] [-b baudrate] [-l latency_us] [-x us_per_block] [-e every_nth_line] [-n lines] [file.nc]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "serial.h"
+#include "report.h"
+#include "protocol.h"
+
+#define LB_USAGE "usage: %s [-w] [-b baudrate] [-l latency_us] [-x us_per_block] [-e every_nth_line] [-n lines] [file.nc]\n"
+#define LB_STEP_NS 10000ULL						//simulation step, 10us
+#define LB_TIMEOUT_NS 600000000000ULL		//10 minutes of simulated time
+#define LB_LINK_SIZE 4096								//bytes on a wire, power of 2
+#define LB_DEFAULT_LATENCY 2000					//us each way, a USB serial adapter
+#define LB_DEFAULT_EXEC 1000						//us per block, 1000 blocks per second
+#define LB_DEFAULT_LINES 2000
+#define LB_SEGMENT 0.05f								//mm, generated program
+#define LB_WIRE_EXTRA 16								//"N4294967295 " and "*255" around a program line
+
+typedef struct lbLink{
+	uint8_t buf[LB_LINK_SIZE];
+	uint64_t arrival[LB_LINK_SIZE];
+	uint32_t head;
+	uint32_t tail;
+	uint64_t busy_until;							//the last byte put leaves the UART
+}lbLink_t;
+
+typedef struct lbSent{
+	uint32_t linenum;
+	uint16_t length;									//bytes on the wire with the '\n'
+	uint32_t generation;							//resends so far when it was sent
+}lbSent_t;
+
+typedef struct lbFrame{
+	uint8_t state;										//bytes of the frame read so far
+	uint8_t type;
+	uint8_t length;
+	uint8_t checksum;
+	uint8_t payload[SR_FRAME_MAX_SIZE];
+}lbFrame_t;
+
+typedef struct loopback{
+	uint64_t now;											//ns
+	uint64_t byte_ns;
+	uint64_t latency_ns;
+	uint64_t exec_ns;
+	uint8_t wait;											//send and wait
+	uint32_t corrupt_every;
+
+	char **lines;
+	uint32_t line_count;
+
+	lbLink_t up;
+	lbLink_t down;
+	lbFrame_t frame;
+
+	lbSent_t sent[PC_RX_BUFFER_SIZE];	//unanswered lines, each one is a byte at least
+	uint16_t sent_head;
+	uint16_t sent_tail;
+	uint16_t sent_bytes;
+	uint32_t next_line;								//1 based
+	uint32_t generation;
+	uint32_t corrupted;								//last line corrupted, a resend goes through
+
+	uint32_t done;										//lines replied STAT_OK, in order
+	uint32_t resends;
+	uint32_t failures;								//lost, repeated or out of order lines, overflows
+	uint32_t block_errors;						//g-code errors of the program itself
+	uint16_t rx_max;
+	uint64_t retire_at;
+	uint64_t starved_ns;							//planner empty with lines left to send
+	uint32_t blocks;
+}loopback_t;
+
+static loopback_t lb;
+
+static void _lb_put(lbLink_t *l, uint8_t c);
+static uint8_t _lb_get(lbLink_t *l, uint8_t *c);
+static void _lb_send(void);
+static void _lb_receive(void);
+static void _lb_reply(uint32_t linenum, uint8_t status, uint8_t buffers);
+static void _lb_controller(void);
+static void _lb_runtime(void);
+
+/* --- the firmware's serial driver, the downlink stands in for the TX ring --- */
+
+uint16_t serial_tx_free(void){
+	uint64_t queued = (lb.down.busy_until > lb.now)? (lb.down.busy_until - lb.now + lb.byte_ns - 1)/lb.byte_ns : 0;
+	return (queued >= SERIAL_TX_BUFFER_SIZE-1)? 0 : (uint16_t)(SERIAL_TX_BUFFER_SIZE-1-queued);
+}
+
+stat_t serial_write(const uint8_t *data, uint16_t length){
+	if(length > serial_tx_free()){
+		return STAT_BUFFER_FULL;
+	}
+	for(uint16_t i=0; i<length; ++i){
+		_lb_put(&lb.down,data[i]);
+	}
+	return STAT_OK;
+}
+
+//_lb_put//
+//input : link, byte
+//output : none
+//fuction : sends a byte after the ones already on the link
+//notes :
+//additions:
+//
+static void _lb_put(lbLink_t *l, uint8_t c){
+	if(l->head - l->tail > LB_LINK_SIZE-1){
+		fprintf(stderr,"link overflow\n");
+		exit(2);
+	}
+	uint64_t start = (l->busy_until > lb.now)? l->busy_until : lb.now;
+	l->busy_until = start + lb.byte_ns;
+	l->buf[l->head & (LB_LINK_SIZE-1)] = c;
+	l->arrival[l->head & (LB_LINK_SIZE-1)] = l->busy_until + lb.latency_ns;
+	l->head++;
+}
+
+static uint8_t _lb_get(lbLink_t *l, uint8_t *c){
+	if((l->tail == l->head) || (l->arrival[l->tail & (LB_LINK_SIZE-1)] > lb.now)){
+		return false;
+	}
+	*c = l->buf[l->tail & (LB_LINK_SIZE-1)];
+	l->tail++;
+	return true;
+}
+
+//_lb_send//
+//input : none
+//output : none
+//fuction : sends the next lines while the unanswered bytes fit the receive ring
+//notes : N and the checksum are added here, the program lines carry neither
+//additions:
+//
+static void _lb_send(void){
+	while(lb.next_line <= lb.line_count){
+		if(lb.wait && (lb.sent_head != lb.sent_tail)) return;
+		char wire[PC_LINE_SIZE+16];
+		const char *text = lb.lines[lb.next_line-1];
+		int length = (*text == '/')?		//block delete stays the first character
+			snprintf(wire,sizeof(wire),"/N%u %s",lb.next_line,text+1) : snprintf(wire,sizeof(wire),"N%u %s",lb.next_line,text);
+		int body = length;
+		uint8_t checksum = 0;
+		for(int i=0; i<length; ++i){checksum ^= (uint8_t)wire[i];}
+		length += snprintf(&wire[length],sizeof(wire)-length,"*%u\n",checksum);
+		if(lb.sent_bytes + length > PC_RX_BUFFER_SIZE-1) return;
+		if(lb.corrupt_every && (lb.next_line % lb.corrupt_every == 0) && (lb.next_line > lb.corrupted)){
+			wire[body/2] ^= 0x01;						//before the '*', a printable byte stays printable
+			lb.corrupted = lb.next_line;
+		}
+		for(int i=0; i<length; ++i){
+			_lb_put(&lb.up,(uint8_t)wire[i]);
+		}
+		lbSent_t *s = &lb.sent[lb.sent_head++ & (PC_RX_BUFFER_SIZE-1)];
+		s->linenum = lb.next_line++;
+		s->length = (uint16_t)length;
+		s->generation = lb.generation;
+		lb.sent_bytes += length;
+	}
+}
+
+//_lb_receive//
+//input : none
+//output : none
+//fuction : reads the frames off the downlink
+//notes : SYNC TYPE LEN PAYLOAD CHECKSUM, see report.c
+//additions:
+//
+static void _lb_receive(void){
+	uint8_t c;
+	lbFrame_t *f = &lb.frame;
+	while(_lb_get(&lb.down,&c)){
+		if(f->state == 0){
+			if(c == SR_SYNC) f->state = 1;
+		}else if(f->state == 1){
+			f->type = c;
+			f->checksum = c;
+			f->state = 2;
+		}else if(f->state == 2){
+			f->length = c;
+			f->checksum ^= c;
+			f->state = 3;
+		}else if(f->state < f->length+3){
+			f->payload[f->state-3] = c;
+			f->checksum ^= c;
+			f->state++;
+		}else{
+			f->state = 0;
+			if((c != f->checksum) || (f->type != SR_FRAME_REPLY) || (f->length != PC_REPLY_SIZE-4)){
+				fprintf(stderr,"bad frame type %c length %u\n",f->type,f->length);
+				lb.failures++;
+				continue;
+			}
+			uint32_t linenum;
+			memcpy(&linenum,f->payload,sizeof(linenum));
+			_lb_reply(linenum,f->payload[4],f->payload[5]);
+		}
+	}
+}
+
+//_lb_reply//
+//input : reply of a line
+//output : none
+//fuction : frees the bytes of the oldest line and resends from a line the link broke
+//notes : the lines sent behind a broken one fail the sequence check, only the first
+//failure of a generation rewinds
+//additions:
+//
+static void _lb_reply(uint32_t linenum, uint8_t status, uint8_t buffers){
+	if(lb.sent_head == lb.sent_tail){
+		fprintf(stderr,"reply to line %u with nothing sent\n",linenum);
+		lb.failures++;
+		return;
+	}
+	lbSent_t *s = &lb.sent[lb.sent_tail++ & (PC_RX_BUFFER_SIZE-1)];
+	lb.sent_bytes -= s->length;
+	if((status == STAT_CHECKSUM_MISMATCH) || (status == STAT_LINENUM_SEQUENCE)){
+		if(s->generation == lb.generation){
+			lb.next_line = s->linenum;
+			lb.generation++;
+			lb.resends++;
+		}
+		return;
+	}
+	if(linenum != s->linenum){
+		fprintf(stderr,"reply to line %u for line %u\n",linenum,s->linenum);
+		lb.failures++;
+	}else if(linenum != lb.done+1){
+		fprintf(stderr,"line %u executed after line %u\n",linenum,lb.done);
+		lb.failures++;
+	}
+	lb.done = linenum;
+	if(status == STAT_BUFFER_FULL){
+		fprintf(stderr,"receive ring overflow before line %u\n",linenum);
+		lb.failures++;
+	}else if(status != STAT_OK){
+		fprintf(stderr,"line %u: status %u\n",linenum,status);
+		lb.block_errors++;
+	}
+}
+
+//_lb_controller//
+//input : none
+//output : none
+//fuction : one pass of the controller loop over the stream
+//notes : the UART ISR hands the arrived bytes over first, then the callbacks in the
+//order of _controller_HSM, one line per pass
+//additions:
+//
+static void _lb_controller(void){
+	uint8_t c;
+	while(_lb_get(&lb.up,&c)){
+		pc_receive(c);
+	}
+	uint16_t used = (pc.rx.head - pc.rx.tail) & PC_RX_BUFFER_MASK;
+	if(used > lb.rx_max) lb.rx_max = used;
+	if(cm_cutter_comp_callback() == STAT_RC) return;
+	if(cm_arc_callback() == STAT_RC) return;
+	if(mp_get_available_buffers() < PLANNER_BUFFER_LIMIT) return;		//_sync_to_planner
+	pc_command_callback();
+}
+
+//_lb_runtime//
+//input : none
+//output : none
+//fuction : retires the oldest planned block every exec_ns
+//notes : a block queued on an idle runtime takes a whole exec_ns
+//additions:
+//
+static void _lb_runtime(void){
+	if(mp_get_run_buffer() == NULL){
+		lb.retire_at = lb.now + lb.exec_ns;
+		if(lb.done < lb.line_count) lb.starved_ns += LB_STEP_NS;
+		return;
+	}
+	if(lb.now < lb.retire_at) return;
+	mp_free_run_buffer();
+	lb.blocks++;
+	lb.retire_at = lb.now + lb.exec_ns;
+}
+
+//_lb_load//
+//input : g-code file, NULL for the generated program
+//output : false if the file can't be read or has a line too long to stream
+//fuction : loads the program lines
+//notes : the generated program is a circle of LB_SEGMENT chords. the N words of a file are
+//dropped, the sender numbers the lines
+//additions:
+//
+static uint8_t _lb_load(const char *path, uint32_t count){
+	char text[PC_LINE_SIZE];
+	uint32_t size = 0;
+	if(path == NULL){
+		lb.lines = malloc(sizeof(char*)*(count+2));
+		lb.lines[lb.line_count++] = strdup("G21 G90 G17 G94 F3000");
+		float radius = LB_SEGMENT*count/(2*M_PI);
+		for(uint32_t i=1; i<=count; ++i){
+			float angle = 2*M_PI*i/count;
+			snprintf(text,sizeof(text),"G1 X%.4f Y%.4f",radius*cosf(angle),radius*sinf(angle));
+			lb.lines[lb.line_count++] = strdup(text);
+		}
+		return true;
+	}
+	FILE *in = fopen(path,"r");
+	if(in == NULL){
+		perror(path);
+		return false;
+	}
+	while(fgets(text,sizeof(text),in) != NULL){
+		size_t length = strcspn(text,"\r\n");
+		if(length > PC_LINE_SIZE-1-LB_WIRE_EXTRA){
+			fprintf(stderr,"%s:%u: line too long\n",path,lb.line_count+1);
+			fclose(in);
+			return false;
+		}
+		text[length] = NUL;
+		char *block = text + strspn(text," \t");
+		if((*block == 'N') || (*block == 'n')){
+			block += 1 + strspn(block+1," \t0123456789");
+		}
+		if(strchr(text,'*') != NULL){
+			fprintf(stderr,"%s:%u: '*' would end the line\n",path,lb.line_count+1);
+			fclose(in);
+			return false;
+		}
+		if(lb.line_count == size){
+			size = (size == 0)? 1024 : 2*size;
+			lb.lines = realloc(lb.lines,sizeof(char*)*size);
+		}
+		lb.lines[lb.line_count++] = strdup(block);
+	}
+	fclose(in);
+	return true;
+}
+
+int main(int argc, char *argv[]){
+	int o;
+	uint32_t latency = LB_DEFAULT_LATENCY;
+	uint32_t exec = LB_DEFAULT_EXEC;
+	uint32_t count = LB_DEFAULT_LINES;
+	uint32_t baudrate = SERIAL_BAUDRATE;
+	memset(&lb,0,sizeof(lb));
+	while((o = getopt(argc,argv,"wb:l:x:e:n:")) != -1){
+		switch(o){
+			case 'w': lb.wait = true; break;
+			case 'b': baudrate = (uint32_t)atoi(optarg); break;
+			case 'l': latency = (uint32_t)atoi(optarg); break;
+			case 'x': exec = (uint32_t)atoi(optarg); break;
+			case 'e': lb.corrupt_every = (uint32_t)atoi(optarg); break;
+			case 'n': count = (uint32_t)atoi(optarg); break;
+			default:
+				fprintf(stderr,LB_USAGE,argv[0]);
+				return 2;
+		}
+	}
+	if((count == 0) || (exec == 0) || (baudrate == 0) || (optind+1 < argc)){
+		fprintf(stderr,LB_USAGE,argv[0]);
+		return 2;
+	}
+	if(_lb_load((optind < argc)? argv[optind] : NULL,count) == false) return 2;
+	lb.byte_ns = 10000000000ULL/baudrate;
+	lb.latency_ns = (uint64_t)latency*1000;
+	lb.exec_ns = (uint64_t)exec*1000;
+	lb.next_line = 1;
+
+	host_init();
+	pc_init();
+	sr_init();
+	while(((lb.done < lb.line_count) || (mp_get_run_buffer() != NULL)) && (lb.now < LB_TIMEOUT_NS)){
+		_lb_send();
+		_lb_controller();
+		_lb_runtime();
+		_lb_receive();
+		lb.now += LB_STEP_NS;
+	}
+
+	if(lb.done < lb.line_count){
+		fprintf(stderr,"timed out at line %u of %u\n",lb.done,lb.line_count);
+		lb.failures++;
+	}
+	double seconds = lb.now*1e-9;
+	printf("%s, %u lines, %u blocks in %.3f s, %.0f blocks/s (runtime %.0f)\n",
+		(lb.wait)? "send and wait" : "character counting",lb.line_count,lb.blocks,seconds,
+		lb.blocks/seconds,1e9/lb.exec_ns);
+	printf("planner starved %.3f s, rx ring peak %u of %u, resends %u, g-code errors %u, failures %u\n",
+		lb.starved_ns*1e-9,lb.rx_max,PC_RX_BUFFER_SIZE-1,lb.resends,lb.block_errors,lb.failures);
+	return (lb.failures != 0);
+}
@@ -0,0 +1,331 @@
+/*
+ * pipeline.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * staged estimator run, the parser and the planner each on their own thread with the
+ * accounting on a third, handing off over rings the way the firmware hands off to its
+ * planner and runtime:
+ *
+ *	read/parse/canonical -> [request ring] -> plan/retire -> [block ring] -> exec/accounting
+ *	(controller loop)                         (planner)                     (loader)
+ *
+ * the estimator links with --wrap for the calls the canonical machine makes into the planner
+ * (Makefile EST_WRAP). on the parse thread they copy their arguments into a request and
+ * return, the planner thread makes the real call. the parse thread has a machine of its own
+ * (MACHINE_LOCAL) whose planner stays empty, so the arc and cutter compensation callbacks never
+ * wait on it. the planner thread is the calling thread, est_init brought its machine up.
+ *
+ * the queue depth has to be the same with and without the rings or the blocks are planned
+ * with a different look ahead. so in both runs every queued buffer first retires the oldest
+ * ones down to PLANNER_BUFFER_LIMIT free, _pipe_sync, and the planner sees the same calls
+ * with the same retires between them in the same order. the report is identical, make -C
+ * host check compares them.
+ *
+ * every stage times the cpu it used, -p prints them. the wall time of the staged run is
+ * bound by its slowest stage, the sequential run by their sum.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "plan_command.h"
+#include "util.h"
+#include "estimator.h"
+#include "spsc.h"
+
+#define PIPE_REQUEST_QUEUE 4096			//planner calls the parser is ahead by
+#define PIPE_BLOCK_QUEUE 4096				//retired blocks waiting for accounting
+
+enum pipeRequestType{
+	PIPE_END = 0,									//the parser is done with the file
+	PIPE_PLAN_LINE,
+	PIPE_QUEUE_COMMAND,
+	PIPE_QUEUE_DWELL,
+	PIPE_PLANNER_POSITION,
+	PIPE_RUNTIME_POSITION
+};
+
+typedef struct pipeRequest{
+	uint8_t type;
+	uint8_t axis;									//position requests
+	float position;
+	void (*cm_exec)(float *value, float *flag);
+	float value[AXES];
+	float flag[AXES];
+	GState_t gm;									//the move, or cm.gm the command and dwell blocks copy
+}pipeRequest_t;
+
+typedef struct pipeBlock{
+	uint32_t linenum;
+	float time;
+	uint8_t last;
+}pipeBlock_t;
+
+typedef struct pipeline{
+	spsc_t requests;
+	spsc_t blocks;
+	FILE *in;
+	uint32_t line_count;
+	uint32_t range_size;
+	uint32_t errors;							//parser errors, counted on the parse thread
+	uint32_t first_error_line;
+	double cpu[3];								//seconds of cpu of the parse, plan and exec stages
+	est_t *est;										//estimate of the calling thread, filled by the exec stage
+}pipeline_t;
+
+static MACHINE_LOCAL pipeline_t *pp;		//pipeline of the parse stage on this thread
+static MACHINE_LOCAL pipeline_t *pl;		//pipeline of the planner stage on this thread
+
+stat_t __real_mp_plan_line(GState_t *gmod);
+stat_t __real_mp_queue_command(void(*cm_exec)(float*, float*), float *value, float *flag);
+stat_t __real_mp_queue_dwell(float seconds);
+void __real_mp_set_planner_position(uint8_t axis, float position);
+void __real_mp_set_runtime_position(uint8_t axis, float position);
+
+//_pipe_cpu//
+//input : none
+//output : cpu seconds the calling thread used so far
+//fuction :
+//notes :
+//additions:
+//
+static double _pipe_cpu(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID,&ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+//_pipe_push//
+//input : queue, element
+//output : none
+//fuction : blocking push, the producing stage yields while the next stage catches up
+//notes :
+//additions:
+//
+static void _pipe_push(spsc_t *q, const void *elem){
+	while(spsc_push(q,elem) == false){
+		sched_yield();
+	}
+}
+
+static void _pipe_pop(spsc_t *q, void *elem){
+	while(spsc_pop(q,elem) == false){
+		sched_yield();
+	}
+}
+
+//_pipe_sync//
+//input : none
+//output : none
+//fuction : retires the oldest buffers until PLANNER_BUFFER_LIMIT are free
+//notes : runs before every queued buffer, on the calling thread of a sequential run and on the
+//planner thread of a staged one, so the look ahead of every block is the same in both
+//additions:
+//
+static void _pipe_sync(void){
+	host_drain(est_retire);
+}
+
+//_pipe_request//
+//input : request
+//output : none
+//fuction : parse stage side of the wrapped planner calls, hands the request to the planner
+//notes :
+//additions:
+//
+static void _pipe_request(const pipeRequest_t *req){
+	_pipe_push(&pp->requests,req);
+}
+
+stat_t __wrap_mp_plan_line(GState_t *gmod){
+	if(pp != NULL){
+		pipeRequest_t req = {.type = PIPE_PLAN_LINE};
+		memcpy(&req.gm,gmod,sizeof(GState_t));
+		_pipe_request(&req);
+#if FEATURE_INVERSE_TIME
+		//_calc_move_time turns an inverse time feed back to units per minute in the caller's model
+		if((gmod->motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) && (gmod->feedrate_mode == INVERSE_TIME_MODE)){
+			gmod->feedrate_mode = UNITS_PER_MINUTE_MODE;
+		}
+#endif
+		return STAT_OK;								//the canonical machine doesn't look at it
+	}
+	_pipe_sync();
+	return __real_mp_plan_line(gmod);
+}
+
+stat_t __wrap_mp_queue_command(void(*cm_exec)(float*, float*), float *value, float *flag){
+	if(pp != NULL){
+		pipeRequest_t req = {.type = PIPE_QUEUE_COMMAND, .cm_exec = cm_exec};
+		copy_vector(req.value,value);
+		copy_vector(req.flag,flag);
+		memcpy(&req.gm,&cm.gm,sizeof(GState_t));
+		_pipe_request(&req);
+		return STAT_OK;
+	}
+	_pipe_sync();
+	return __real_mp_queue_command(cm_exec,value,flag);
+}
+
+stat_t __wrap_mp_queue_dwell(float seconds){
+	if(pp != NULL){
+		pipeRequest_t req = {.type = PIPE_QUEUE_DWELL, .position = seconds};
+		memcpy(&req.gm,&cm.gm,sizeof(GState_t));
+		_pipe_request(&req);
+		return STAT_OK;
+	}
+	_pipe_sync();
+	return __real_mp_queue_dwell(seconds);
+}
+
+void __wrap_mp_set_planner_position(uint8_t axis, float position){
+	if(pp != NULL){
+		pipeRequest_t req = {.type = PIPE_PLANNER_POSITION, .axis = axis, .position = position};
+		_pipe_request(&req);
+		return;
+	}
+	__real_mp_set_planner_position(axis,position);
+}
+
+void __wrap_mp_set_runtime_position(uint8_t axis, float position){
+	if(pp != NULL){
+		pipeRequest_t req = {.type = PIPE_RUNTIME_POSITION, .axis = axis, .position = position};
+		_pipe_request(&req);
+		return;
+	}
+	__real_mp_set_runtime_position(axis,position);
+}
+
+//_pipe_account//
+//input : estimate, line number and time of a retired block
+//output : none
+//fuction : planner stage retire hook, hands the block to the exec stage
+//notes :
+//additions:
+//
+static void _pipe_account(est_t *e, uint32_t linenum, float time){
+	pipeBlock_t blk = {linenum,time,false};
+	_pipe_push(&pl->blocks,&blk);
+}
+
+//_pipe_parser//
+//input : the pipeline
+//output : none
+//fuction : the controller loop stage, reads the file and runs every block on this thread's machine
+//notes : its planner calls go to the request ring, its parser errors are handed back in the pipeline
+//additions:
+//
+static void *_pipe_parser(void *arg){
+	pipeline_t *p = arg;
+	pipeRequest_t end = {.type = PIPE_END};
+	char line[EST_LINE_SIZE];
+	uint32_t lines = 0;
+	est_init(p->range_size);
+	pp = p;
+	while(fgets(line,sizeof(line),p->in) != NULL){
+		line[strcspn(line,"\r\n")] = NUL;
+		est_block(line,++lines);
+	}
+	p->line_count = lines;
+	p->errors = est.errors;
+	p->first_error_line = est.first_error_line;
+	p->cpu[0] = _pipe_cpu();
+	_pipe_request(&end);
+	pp = NULL;
+	return NULL;
+}
+
+static void *_pipe_exec(void *arg){
+	pipeline_t *p = arg;
+	pipeBlock_t blk;
+	double start = _pipe_cpu();
+	for(;;){
+		_pipe_pop(&p->blocks,&blk);
+		if(blk.last) break;
+		est_account(p->est,blk.linenum,blk.time);
+	}
+	p->cpu[2] = _pipe_cpu() - start;
+	return NULL;
+}
+
+//_pipe_planner//
+//input : none
+//output : none
+//fuction : the planner stage, makes the planner calls of the parse stage in their order
+//notes : runs on the calling thread, that thread owns the machine (MACHINE_LOCAL) est_init brought up.
+//the command and dwell blocks copy cm.gm, it is the parse stage's cm.gm of the request
+//additions:
+//
+static void _pipe_planner(void){
+	pipeRequest_t req;
+	pipeBlock_t end = {0,0,true};
+	double start = _pipe_cpu();
+	for(;;){
+		_pipe_pop(&pl->requests,&req);
+		if(req.type == PIPE_END) break;
+		switch(req.type){
+			case PIPE_PLAN_LINE: mp_plan_line(&req.gm); break;
+			case PIPE_QUEUE_COMMAND:
+				memcpy(&cm.gm,&req.gm,sizeof(GState_t));
+				mp_queue_command(req.cm_exec,req.value,req.flag);
+				break;
+			case PIPE_QUEUE_DWELL:
+				memcpy(&cm.gm,&req.gm,sizeof(GState_t));
+				mp_queue_dwell(req.position);
+				break;
+			case PIPE_PLANNER_POSITION: mp_set_planner_position(req.axis,req.position); break;
+			case PIPE_RUNTIME_POSITION: mp_set_runtime_position(req.axis,req.position); break;
+		}
+	}
+	est_finish();
+	pl->cpu[1] = _pipe_cpu() - start;
+	_pipe_push(&pl->blocks,&end);
+}
+
+//est_pipeline//
+//input : g-code file, storage for the cpu seconds of the parse, plan and exec stages
+//output : number of lines read, 0 if the stages could not be started
+//fuction : runs the whole file through the threaded pipeline
+//notes : est_init must have been called, the result is in est as for the sequential path
+//additions:
+//
+uint32_t est_pipeline(FILE *in, double stage_cpu[3]){
+	pthread_t parser, exec;
+	pipeline_t p;
+	memset(&p,0,sizeof(p));
+	p.in = in;
+	p.est = &est;
+	p.range_size = est.range_size;
+	if((spsc_init(&p.requests,PIPE_REQUEST_QUEUE,sizeof(pipeRequest_t)) == false) ||
+		 (spsc_init(&p.blocks,PIPE_BLOCK_QUEUE,sizeof(pipeBlock_t)) == false)){
+		spsc_free(&p.requests);
+		return 0;
+	}
+	pl = &p;
+	est.retire_hook = _pipe_account;
+	pthread_create(&exec,NULL,_pipe_exec,&p);
+	pthread_create(&parser,NULL,_pipe_parser,&p);
+	_pipe_planner();
+	pthread_join(parser,NULL);
+	pthread_join(exec,NULL);
+	est.retire_hook = est_account;
+	est.errors = p.errors;
+	est.first_error_line = p.first_error_line;
+	pl = NULL;
+	spsc_free(&p.requests);
+	spsc_free(&p.blocks);
+	memcpy(stage_cpu,p.cpu,sizeof(p.cpu));
+	return p.line_count;
+}
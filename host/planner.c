@@ -0,0 +1,154 @@
+/*
+ * planner.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * host stand-in for the firmware's planner buffer pool, which this snapshot doesn't carry,
+ * following what the firmware object does. mp_plan_line and mp_queue_command never commit the
+ * buffer they take (mp_commit_write_buffer is commented out in line_planner.c), so on the host
+ * mp_get_write_buffer queues it right away, the block is planned as soon as it's taken and
+ * mb.queptr stays on mb.wrtptr as mp_drop_queued_lines expects
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "kinematics.h"
+#include "encoder.h"
+
+MACHINE_LOCAL mpBufPool_t mb;
+MACHINE_LOCAL mpMstMov_t mm;
+MACHINE_LOCAL mpRunMov_t mr;
+
+static void _clear_buffer(mpBuf_t *bf){
+	mpBuf_t *nx = bf->nx;
+	mpBuf_t *pv = bf->pv;
+	memset(bf,0,sizeof(mpBuf_t));
+	bf->nx = nx;
+	bf->pv = pv;
+}
+
+//mp_init_buffers//
+//input : none
+//output : none
+//fuction : links the pool into a ring and empties it
+//notes : 
+//additions: 
+//
+void mp_init_buffers(void){
+	memset(&mb,0,sizeof(mb));
+	mb.wrtptr = &mb.bf[0];
+	mb.queptr = &mb.bf[0];
+	mb.runptr = &mb.bf[0];
+	mb.planptr = &mb.bf[0];
+	mpBuf_t *pv = &mb.bf[PLANNER_BUFFER_POOL_SIZE-1];
+	for(uint8_t i=0; i<PLANNER_BUFFER_POOL_SIZE; ++i){
+		mb.bf[i].nx = &mb.bf[(i == PLANNER_BUFFER_POOL_SIZE-1)? 0 : i+1];
+		mb.bf[i].pv = pv;
+		pv = &mb.bf[i];
+	}
+	mb.available = PLANNER_BUFFER_POOL_SIZE;
+}
+
+uint8_t mp_get_available_buffers(void){return mb.available;}
+
+//mp_get_write_buffer//
+//input : none
+//output : empty buffer, NULL when the pool is full
+//fuction : takes the next buffer of the pool for a block
+//notes : queued right away, see the file notes
+//additions: 
+//
+mpBuf_t *mp_get_write_buffer(void){
+	if(mb.wrtptr->buffer_state != MP_BUFFER_EMPTY){
+		return NULL;
+	}
+	mpBuf_t *bf = mb.wrtptr;
+	_clear_buffer(bf);
+	bf->buffer_state = MP_BUFFER_QUEUED;
+	mb.available--;
+	mb.wrtptr = bf->nx;
+	mb.queptr = mb.wrtptr;
+	return bf;
+}
+
+void mp_unget_write_buffer(void){
+	mb.wrtptr = mb.wrtptr->pv;
+	mb.wrtptr->buffer_state = MP_BUFFER_EMPTY;
+	mb.available++;
+}
+
+mpBuf_t *mp_get_latest_queued_buffer(void){return mb.wrtptr->pv;}
+
+//mp_get_run_buffer//
+//input : none
+//output : the running buffer, NULL when nothing is queued
+//fuction : 
+//notes : 
+//additions: 
+//
+mpBuf_t *mp_get_run_buffer(void){
+	if((mb.runptr->buffer_state == MP_BUFFER_QUEUED) ||
+		 (mb.runptr->buffer_state == MP_BUFFER_PENDING)){
+		mb.runptr->buffer_state = MP_BUFFER_RUNNING;
+	}
+	if(mb.runptr->buffer_state == MP_BUFFER_RUNNING){
+		return mb.runptr;
+	}
+	return NULL;
+}
+
+//mp_free_run_buffer//
+//input : none
+//output : true when the queue is empty after it
+//fuction : releases the running buffer and moves the run pointer to the next one
+//notes : 
+//additions: 
+//
+uint8_t mp_free_run_buffer(void){
+	_clear_buffer(mb.runptr);
+	mb.runptr = mb.runptr->nx;
+	if(mb.runptr->buffer_state == MP_BUFFER_QUEUED){
+		mb.runptr->buffer_state = MP_BUFFER_PENDING;
+	}
+	mb.available++;
+	return (mb.wrtptr == mb.runptr);
+}
+
+mpBuf_t *mp_get_next_buffer(const mpBuf_t *bf){return bf->nx;}
+mpBuf_t *mp_get_prev_buffer(const mpBuf_t *bf){return bf->pv;}
+
+void mp_flush_planner(void){
+	cm_abort_arc();
+	mp_init_buffers();
+	cm_set_motion_state(MOTION_STOP);
+}
+
+//mp_set_steps_to_runtime_position//
+//input : none
+//output : none
+//fuction : puts the motor and encoder steps at the runtime position
+//notes : 
+//additions: 
+//
+void mp_set_steps_to_runtime_position(void){
+	float step_position[MOTORS];
+	kn_inverse_kinematics(mr.position,step_position);
+	for(uint8_t motor=0; motor<MOTORS; ++motor){
+		mr.target_units[motor] = step_position[motor];
+		mr.prev_position_units[motor] = step_position[motor];
+		mr.curr_position_units[motor] = step_position[motor];
+		en_set_encoder_steps(motor,step_position[motor]);
+		mr.following_error[motor] = 0;
+	}
+}
+
+float mp_get_runtime_absolute_position(uint8_t axis){return mr.position[axis];}
+float mp_get_runtime_work_position(uint8_t axis){return (mr.position[axis] - mr.gm.work_offset[axis]);}
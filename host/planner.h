@@ -0,0 +1,215 @@
+// planner.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	host stand-in for the firmware's planner.h, which this snapshot doesn't carry, with the
+	buffer pool of host/planner.c and the jerk profile of host/profile_generator.c. the buffer,
+	pool and runtime layouts and the constants are the ones the firmware was built with, read
+	back from its objects. the runtime (plan_exec.c, stepper.c) isn't on the host, mr only holds
+	what the portable layers read from it
+*/
+
+#ifndef PLANNER_H
+#define PLANNER_H
+
+#include "canonical.h"
+
+#define POOL_SIZE (uint8_t)50
+#define PLANNER_BUFFER_POOL_SIZE POOL_SIZE
+#define SECTIONS 3
+
+#define NOM_SEGMENT_USEC 5000.0f
+#define MIN_SEGMENT_USEC 2500.0f
+#define MIN_ARC_SEGMENT_USEC 10000.0f
+#define MICROSECONDS_PER_MINUTE 60000000.0f
+#define NOM_SEGMENT_TIME (NOM_SEGMENT_USEC / MICROSECONDS_PER_MINUTE)
+#define MIN_SEGMENT_TIME (MIN_SEGMENT_USEC / MICROSECONDS_PER_MINUTE)
+#define MIN_TIME_MOVE MIN_SEGMENT_TIME
+#define MIN_BLOCK_TIME MIN_SEGMENT_TIME
+
+#define MIN_RADIUS_ARC 0.1f
+#define ARC_RADIUS_ERROR_MAX 0.5f				//mm the end of an arc may be off its radius
+#define ARC_RADIUS_ERROR_MIN 0.005f
+#define ARC_RADIUS_TOLERANCE 0.001f			//of the radius, between the two above
+#define CHORDAL_TOLERANCE 0.01f
+#define ARC_SEGMENT_LENGTH 0.1f
+
+#define JERK_MATCH_PRECISION 1000.0f		//mm.jerk follows a block jerk further off than this
+#define JERK_MULTI 1000000.0f
+#define JERK_MULTI_SQRT 1000.0f
+#define JERK_MULTI_CBRT 100.0f
+#define K_dv 0.8848579141f							//delta_vmax = K_dv*cbrt(L^2*J), see mp_get_deltav_max
+#define K_l 1.201405707f								//L = K_l*sqrt(dv^3/J), see mp_get_target_length
+#define K_t 2.402811414f
+
+#define PLANNER_BUFFER_LIMIT 5					//free buffers the controller keeps, _sync_to_planner
+
+enum mpBufferState{
+	MP_BUFFER_EMPTY = 0,
+	MP_BUFFER_LOADING,
+	MP_BUFFER_QUEUED,
+	MP_BUFFER_PENDING,
+	MP_BUFFER_RUNNING
+};
+
+enum moveType{
+	MOVE_TYPE_NULL = 0,
+	MOVE_TYPE_ALINE,
+	MOVE_TYPE_DWELL,
+	MOVE_TYPE_COMMAND,
+	MOVE_TYPE_TOOL,
+	MOVE_TYPE_SPINDLE_SPEED,
+	MOVE_TYPE_STOP,
+	MOVE_TYPE_END
+};
+
+enum moveState{
+	MOVE_OFF = 0,
+	MOVE_NEW,
+	MOVE_RUN
+};
+
+enum moveSection{
+	SECTION_HEAD = 0,
+	SECTION_BODY,
+	SECTION_TAIL
+};
+
+typedef struct mpBuffer{
+	struct mpBuffer *nx;
+	struct mpBuffer *pv;
+	stat_t (*bf_fun)(struct mpBuffer *bf);			//runtime of the block, mp_exec_line for lines
+	void (*cm_fun)(float *value, float *flag);	//canonical callback of a command block
+	float estm_move_time;
+
+	uint8_t buffer_state;
+	uint8_t move_type;
+	uint8_t move_state;
+	uint8_t replanned;
+	uint8_t jerk_axis;
+
+	float jerk;
+	float jerk_recip;
+	float jerk_sqrt;
+	float jerk_sqrt_recip;
+	float jerk_cbrt;
+	float jerk_cbrt_recip;
+
+	float unit[AXES];
+	float length;
+	float length_sqr_cbrt;
+	float head_length;
+	float body_length;
+	float tail_length;
+
+	float entry_velocity;
+	float cruise_velocity;
+	float exit_velocity;
+	float entry_vmax;
+	float cruise_vmax;
+	float exit_vmax;
+	float delta_vmax;
+	float braking_velocity;
+
+	GState_t gm;
+}mpBuf_t;
+
+typedef struct mpBufferPool{
+	uint8_t available;
+	mpBuf_t *wrtptr;				//next buffer to take
+	mpBuf_t *queptr;				//next buffer to queue
+	mpBuf_t *runptr;				//buffer the runtime runs
+	mpBuf_t *planptr;
+	mpBuf_t bf[PLANNER_BUFFER_POOL_SIZE];
+}mpBufPool_t;
+
+typedef struct mpMasterMove{
+	float position[AXES];		//end of the last planned block
+	float jerk;							//jerk of the last block, the estimate of mp_plan_line
+	float jerk_cbrt;
+	float jerk_recip;
+	float jerk_cbrt_recip;
+}mpMstMov_t;
+
+typedef struct mpRuntimeMove{
+	uint8_t move_state;
+	uint8_t section;
+	uint8_t section_word;
+	uint8_t section_stage;
+
+	float unit[AXES];
+	float target[AXES];
+	float position[AXES];
+	float waypoint[SECTIONS][AXES];
+
+	float move_time;
+	float head_length;
+	float body_length;
+	float tail_length;
+	float entry_velocity;
+	float cruise_velocity;
+	float exit_velocity;
+
+	float segments;
+	uint32_t segment_count;
+	float segment_time;
+	float segment_velocity;
+	float segment_length;
+	float jerk;
+	float FD_1;
+	float FD_2;
+	float FD_3;
+	float FD_4;
+	float FD_5;
+
+	float prev_position_units[MOTORS];
+	float curr_position_units[MOTORS];
+	float encoder_steps[MOTORS];
+	float following_error[MOTORS];
+	float target_units[MOTORS];
+
+	GState_t gm;
+}mpRunMov_t;
+
+extern MACHINE_LOCAL mpBufPool_t mb;
+extern MACHINE_LOCAL mpMstMov_t mm;
+extern MACHINE_LOCAL mpRunMov_t mr;
+
+//planner.c
+void mp_init_buffers(void);
+uint8_t mp_get_available_buffers(void);
+mpBuf_t *mp_get_write_buffer(void);
+void mp_unget_write_buffer(void);
+mpBuf_t *mp_get_latest_queued_buffer(void);
+mpBuf_t *mp_get_run_buffer(void);
+uint8_t mp_free_run_buffer(void);
+mpBuf_t *mp_get_next_buffer(const mpBuf_t *bf);
+mpBuf_t *mp_get_prev_buffer(const mpBuf_t *bf);
+void mp_flush_planner(void);
+void mp_set_steps_to_runtime_position(void);
+float mp_get_runtime_absolute_position(uint8_t axis);
+float mp_get_runtime_work_position(uint8_t axis);
+
+//line_planner.c
+stat_t mp_plan_line(GState_t *gmod);
+uint8_t mp_get_runtime_busy(void);
+float mp_get_runtime_position(uint8_t axis);
+void mp_set_planner_position(uint8_t axis, float position);
+void mp_set_runtime_position(uint8_t axis, float position);
+static void _calc_move_time(GState_t *gmod, float length, float axis_length[]);
+static void _plan_block_list(mpBuf_t *bf);
+static float _get_junction_vmax(float a_unit[], float b_unit[]);
+
+//profile_generator.c
+float mp_get_deltav_max(float length_term, float jerk_cbrt);
+float mp_get_target_length(const float Vi, const float Vf, const mpBuf_t *bf);
+void mp_set_motion_jerk(float axis_length[], float axis_length_square[], float length_square, mpBuf_t *bf);
+void mp_motion_planning(mpBuf_t *bf);
+
+//plan_exec.c
+stat_t mp_exec_move(void);
+stat_t mp_exec_line(mpBuf_t *bf);
+
+#endif
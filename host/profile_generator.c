@@ -0,0 +1,228 @@
+/*
+ * profile_generator.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * host stand-in for the firmware's jerk limited profile generator, which this snapshot doesn't
+ * carry, following what the firmware object does. the velocity a section reaches over a length
+ * is Vi + K_dv*cbrt(L^2*J) and the length it takes is K_l*sqrt(dv^3/J). two slips of the object
+ * aren't kept: the symmetric rate limited case takes its cruise from half the block, not the
+ * whole of it, and the asymmetric cruise is bisected against the jerk the block really has
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "util.h"
+
+#define ASYMMETRIC_ITERATIONS 20		//bisection steps, the velocity is within 1e-6 of the range
+
+static float _velocity_tolerance(float Vi, float Vf){return max(2,(Vi + Vf)/200);}
+static float _section_too_short(float Vi, float Vf, float length){return (((Vi + Vf)*MIN_SEGMENT_TIME/2) > length);}
+
+//mp_get_deltav_max//
+//input : length term (cbrt of the length square), block cube root of jerk
+//output : velocity change the length allows
+//fuction : 
+//notes : 
+//additions: 
+//
+float mp_get_deltav_max(float length_term, float jerk_cbrt){
+	return (length_term*K_dv*jerk_cbrt*JERK_MULTI_CBRT);
+}
+
+//mp_get_target_length//
+//input : start and end velocities, block
+//output : length the block takes to go from one to the other
+//fuction : 
+//notes : 
+//additions: 
+//
+float mp_get_target_length(const float Vi, const float Vf, const mpBuf_t *bf){
+	float delta = fabsf(Vf - Vi);
+	return (sqrtf(delta*delta*delta)*bf->jerk_sqrt_recip*K_l);
+}
+
+//_get_asymmetric_velocity//
+//input : entry and exit velocities, block
+//output : cruise velocity whose head and tail add up to the block length
+//fuction : 
+//notes : the head and tail lengths grow with the cruise, so it's a bisection between the higher
+//of the two ends and the cruise the block asked for
+//additions: 
+//
+static float _get_asymmetric_velocity(float Vi, float Vf, mpBuf_t *bf){
+	float low = max(Vi,Vf);
+	float high = bf->cruise_velocity;
+	for(uint8_t i=0; i<ASYMMETRIC_ITERATIONS; ++i){
+		float v = (low + high)/2;
+		if((mp_get_target_length(Vi,v,bf) + mp_get_target_length(Vf,v,bf)) > bf->length){
+			high = v;
+		}else{
+			low = v;
+		}
+	}
+	return low;
+}
+
+//mp_set_motion_jerk//
+//input : axis lengths, their squares, length square, block
+//output : none
+//fuction : unit vector and jerk of the block, the jerk of the axis that limits it the most
+//notes : mm.jerk follows the block when it's more than JERK_MATCH_PRECISION off, the estimates
+//of mp_plan_line take it
+//additions: 
+//
+void mp_set_motion_jerk(float axis_length[], float axis_length_square[], float length_square, mpBuf_t *bf){
+	float jerk_term = 0;
+	for(uint8_t axis=0; axis<AXES; ++axis){
+		if(fabsf(axis_length_square[axis]) > 0){
+			bf->unit[axis] = axis_length[axis]/bf->length;
+			float term = cm.a[axis].jerk_recip*axis_length_square[axis]/length_square;
+			if(term > jerk_term){
+				bf->jerk_axis = axis;
+				jerk_term = term;
+			}
+		}
+	}
+	bf->jerk = cm.a[bf->jerk_axis].max_jerk/fabsf(bf->unit[bf->jerk_axis]);
+	bf->jerk_recip = 1/(bf->jerk*JERK_MULTI);
+	bf->jerk_sqrt = sqrtf(bf->jerk);
+	bf->jerk_sqrt_recip = 1/(bf->jerk_sqrt*JERK_MULTI_SQRT);
+	bf->jerk_cbrt = cbrtf(bf->jerk);
+	bf->jerk_cbrt_recip = 1/(bf->jerk_cbrt*JERK_MULTI_CBRT);
+	if(fabsf(bf->jerk - mm.jerk) > JERK_MATCH_PRECISION){
+		mm.jerk = bf->jerk;
+		mm.jerk_recip = bf->jerk_recip;
+		mm.jerk_cbrt = bf->jerk_cbrt;
+		mm.jerk_cbrt_recip = bf->jerk_cbrt_recip;
+	}
+}
+
+//mp_motion_planning//
+//input : block with its entry, cruise and exit velocities set
+//output : none
+//fuction : head, body and tail lengths of the block and the velocities it really reaches
+//notes : blocks shorter than a segment run as a body. a block too short for its velocity
+//change is a head or a tail only, with the far velocity lowered to what it reaches. a block
+//too short for its cruise gets the cruise its head and tail fit in. a body shorter than a
+//segment is given to the head and tail
+//additions: 
+//
+void mp_motion_planning(mpBuf_t *bf){
+	float naive_move_time = 2*bf->length/(bf->entry_velocity + bf->exit_velocity);
+	if(!isinf(naive_move_time)){
+		if(naive_move_time < MIN_SEGMENT_TIME){
+			bf->cruise_velocity = bf->length/MIN_SEGMENT_TIME;
+			bf->exit_velocity = max(0,min(bf->cruise_velocity,(bf->entry_velocity - bf->delta_vmax)));
+			bf->body_length = bf->length;
+			bf->head_length = 0;
+			bf->tail_length = 0;
+			return;
+		}
+		if(naive_move_time <= NOM_SEGMENT_TIME){
+			bf->entry_velocity = bf->pv->exit_velocity;
+			if(fp_NOT_ZERO(bf->entry_velocity)){
+				bf->cruise_velocity = bf->entry_velocity;
+				bf->exit_velocity = bf->entry_velocity;
+			}else{
+				bf->cruise_velocity = bf->delta_vmax/2;
+				bf->exit_velocity = bf->delta_vmax;
+			}
+			bf->body_length = bf->length;
+			bf->head_length = 0;
+			bf->tail_length = 0;
+			return;
+		}
+	}
+	float tolerance = _velocity_tolerance(bf->entry_velocity,bf->exit_velocity);
+	if(((bf->cruise_velocity - bf->entry_velocity) < tolerance) &&
+		 ((bf->cruise_velocity - bf->exit_velocity) < tolerance)){		//velocities all match
+		bf->body_length = bf->length;
+		bf->head_length = 0;
+		bf->tail_length = 0;
+		return;
+	}
+
+	bf->body_length = 0;
+	float minimum_length = mp_get_target_length(bf->entry_velocity,bf->exit_velocity,bf);
+	if(bf->length < (minimum_length + bf->cruise_velocity*MIN_SEGMENT_TIME)){
+		if(bf->entry_velocity > bf->exit_velocity){		//tail only
+			if(bf->length < minimum_length){
+				bf->entry_velocity = mp_get_deltav_max(bf->length_sqr_cbrt,bf->jerk_cbrt) + bf->exit_velocity;
+			}
+			bf->cruise_velocity = bf->entry_velocity;
+			bf->tail_length = bf->length;
+			bf->head_length = 0;
+			return;
+		}
+		if(bf->entry_velocity < bf->exit_velocity){		//head only
+			if(bf->length < minimum_length){
+				bf->exit_velocity = mp_get_deltav_max(bf->length_sqr_cbrt,bf->jerk_cbrt) + bf->entry_velocity;
+			}
+			bf->cruise_velocity = bf->exit_velocity;
+			bf->head_length = bf->length;
+			bf->tail_length = 0;
+			return;
+		}
+	}
+
+	bf->head_length = mp_get_target_length(bf->entry_velocity,bf->cruise_velocity,bf);
+	if(_section_too_short(bf->entry_velocity,bf->cruise_velocity,bf->head_length)){bf->head_length = 0;}
+	bf->tail_length = mp_get_target_length(bf->exit_velocity,bf->cruise_velocity,bf);
+	if(_section_too_short(bf->exit_velocity,bf->cruise_velocity,bf->tail_length)){bf->tail_length = 0;}
+
+	if((bf->head_length + bf->tail_length) > bf->length){	//rate limited, the cruise isn't reached
+		if(fabsf(bf->entry_velocity - bf->exit_velocity) < tolerance){
+			bf->head_length = bf->length/2;
+			bf->tail_length = bf->head_length;
+			bf->cruise_velocity = min(bf->cruise_vmax,bf->entry_velocity +
+																mp_get_deltav_max(cbrtf(square(bf->head_length)),bf->jerk_cbrt));
+			if(_section_too_short(bf->entry_velocity,bf->cruise_velocity,bf->head_length)){
+				bf->body_length = bf->length;
+				bf->head_length = 0;
+				bf->tail_length = 0;
+				bf->entry_velocity = (bf->entry_velocity + bf->cruise_velocity)/2;
+				bf->cruise_velocity = bf->entry_velocity;
+				bf->exit_velocity = bf->entry_velocity;
+			}
+			return;
+		}
+		bf->cruise_velocity = _get_asymmetric_velocity(bf->entry_velocity,bf->exit_velocity,bf);
+		bf->head_length = min(mp_get_target_length(bf->entry_velocity,bf->cruise_velocity,bf),bf->length);
+		bf->tail_length = bf->length - bf->head_length;
+		if(_section_too_short(bf->entry_velocity,bf->cruise_velocity,bf->head_length)){
+			bf->cruise_velocity = bf->entry_velocity;
+			bf->tail_length = bf->length;
+			bf->head_length = 0;
+		}else if(_section_too_short(bf->exit_velocity,bf->cruise_velocity,bf->tail_length)){
+			bf->cruise_velocity = bf->exit_velocity;
+			bf->head_length = bf->length;
+			bf->tail_length = 0;
+		}
+		return;
+	}
+
+	bf->body_length = bf->length - bf->head_length - bf->tail_length;
+	if((bf->body_length < bf->cruise_velocity*MIN_SEGMENT_TIME) && (fabsf(bf->body_length) > EPSILON)){
+		if(fabsf(bf->head_length) > EPSILON){
+			if(fabsf(bf->tail_length) > EPSILON){
+				bf->head_length += bf->body_length/2;
+				bf->tail_length += bf->body_length/2;
+			}else{
+				bf->head_length += bf->body_length;
+			}
+		}else{
+			bf->tail_length += bf->body_length;
+		}
+		bf->body_length = 0;
+	}else if((fabsf(bf->head_length) < EPSILON) && (fabsf(bf->tail_length) < EPSILON)){
+		bf->cruise_velocity = bf->entry_velocity;
+	}
+}
@@ -0,0 +1,90 @@
+// spsc.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	bounded single producer single consumer ring for the host pipeline stages.
+	the same discipline as the firmware rings, the producer only writes head and the
+	consumer only writes tail, so one acquire/release pair per element is all the
+	ordering that is needed and no lock is taken. head and tail live on separate
+	cache lines so the two threads do not fight over one line.
+*/
+
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define SPSC_CACHE_LINE 64
+
+typedef struct spsc{
+	_Atomic uint32_t head;						//written by the producer
+	uint8_t pad0[SPSC_CACHE_LINE-sizeof(uint32_t)];
+	_Atomic uint32_t tail;						//written by the consumer
+	uint8_t pad1[SPSC_CACHE_LINE-sizeof(uint32_t)];
+	uint32_t mask;										//elements-1, elements is a power of 2
+	uint32_t size;										//bytes per element
+	uint8_t *buf;
+}spsc_t;
+
+//spsc_init//
+//input : queue, number of elements (power of 2), element size in bytes
+//output : false if the storage could not be allocated
+//fuction : 
+//notes : 
+//additions: 
+//
+static inline uint8_t spsc_init(spsc_t *q, uint32_t elements, uint32_t size){
+	atomic_init(&q->head,0);
+	atomic_init(&q->tail,0);
+	q->mask = elements-1;
+	q->size = size;
+	q->buf = malloc((size_t)elements*size);
+	return (q->buf != NULL);
+}
+
+static inline void spsc_free(spsc_t *q){
+	free(q->buf);
+	q->buf = NULL;
+}
+
+//spsc_push//
+//input : queue, element to copy in
+//output : false if the queue is full
+//fuction : producer side
+//notes : 
+//additions: 
+//
+static inline uint8_t spsc_push(spsc_t *q, const void *elem){
+	uint32_t head = atomic_load_explicit(&q->head,memory_order_relaxed);
+	if(head - atomic_load_explicit(&q->tail,memory_order_acquire) > q->mask){
+		return false;
+	}
+	memcpy(&q->buf[(size_t)(head & q->mask)*q->size],elem,q->size);
+	atomic_store_explicit(&q->head,head+1,memory_order_release);
+	return true;
+}
+
+//spsc_pop//
+//input : queue, storage for the element
+//output : false if the queue is empty
+//fuction : consumer side
+//notes : 
+//additions: 
+//
+static inline uint8_t spsc_pop(spsc_t *q, void *elem){
+	uint32_t tail = atomic_load_explicit(&q->tail,memory_order_relaxed);
+	if(tail == atomic_load_explicit(&q->head,memory_order_acquire)){
+		return false;
+	}
+	memcpy(elem,&q->buf[(size_t)(tail & q->mask)*q->size],q->size);
+	atomic_store_explicit(&q->tail,tail+1,memory_order_release);
+	return true;
+}
+
+#endif
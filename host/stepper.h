@@ -0,0 +1,40 @@
+// stepper.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	host stand-in for the firmware's stepper.h, which this snapshot doesn't carry. the motor
+	configuration config.c fills in, the ports and timers of the DDA aren't on the host
+*/
+
+#ifndef STEPPER_H
+#define STEPPER_H
+
+#include "system.h"
+#include "config.h"
+
+typedef struct stepper_configuration{
+	float step_angle;
+	float unit_per_step;
+	float step_per_unit;
+	float travel_per_rev;
+	uint32_t dir_bit;
+	uint32_t enable_bit;
+	uint32_t step_bit;
+	uint8_t polarity;
+	uint8_t motor_map;							//axis the motor drives
+}stCfgMot_t;
+
+typedef struct mechanism_configuration{
+	stCfgMot_t mot[MOTORS];
+}stpCfg_t;
+
+extern MACHINE_LOCAL stpCfg_t st_cfg;
+
+void st_init(void);
+uint8_t st_runtime_isbusy(void);
+stat_t st_prep_line(float segment_time, float travel_steps[], float following_error[]);
+void st_load_move(void);
+
+#endif
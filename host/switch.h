@@ -0,0 +1,56 @@
+// switch.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	host stand-in for the firmware's switch.h, which this snapshot doesn't carry. the switch
+	modes and states the homing and probing cycles read, host_stubs.c keeps every switch open
+*/
+
+#ifndef SWITCH_H
+#define SWITCH_H
+
+#include <stdint.h>
+
+#define HOMING_BIT 0x1UL
+#define LIMIT_BIT 0x2UL
+
+enum swMode{
+	SW_MODE_DISABLED = 0,
+	SW_MODE_HOMING,
+	SW_MODE_LIMIT,
+	SW_MODE_HOMING_LIMIT,
+	SW_MODE_PROBE
+};
+
+enum swType{
+	SW_TYPE_NORMALLY_OPEN = 0,
+	SW_TYPE_NORMALLY_CLOSED
+};
+
+enum swState{
+	SW_DISABLED = -1,
+	SW_OPEN = 0,
+	SW_CLOSED = 1
+};
+
+enum swPosition{
+	SW_MIN = 0,
+	SW_MAX,
+	SW_POSITIONS
+};
+
+enum swEdge{
+	SW_NO_EDGE = 0,
+	SW_LEADING,
+	SW_TRAILING
+};
+
+void sw_init(void);
+int8_t get_switch_state(int8_t axis, int8_t position);
+uint8_t get_switch_mode(int8_t axis, int8_t position);
+int8_t get_probe_state(void);
+uint8_t get_limit_switchs_thrown(void);
+
+#endif
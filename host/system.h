@@ -0,0 +1,96 @@
+// system.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	host stand-in for the firmware's system.h, which this snapshot doesn't carry. only what the
+	portable layers the host tools build take from it: the machine size, the gcode defaults and
+	the status codes the rest of the tree continues (canonical.h gcodeStatus). the values are
+	the ones the firmware was built with, read back from its objects. with the full tree the
+	root system.h comes first on the include path and this one isn't used
+*/
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <stdint.h>
+
+#define FCPU 80000000UL
+#define MM_PER_INCH 25.4f
+#define MINIMUM_PROBE_DISTANCE 0.254f		//mm
+#define NUL (char)0
+
+#define AXES 3
+#define HOMING_AXES 3
+#define MOTORS 3
+#define COORDS 6								//G54-G59
+
+#define GCODE_DEFAULT_UNITS MILLIMETERS
+#define GCODE_DEFAULT_PLANE XY_PLANE
+#define GCODE_DEFAULT_COORD_SYSTEM G54
+#define GCODE_DEFAULT_PATH_CONTROL PATH_EXACT_PATH
+#define GCODE_DEFAULT_DISTANCE_MODE ABSOLUTE_MODE
+
+#define ret_stat(a) if((status_code=a) != STAT_OK) { return(status_code);}
+
+typedef uint8_t stat_t;
+
+enum Axis{
+	X_AXIS = 0,
+	Y_AXIS,
+	Z_AXIS,
+	A_AXIS,
+	B_AXIS,
+	C_AXIS
+};
+
+enum Motor{
+	MOTOR_1 = 0,
+	MOTOR_2,
+	MOTOR_3,
+	MOTOR_4,
+	MOTOR_5,
+	MOTOR_6,
+	MOTOR_7,
+	MOTOR_8,
+	MOTOR_9,
+	MOTOR_10
+};
+
+enum States{
+	STAT_OK = 0,
+	STAT_ERR,
+	STAT_RC,												//run again, the callback isn't done
+	STAT_NOOP,											//nothing to do
+	STAT_MACHINE_ALARMED,
+	STAT_COMPLETE,
+	STAT_INVALID_CODE_FORM,
+	STAT_INVALID_NUMBER_FORM,
+	STAT_UNSUPPORTED_GCODE,
+	STAT_GCODE_FEEDRATE_NOT_SPECIFIED,
+	STAT_UNSUPPORTED_MCODE,
+	STAT_INPUT_VALUE_OUT_OF_RANGE,
+	STAT_MIN_RADIUS_ARC,
+	STAT_ARC_SPEC_ERROR,
+	STAT_ARC_AXIS_MISSING_FOR_SELECTED_PLANE,
+	STAT_ARC_RADIUS_MODE_END_IS_START,
+	STAT_ARC_SPECIFICATION_ERROR,
+	STAT_MINIMUM_LENGTH_MOVE,
+	STAT_MINIMUM_TIME_MOVE,
+	STAT_ZERO_VELOCITY_MOVE,
+	STAT_LIMIT_SWITCH_HIT,
+	STAT_BUFFER_FULL,
+	STAT_HOMING_CYCLE_FAILED,
+	STAT_HOMING_BAD_OR_NO_AXIS_WORDS,
+	STAT_HOMING_ZERO_SEARCH_VELOCITY,
+	STAT_HOMING_ZERO_LATCH_VELOCITY,
+	STAT_HOMING_ERROR_NEGATIVE_LATCH_BACKOFF,
+	STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL,
+	STAT_HOMING_SWITCH_MISCONFIGURATION,
+	STAT_PROBE_INVERSE_TIME_FEEDRATE,
+	STAT_PROBE_ALL_AXES_OMITTED,
+	STAT_MINIMUM_PROBE_DISTANCE
+};
+
+#endif
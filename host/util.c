@@ -0,0 +1,43 @@
+/*
+ * util.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * host stand-in for the firmware's util.c, which this snapshot doesn't carry
+ */
+
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+#include "system.h"
+#include "util.h"
+
+//fp_Equal//
+//input : two floats
+//output : true when they're equal within the float precision of the larger
+//fuction : 
+//notes : 
+//additions: 
+//
+uint8_t fp_Equal(float a, float b){
+	return (fabsf(a - b) <= (max(fabsf(a),fabsf(b))*FLT_EPSILON));
+}
+
+//get_vector_length//
+//input : two positions
+//output : distance between them
+//fuction : 
+//notes : 
+//additions: 
+//
+float get_vector_length(const float a[], const float b[]){
+	float length = 0;
+	for(uint8_t axis=0; axis<AXES; ++axis){
+		length += square(a[axis] - b[axis]);
+	}
+	return sqrtf(length);
+}
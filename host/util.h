@@ -0,0 +1,47 @@
+// util.h
+// Runs on the host
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	host stand-in for the firmware's util.h, which this snapshot doesn't carry. the macros and
+	helpers are the ones the firmware was built with, read back from its objects, with fabsf for
+	the armcc _fabsf intrinsic and square() parenthesized so square(a+b) squares the sum
+*/
+
+#ifndef UTIL_H
+#define UTIL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef INLINE
+#define INLINE extern inline
+#endif
+
+#define copy_vector(d,s) (memcpy(d,s,sizeof(d)))
+#define clear_vector(a) (memset(a,0,sizeof(a)))
+
+#define EPSILON 0.00001f
+#define fp_NOT_ZERO(a) (fabsf(a) > EPSILON)
+#define fp_ZERO(a) (fabsf(a) < EPSILON)
+#define fp_TRUE(a) (a > EPSILON)
+#define fp_FALSE(a) (a < EPSILON)
+
+#define square(b) ((b)*(b))
+#ifndef M_PI
+#define M_PI 3.141592654f
+#endif
+
+INLINE float max(float a, float b){return (a > b)? a : b;}
+INLINE float min(float a, float b){return (a < b)? a : b;}
+INLINE float max3(float a, float b, float c){return max(max(a,b),c);}
+INLINE float min3(float a, float b, float c){return min(min(a,b),c);}
+INLINE float min4(float a, float b, float c, float d){return min(min(a,b),min(c,d));}
+INLINE float cube_sqrt(float x){return sqrtf(x*x*x);}			//x^1.5
+
+uint8_t fp_Equal(float a, float b);
+float get_vector_length(const float a[], const float b[]);
+
+#endif
@@ -0,0 +1,139 @@
+/*
+ * kinematics.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * pluggable kinematics, see kinematics.h
+ *
+ * the terms are built from the motor configuration (step_per_unit and motor_map in st_cfg)
+ * so kn_init must run after config_motors_init and again whenever the motors change.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "system.h"
+#include "stepper.h"
+#include "kinematics.h"
+
+MACHINE_LOCAL kinematics_t kn;
+
+static void _kn_transform(float target[], float steps[]);
+
+//kn_init//
+//input : kinematics model
+//output : none
+//fuction : precomputes the inverse and forward terms of the model
+//notes : a motor without step_per_unit gets no terms and always reads 0 steps
+//additions:
+//
+void kn_init(uint8_t model){
+	float (*z_correction)(float x, float y) = kn.z_correction;
+	memset(&kn,0,sizeof(kn));
+	memset(kn.forward_motor,-1,sizeof(kn.forward_motor));
+	kn.model = model;
+	kn.z_correction = z_correction;					// leveling survives a model change
+
+	int8_t x_motor = -1, y_motor = -1;
+	for(uint8_t motor=0; motor<MOTORS; ++motor){
+		float spu = st_cfg.mot[motor].step_per_unit;
+		uint8_t axis = st_cfg.mot[motor].motor_map;
+		if(spu <= 0) continue;
+		if((model == KINEMATICS_GANTRY) && (motor == KN_GANTRY_MOTOR)){
+			axis = KN_GANTRY_AXIS;
+		}
+		kn.inverse[motor].axis[0] = kn.inverse[motor].axis[1] = axis;
+		kn.inverse[motor].coef[0] = spu;
+		if(kn.forward_motor[axis][0] < 0){				// the first motor of an axis reads it back
+			kn.forward_motor[axis][0] = kn.forward_motor[axis][1] = motor;
+			kn.forward_coef[axis][0] = 1/spu;
+		}
+		if((axis == X_AXIS) && (x_motor < 0)) x_motor = motor;
+		if((axis == Y_AXIS) && (y_motor < 0)) y_motor = motor;
+	}
+
+	if((model == KINEMATICS_COREXY) && (x_motor >= 0) && (y_motor >= 0)){
+		float a = st_cfg.mot[x_motor].step_per_unit;
+		float b = st_cfg.mot[y_motor].step_per_unit;
+		kn.inverse[x_motor].axis[0] = X_AXIS;		// A = X+Y
+		kn.inverse[x_motor].axis[1] = Y_AXIS;
+		kn.inverse[x_motor].coef[0] = a;
+		kn.inverse[x_motor].coef[1] = a;
+		kn.inverse[y_motor].axis[0] = X_AXIS;		// B = X-Y
+		kn.inverse[y_motor].axis[1] = Y_AXIS;
+		kn.inverse[y_motor].coef[0] = b;
+		kn.inverse[y_motor].coef[1] = -b;
+		kn.forward_motor[X_AXIS][0] = kn.forward_motor[Y_AXIS][0] = x_motor;
+		kn.forward_motor[X_AXIS][1] = kn.forward_motor[Y_AXIS][1] = y_motor;
+		kn.forward_coef[X_AXIS][0] = 0.5f/a;			// X = (A+B)/2
+		kn.forward_coef[X_AXIS][1] = 0.5f/b;
+		kn.forward_coef[Y_AXIS][0] = 0.5f/a;			// Y = (A-B)/2
+		kn.forward_coef[Y_AXIS][1] = -0.5f/b;
+	}
+}
+
+void kn_set_z_correction(float (*correction)(float x, float y)){kn.z_correction = correction;}
+
+//_kn_transform//
+//input : segment target in machine coordinates, steps
+//output : none
+//fuction : motor steps of a target
+//notes : 
+//additions:
+//
+static void _kn_transform(float target[], float steps[]){
+	float z = target[Z_AXIS];
+	if(kn.z_correction != NULL){
+		target[Z_AXIS] += kn.z_correction(target[X_AXIS],target[Y_AXIS]);
+	}
+	for(uint8_t motor=0; motor<MOTORS; ++motor){
+		knTerm_t *t = &kn.inverse[motor];
+		steps[motor] = t->coef[0]*target[t->axis[0]] + t->coef[1]*target[t->axis[1]];
+	}
+	target[Z_AXIS] = z;
+}
+
+//kn_inverse_kinematics//
+//input : segment target in machine coordinates, steps
+//output : none
+//fuction : ld.get_target_units binding
+//notes : EXEC INTERRUPT
+//additions:
+//
+void kn_inverse_kinematics(float target[], float steps[]){
+	_kn_transform(target,steps);
+}
+
+//kn_inverse_kinematics_batch//
+//input : segment targets, their steps, number of segments
+//output : none
+//fuction : transforms the segments a prep stage computed ahead in one call
+//notes : 
+//additions:
+//
+void kn_inverse_kinematics_batch(float target[][AXES], float steps[][MOTORS], uint8_t count){
+	for(uint8_t i=0; i<count; ++i){
+		_kn_transform(target[i],steps[i]);
+	}
+}
+
+//kn_forward_kinematics//
+//input : motor steps, position of the axes
+//output : none
+//fuction : position of the axes that have motors, the others are left alone
+//notes : used to read back latched step counts (probe), the leveling correction is taken out of Z
+//additions:
+//
+void kn_forward_kinematics(int32_t steps[], float position[]){
+	for(uint8_t axis=X_AXIS; axis<AXES; ++axis){
+		if(kn.forward_motor[axis][0] < 0) continue;
+		position[axis] = kn.forward_coef[axis][0]*(float)steps[kn.forward_motor[axis][0]] +
+										 kn.forward_coef[axis][1]*(float)steps[kn.forward_motor[axis][1]];
+	}
+	if((kn.z_correction != NULL) && (kn.forward_motor[Z_AXIS][0] >= 0)){
+		position[Z_AXIS] -= kn.z_correction(position[X_AXIS],position[Y_AXIS]);
+	}
+}
@@ -0,0 +1,52 @@
+// kinematics.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	kinematics stage between the runtime segments and the steppers, bound to ld.get_target_units.
+	every model is linear so each motor is precomputed at kn_init as at most two terms of axis
+	position times steps per unit, a segment costs the same 2 multiply-adds per motor for CoreXY
+	as for Cartesian. the model is chosen at build time with KINEMATICS_MODEL, kn_init can
+	switch it at run time.
+	  - cartesian, every motor follows its mapped axis
+	  - gantry, cartesian with a second motor (MOTOR_4) following the gantry axis
+	  - corexy, the motors mapped to X and Y become A = X+Y and B = X-Y
+*/
+
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include "config.h"
+
+#define KINEMATICS_CARTESIAN 0		//not an enum, config.c tests KINEMATICS_MODEL in #if
+#define KINEMATICS_GANTRY 1
+#define KINEMATICS_COREXY 2
+
+#define KINEMATICS_MODEL KINEMATICS_CARTESIAN
+#define KN_GANTRY_AXIS Y_AXIS
+#define KN_GANTRY_MOTOR MOTOR_4
+#define KN_BATCH_MAX 8						//segments per kn_inverse_kinematics_batch call
+
+typedef struct knTerm{
+	uint8_t axis[2];
+	float coef[2];							//steps per unit of each axis
+}knTerm_t;
+
+typedef struct kinematics{
+	uint8_t model;
+	knTerm_t inverse[MOTORS];		//motor steps from axes
+	int8_t forward_motor[AXES][2];	//axis from motor steps, -1 when the axis has no motor
+	float forward_coef[AXES][2];
+	float (*z_correction)(float x, float y);	//leveling, NULL when off
+}kinematics_t;
+
+extern MACHINE_LOCAL kinematics_t kn;
+
+void kn_init(uint8_t model);
+void kn_set_z_correction(float (*correction)(float x, float y));
+void kn_inverse_kinematics(float target[], float steps[]);
+void kn_inverse_kinematics_batch(float target[][AXES], float steps[][MOTORS], uint8_t count);
+void kn_forward_kinematics(int32_t steps[], float position[]);
+
+#endif
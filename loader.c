@@ -1,59 +1,152 @@
-
-#include <stdint.h>
-#include <stdbool.h>
-#include "system.h"
-#include "planner.h"
-#include "loader.h"
-#include "stepper.h"
-#include "timers.h"
-
-
-load_t ld;
-
-
-
-void ld_init(void){
-
-#if defined(__STEPPER)
-	ld.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;
-	ld.move_type = MOVE_TYPE_NULL;
-	ld.actuator_runtime_isbusy = st_runtime_isbusy;
-	ld.get_target_units = st_inverse_kinematics;
-	ld.prep_line = st_prep_line;
-	ld.load_move = st_load_move;
-#endif
-
-}
-
-void ld_request_exe(void){
-	if(ld.buffer_state == PREP_BUFFER_OWNED_BY_EXEC){
-		//execute_timer_enable();
-		TIMER5_CTL_R |= TIMER_CTL_TAEN;
-	}
-}
-
-void TIMER5A_Handler(void){			//LOWEST_PRIORITY interrupt
-	execute_timer_acknowledge();
-	if(ld.buffer_state == PREP_BUFFER_OWNED_BY_EXEC){
-		if((mp_exec_move())!=STAT_NOOP){
-			//you have something to execute
-			ld.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;
-			ld_request_load();
-		} 
-	}
-}
-
-
-void ld_request_load(void){
-	if(ld.actuator_runtime_isbusy()){
-		return;
-	}
-	if(ld.buffer_state == PREP_BUFFER_OWNED_BY_LOADER){
-		load_timer_enable();
-	}
-}
-
-void TIMER5B_Handler(void){		//LOW_PRIORITY interrupt
-	load_timer_acknowledge();
-	ld.load_move();
-}
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "system.h"
+#include "planner.h"
+#include "plan_command.h"
+#include "loader.h"
+#include "stepper.h"
+#include "encoder.h"
+#include "kinematics.h"
+#include "timers.h"
+#include "trace.h"
+#include "recorder.h"
+#include "events.h"
+
+
+MACHINE_LOCAL load_t ld;
+
+static void _load_command(void);
+static void _load_dwell(void);
+static void _end_command(void);
+
+
+void ld_init(void){
+	ld.dwell_ticks = 0;
+
+#if defined(__STEPPER)
+	ld.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;
+	ld.move_type = MOVE_TYPE_NULL;
+	ld.actuator_runtime_isbusy = st_runtime_isbusy;
+	ld.get_target_units = kn_inverse_kinematics;
+	ld.prep_line = st_prep_line;
+	ld.load_move = st_load_move;
+#endif
+
+}
+
+void ld_request_exe(void){
+	if(ld.buffer_state == PREP_BUFFER_OWNED_BY_EXEC){
+		//execute_timer_enable();
+		TIMER5_CTL_R |= TIMER_CTL_TAEN;
+	}
+}
+
+void TIMER5A_Handler(void){			//LOWEST_PRIORITY interrupt
+	execute_timer_acknowledge();
+	if(ld.buffer_state == PREP_BUFFER_OWNED_BY_EXEC){
+		mpBuf_t *bf = mp_get_run_buffer();
+		PT_RECORD(bf);		//the plan of a buffer is final when the runtime takes it
+		uint8_t command = (bf != NULL) && MP_IS_COMMAND(bf);	//read before mp_exec_move frees it
+		if((mp_exec_move())!=STAT_NOOP){
+			//you have something to execute
+			if(command == false){fr_record();}	//a command or dwell prepares no segment, mr is the last one
+			ld.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;
+			ld_request_load();
+		} 
+	}
+	ev_post(EV_PLANNER);							//a buffer may have been freed
+}
+
+
+void ld_request_load(void){
+	if(ld.actuator_runtime_isbusy()){
+		return;
+	}
+	if(ld.buffer_state == PREP_BUFFER_OWNED_BY_LOADER){
+		load_timer_enable();
+	}
+}
+
+void TIMER5B_Handler(void){		//LOW_PRIORITY interrupt
+	load_timer_acknowledge();
+	switch(ld.move_type){
+		case MOVE_TYPE_COMMAND: _load_command(); break;
+		case MOVE_TYPE_DWELL: _load_dwell(); break;
+		default:
+			ld.load_move();
+			EN_CHECK_FOLLOWING_ERROR();		//segment boundary, compare the feedback motor with its encoder
+	}
+	ev_post(EV_PLANNER);							//the runtime may have gone idle
+}
+
+//ld_prep_command//
+//input : none
+//output : none
+//fuction : stages the command block of the run buffer for the loader
+//notes : called by the command exec, the loader runs it when the actuator is done with the move before
+//additions:
+//
+void ld_prep_command(void){
+	ld.move_type = MOVE_TYPE_COMMAND;
+}
+
+//ld_prep_dwell//
+//input : dwell time in seconds
+//output : none
+//fuction : stages the dwell block of the run buffer for the loader
+//notes :
+//additions:
+//
+void ld_prep_dwell(float seconds){
+	ld.move_type = MOVE_TYPE_DWELL;
+	ld.dwell_time = seconds;
+}
+
+//ld_dwell_tick//
+//input : none
+//output : true while the dwell needs the tick
+//fuction : counts the loaded dwell down, ends it on the last tick
+//notes : called from the 1ms tick, the dwell is 1ms short at most
+//additions:
+//
+uint8_t ld_dwell_tick(void){
+	if(ld.dwell_ticks == 0) return false;
+	if(--ld.dwell_ticks == 0){
+		_end_command();
+		return false;
+	}
+	return true;
+}
+
+static void _load_command(void){
+	mpBuf_t *bf = mp_get_run_buffer();
+	bf->cm_fun(bf->gm.target,bf->gm.work_offset);		//values and flags, see plan_command.h
+	_end_command();
+}
+
+static void _load_dwell(void){
+	uint32_t ticks = (uint32_t)(ld.dwell_time*1000 + 0.5f);
+	if(ticks == 0){
+		_end_command();
+		return;
+	}
+	ld.dwell_ticks = ticks;
+	ev_tick_wake();							//the tick counts it down
+}
+
+//_end_command//
+//input : none
+//output : none
+//fuction : frees the command block and hands the staging back to the exec
+//notes : 
+//additions:
+//
+static void _end_command(void){
+	ld.move_type = MOVE_TYPE_NULL;
+	mp_free_run_buffer();
+	ld.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;
+	ld_request_exe();
+	ev_post(EV_PLANNER);
+}
@@ -0,0 +1,115 @@
+/*
+ * plan_command.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * synchronous command blocks of the planner queue, see plan_command.h
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "plan_command.h"
+#include "loader.h"
+#include "util.h"
+
+static stat_t _exec_command(mpBuf_t *bf);
+static stat_t _exec_dwell(mpBuf_t *bf);
+
+//mp_queue_command//
+//input : runtime callback, values and flags passed to it
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : queues a command block, the callback runs when the runtime reaches it
+//notes : the callback runs in the load interrupt. the block copies the direction and the exit
+//limit of the block before it, mp_plan_line narrows the limit to the junction that comes after
+//additions:
+//
+stat_t mp_queue_command(void(*cm_exec)(float*, float*), float *value, float *flag){
+	mpBuf_t *bf;
+	if((bf = mp_get_write_buffer()) == NULL){
+		return STAT_BUFFER_FULL;				//the planner sync keeps buffers free for the block
+	}
+	bf->move_type = MOVE_TYPE_COMMAND;
+	bf->bf_fun = _exec_command;
+	bf->cm_fun = cm_exec;
+	memcpy(&bf->gm,&cm.gm,sizeof(GState_t));
+	copy_vector(bf->gm.target,value);
+	copy_vector(bf->gm.work_offset,flag);
+	bf->gm.move_time = 0;
+	bf->length = 0;
+	copy_vector(bf->unit,bf->pv->unit);
+	bf->cruise_vmax = bf->pv->exit_vmax;
+	bf->entry_vmax = bf->cruise_vmax;
+	bf->exit_vmax = bf->cruise_vmax;
+	bf->delta_vmax = 0;								//no velocity change inside, the exit is the entry
+	bf->braking_velocity = 0;					//last block of the queue for now
+	bf->entry_velocity = bf->pv->exit_velocity;
+	bf->cruise_velocity = bf->entry_velocity;
+	bf->exit_velocity = 0;
+	bf->replanned = true;
+	return STAT_OK;
+}
+
+//mp_queue_dwell//
+//input : dwell time in seconds
+//output : STAT_OK, STAT_BUFFER_FULL
+//fuction : queues a zero motion block that holds the queue for the dwell time
+//notes : the velocities are all 0 and it's never replanned, so the planner stops at it
+//additions:
+//
+stat_t mp_queue_dwell(float seconds){
+	mpBuf_t *bf;
+	if((bf = mp_get_write_buffer()) == NULL){
+		return STAT_BUFFER_FULL;
+	}
+	bf->move_type = MOVE_TYPE_DWELL;
+	bf->bf_fun = _exec_dwell;
+	bf->cm_fun = NULL;
+	memcpy(&bf->gm,&cm.gm,sizeof(GState_t));
+	bf->gm.move_time = seconds/60;			//minutes, like the moves
+	bf->length = 0;
+	memset(bf->unit,0,sizeof(bf->unit));
+	bf->cruise_vmax = 0;
+	bf->entry_vmax = 0;
+	bf->exit_vmax = 0;
+	bf->delta_vmax = 0;
+	bf->braking_velocity = 0;
+	bf->entry_velocity = 0;
+	bf->cruise_velocity = 0;
+	bf->exit_velocity = 0;
+	bf->replanned = false;
+	return STAT_OK;
+}
+
+//mp_pass_through_commands//
+//input : move being planned, its entry_vmax set
+//output : none
+//fuction : limits the command blocks right before the move to its entry limit
+//notes : the block before the commands then exits at a velocity the move can enter at
+//additions:
+//
+void mp_pass_through_commands(mpBuf_t *bf){
+	mpBuf_t *bp = bf;
+	while(((bp = mp_get_prev_buffer(bp)) != bf) && (bp->move_type == MOVE_TYPE_COMMAND) && (bp->replanned == true)){
+		bp->cruise_vmax = min(bp->cruise_vmax,bf->entry_vmax);
+		bp->entry_vmax = bp->cruise_vmax;
+		bp->exit_vmax = bp->cruise_vmax;
+	}
+}
+
+static stat_t _exec_command(mpBuf_t *bf){
+	ld_prep_command();
+	return STAT_OK;
+}
+
+static stat_t _exec_dwell(mpBuf_t *bf){
+	ld_prep_dwell(bf->gm.move_time*60);
+	return STAT_OK;
+}
@@ -0,0 +1,33 @@
+// plan_command.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	synchronous commands in the planner queue, see the canonical machine notes. a command is a
+	zero length block with its own bf_fun, the runtime reaches it in order with the moves and the
+	loader runs it at the segment boundary, once the move before it is out of the actuator.
+	  - MOVE_TYPE_COMMAND, M3-M5, M6, M7-M9. the block is planned through, it takes the
+	    direction and exit limit of the block before it and the junction limit of the block after
+	    it, so the velocity passes it unchanged and lookahead goes on past a spindle or coolant change
+	  - MOVE_TYPE_DWELL, G4. a stop, the block before it ends at 0 and the loader holds the queue
+	    for the dwell time on the 1ms tick
+	the callback values and flags are kept in gm.target and gm.work_offset of the block, it has
+	no motion to need them.
+	mp_drop_queued_lines takes queued lines back off the end of the queue for a jog that changes
+	its vector, the kept ones are replanned to stop at their end.
+*/
+
+#ifndef PLAN_COMMAND_H
+#define PLAN_COMMAND_H
+
+#include "config.h"
+
+#define MP_IS_COMMAND(bf) (((bf)->move_type == MOVE_TYPE_COMMAND) || ((bf)->move_type == MOVE_TYPE_DWELL))
+
+stat_t mp_queue_command(void(*cm_exec)(float*, float*), float *value, float *flag);
+stat_t mp_queue_dwell(float seconds);
+void mp_pass_through_commands(mpBuf_t *bf);
+uint8_t mp_drop_queued_lines(uint8_t keep);
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * profile.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * velocity profile backends, see profile.h
+ *
+ * the jerk backend is bound to the profile_generator functions as they are. the trapezoid
+ * backend solves the same block in v^2:
+ *
+ *	  head = (Vc^2 - Ve^2)/2a			tail = (Vc^2 - Vx^2)/2a			body = L - head - tail
+ *
+ *	and when head and tail don't fit in L the cruise drops to Vc^2 = (2aL + Ve^2 + Vx^2)/2.
+ *	the backward pass accumulates the braking velocity the same way, Vb^2 = Vx^2 + 2aL, a
+ *	linear sum would let a chain of blocks enter faster than it can stop.
+ *	the runtime shapes every section the same way whatever planned it, it only takes the
+ *	section lengths and end velocities, so a is the average acceleration of a section.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "profile.h"
+#include "fastmath.h"
+#include "util.h"
+
+MACHINE_LOCAL profileSelect_t pf;
+
+//jerk backend//
+static float _jerk_length_term(float length, float length_square){return fast_cbrtf(length_square);}
+static float _jerk_estimate_deltav(float length_term){return mp_get_deltav_max(length_term,mm.jerk_cbrt);}
+static float _jerk_deltav_max(mpBuf_t *bf){return mp_get_deltav_max(bf->length_sqr_cbrt,bf->jerk_cbrt);}
+static float _jerk_braking(float exit_velocity, mpBuf_t *bf){return exit_velocity + bf->delta_vmax;}
+
+static const mpProfile_t jerk_profile = {
+	_jerk_length_term,
+	_jerk_estimate_deltav,
+	mp_set_motion_jerk,
+	_jerk_deltav_max,
+	_jerk_braking,
+	mp_motion_planning
+};
+
+//trapezoid backend//
+static float _trap_length_term(float length, float length_square){return 2*length;}
+static float _trap_estimate_deltav(float length_term){return _sqrtf(length_term*pf.min_accel);}
+static float _trap_deltav_max(mpBuf_t *bf){return _sqrtf(bf->length_sqr_cbrt*bf->jerk_cbrt);}
+static float _trap_braking(float exit_velocity, mpBuf_t *bf){return _sqrtf(square(exit_velocity) + square(bf->delta_vmax));}	//Vx^2 + 2aL
+
+//_trap_set_block//
+//input : axis lengths, their squares, length square, block
+//output : none
+//fuction : unit vector and acceleration of the block
+//notes : the acceleration is the highest that keeps every moving axis in its own limit
+//additions:
+//
+static void _trap_set_block(float axis_length[], float axis_length_square[], float length_square, mpBuf_t *bf){
+	float length_recip = fast_rsqrtf(length_square);
+	float accel = 0;
+	FOR_AXES(axis,
+		bf->unit[axis] = axis_length[axis]*length_recip;
+		if(!fp_ZERO(bf->unit[axis])){
+			float axis_accel = cm.a[axis].max_accel/fabsf(bf->unit[axis]);
+			accel = ((accel == 0) || (axis_accel < accel))? axis_accel : accel;
+		}
+	)
+	bf->jerk_cbrt = accel;
+}
+
+//_trap_motion_planning//
+//input : block with its entry, cruise and exit velocities set
+//output : none
+//fuction : head, body and tail of a constant acceleration profile
+//notes : an exit the block can't reach is lowered to what it reaches, the planner's braking
+//velocities keep the entry within what the block can stop from. an entry it can't stop from
+//anyway (rounding) brakes over the whole block, the sections always add up to its length
+//additions:
+//
+static void _trap_motion_planning(mpBuf_t *bf){
+	float accel_2 = 2*bf->jerk_cbrt;
+	float entry_square = square(bf->entry_velocity);
+	float exit_square = square(bf->exit_velocity);
+	float cruise_square = square(bf->cruise_velocity);
+	float reach = accel_2*bf->length;
+
+	if(exit_square > entry_square + reach){				//accelerates all the way
+		exit_square = entry_square + reach;
+		bf->exit_velocity = _sqrtf(exit_square);
+		cruise_square = exit_square;
+	}else if(entry_square > exit_square + reach){	//decelerates all the way
+		cruise_square = entry_square;
+	}else if((2*cruise_square - entry_square - exit_square) > reach){	//no room for a body
+		cruise_square = (reach + entry_square + exit_square)/2;
+	}
+	bf->cruise_velocity = _sqrtf(cruise_square);
+	bf->head_length = max((cruise_square - entry_square)/accel_2,0);
+	bf->tail_length = min(max((cruise_square - exit_square)/accel_2,0),bf->length);
+	bf->body_length = max(bf->length - bf->head_length - bf->tail_length,0);
+}
+
+static const mpProfile_t trapezoid_profile = {
+	_trap_length_term,
+	_trap_estimate_deltav,
+	_trap_set_block,
+	_trap_deltav_max,
+	_trap_braking,
+	_trap_motion_planning
+};
+
+static const mpProfile_t *const profiles[PROFILE_BACKENDS] = {
+	&jerk_profile,
+	&trapezoid_profile
+};
+
+//mp_profile_init//
+//input : none
+//output : none
+//fuction : every path control mode on PROFILE_DEFAULT
+//notes : must be invoked after config_init, the trapezoid estimate takes the axis accelerations
+//additions:
+//
+void mp_profile_init(void){
+	pf.min_accel = cm.a[X_AXIS].max_accel;
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+		pf.min_accel = min(pf.min_accel,cm.a[axis].max_accel);
+	}
+	mp_select_job_profile(PROFILE_DEFAULT);
+}
+
+//mp_select_profile//
+//input : path control mode (G61, G61.1, G64), backend
+//output : none
+//fuction : backend of the blocks planned in that mode from now on
+//notes : between jobs, with the planner empty. a queued block looks its backend up again every
+//time it's replanned and must find the backend that set its length and limit terms.
+//blocks of different backends can share the list, they exchange only velocities
+//additions:
+//
+void mp_select_profile(uint8_t path_control, uint8_t backend){
+	if((path_control >= PROFILE_PATH_CONTROLS) || (backend >= PROFILE_BACKENDS)) return;
+	pf.path[path_control] = profiles[backend];
+}
+
+void mp_select_job_profile(uint8_t backend){
+	for(uint8_t path_control = 0; path_control<PROFILE_PATH_CONTROLS; ++path_control){
+		mp_select_profile(path_control,backend);
+	}
+}
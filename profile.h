@@ -0,0 +1,55 @@
+// profile.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	velocity profile backends of the planner. mp_plan_line and _plan_block_list only see
+	mpProfile_t, the backend is picked per block from its path control mode so a job can run
+	jerk limited on G61 and trapezoidal on G64, or one backend for every mode.
+	  - jerk, the third order profile of profile_generator, cbrt per block
+	  - trapezoid, constant acceleration, a sqrt per block and no cbrt. the block keeps its
+	    acceleration where the jerk profile keeps jerk_cbrt and 2*length where it keeps
+	    length_sqr_cbrt, so delta_vmax is sqrt of their product. velocity changes add up in
+	    v^2, so the braking velocity of a chain is sqrt of the sum of the delta_vmax squares
+	the block velocities and the head, body and tail lengths mean the same for both backends,
+	the runtime executes either one. the selection changes only with the planner empty.
+*/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "config.h"
+
+enum profileBackend{
+	PROFILE_JERK = 0,
+	PROFILE_TRAPEZOID,
+	PROFILE_BACKENDS
+};
+
+#define PROFILE_DEFAULT PROFILE_JERK
+#define PROFILE_PATH_CONTROLS (PATH_CONTINUOUS+1)
+
+typedef struct mpProfile{
+	float (*length_term)(float length, float length_square);		//length part of delta_vmax
+	float (*estimate_deltav)(float length_term);								//delta_vmax before the block exists
+	void (*set_block)(float axis_length[], float axis_length_square[], float length_square, mpBuf_t *bf);	//unit vector and the limit term
+	float (*deltav_max)(mpBuf_t *bf);
+	float (*braking)(float exit_velocity, mpBuf_t *bf);					//highest entry that still brakes to exit_velocity
+	void (*motion_planning)(mpBuf_t *bf);														//head, body and tail
+}mpProfile_t;
+
+typedef struct profileSelect{
+	const mpProfile_t *path[PROFILE_PATH_CONTROLS];		//backend per path control mode
+	float min_accel;													//trapezoid estimate, lowest axis acceleration
+}profileSelect_t;
+
+extern MACHINE_LOCAL profileSelect_t pf;
+
+#define mp_get_profile(path_control) (pf.path[(path_control)])
+
+void mp_profile_init(void);
+void mp_select_profile(uint8_t path_control, uint8_t backend);
+void mp_select_job_profile(uint8_t backend);
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * protocol.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * command stream of the serial link, see protocol.h
+ *
+ *	  UART ISR -> pc_receive -> [rx ring] -> pc_command_callback -> gc_gcode_parser
+ *	                                                  |
+ *	                                                  +-> reply frame, sr_send_frame
+ *
+ *	the ring has one producer and one consumer like the serial TX ring, the ISR only writes
+ *	head and lines_in and the main loop only tail and lines_out, so neither side masks the
+ *	interrupts. the host counts the bytes so the ring doesn't fill, a byte that doesn't fit
+ *	anyway is dropped and the next reply says STAT_BUFFER_FULL.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "system.h"
+#include "canonical.h"
+#include "gcode_parser.h"
+#include "planner.h"
+#include "serial.h"
+#include "report.h"
+#include "protocol.h"
+
+MACHINE_LOCAL pcSingleton_t pc;
+
+static stat_t _pc_read_line(char *line, uint16_t *tail);
+static void _pc_free_line(uint16_t tail);
+static stat_t _pc_check_line(char *line, uint32_t *linenum);
+static void _pc_reply(uint32_t linenum, stat_t status);
+
+void pc_init(void){
+	memset(&pc,0,sizeof(pc));
+}
+
+//pc_receive//
+//input : received character, realtime ones are taken before
+//output : true when it ended a line
+//fuction : queues the character for the command reader
+//notes : ONLY THE UART ISR CAN INVOKE THIS FUNCTION, it posts EV_COMMAND on a line
+//additions:
+//
+uint8_t pc_receive(uint8_t c){
+	if(c == '\r'){return false;}
+	uint16_t head = pc.rx.head;
+	uint16_t next = (head+1)&PC_RX_BUFFER_MASK;
+	if(next == pc.rx.tail){
+		pc.rx.overflow = true;
+		return false;
+	}
+	pc.rx.buf[head] = c;
+	pc.rx.head = next;
+	if(c != '\n'){return false;}
+	pc.rx.lines_in++;
+	return true;
+}
+
+//pc_command_callback//
+//input : none
+//output : STAT_NOOP without a whole line, STAT_RC while the reply doesn't fit the serial
+//buffer or the block waits for room in the queue, STAT_OK after a line
+//fuction : reads, checks and executes the next line and replies to it
+//notes : the controller calls it with a planner buffer free. the TX ring frees without an
+//event, a deferred read runs again on the next tick. a block the parser runs again stays in
+//the ring, it is read again as it was sent
+//additions:
+//
+stat_t pc_command_callback(void){
+	if(pc.rx.lines_in == pc.rx.lines_out){return STAT_NOOP;}
+	if(serial_tx_free() < PC_REPLY_SIZE){return STAT_RC;}	//every line gets its reply
+	char line[PC_LINE_SIZE];
+	uint32_t linenum = pc.linenum+1;
+	uint16_t tail;
+	stat_t status = _pc_read_line(line,&tail);
+	if(status == STAT_OK){
+		status = _pc_check_line(line,&linenum);
+	}
+	if(status == STAT_OK){
+		cm_set_model_linenum(linenum);		//with or without N the reports follow the stream
+		char *p = line;
+		while((*p == ' ') || (*p == '\t')) ++p;
+		if(*p != NUL){
+			status = gc_gcode_parser(line);
+			if(status == STAT_RC){return STAT_RC;}
+			if(status == STAT_NOOP){status = STAT_OK;}	//block delete
+		}
+		pc.linenum = linenum;
+	}
+	_pc_free_line(tail);
+	_pc_reply(linenum,status);
+	return STAT_OK;
+}
+
+//_pc_read_line//
+//input : storage of PC_LINE_SIZE, storage of the tail past the line
+//output : STAT_OK, STAT_LINE_TOO_LONG, STAT_BUFFER_FULL if bytes were dropped before it
+//fuction : copies the oldest line out of the ring, terminated in place of its '\n'
+//notes : the line stays in the ring until _pc_free_line, the whole line whatever the status
+//additions:
+//
+static stat_t _pc_read_line(char *line, uint16_t *tail_out){
+	stat_t status = STAT_OK;
+	uint16_t tail = pc.rx.tail;
+	uint8_t length = 0;
+	uint8_t c;
+	while((c = pc.rx.buf[tail]) != '\n'){			//there is one, lines_in counted it
+		if(length < PC_LINE_SIZE-1){
+			line[length++] = (char)c;
+		}else{
+			status = STAT_LINE_TOO_LONG;
+		}
+		tail = (tail+1)&PC_RX_BUFFER_MASK;
+	}
+	line[length] = NUL;
+	*tail_out = (tail+1)&PC_RX_BUFFER_MASK;
+	if(pc.rx.overflow){
+		pc.rx.overflow = false;
+		status = STAT_BUFFER_FULL;
+	}
+	return status;
+}
+
+static void _pc_free_line(uint16_t tail){
+	pc.rx.tail = tail;
+	pc.rx.lines_out++;
+}
+
+//_pc_check_line//
+//input : line, the next line number
+//output : STAT_OK, STAT_CHECKSUM_MISMATCH, STAT_LINENUM_SEQUENCE, STAT_INPUT_VALUE_OUT_OF_RANGE,
+//and the line number of the line
+//fuction : checks and strips the checksum and reads N
+//notes : N stays in the line for the parser. a line that fails the checksum keeps the next
+//line number, its N can't be trusted
+//additions:
+//
+static stat_t _pc_check_line(char *line, uint32_t *linenum){
+	uint8_t checksum = 0;
+	char *p = line;
+	for(; (*p != NUL) && (*p != '*'); ++p){
+		checksum ^= (uint8_t)*p;
+	}
+	uint8_t checked = (*p == '*');
+	if(checked){
+		*p++ = NUL;
+		uint16_t sent = 0;
+		uint8_t digits = 0;
+		for(; (*p >= '0') && (*p <= '9') && (sent <= 0xFF); ++p, ++digits){
+			sent = sent*10 + (*p - '0');
+		}
+		while((*p == ' ') || (*p == '\t')) ++p;
+		if((digits == 0) || (*p != NUL) || (sent != checksum)){
+			return STAT_CHECKSUM_MISMATCH;
+		}
+	}
+	p = line;
+	while((*p == ' ') || (*p == '\t')) ++p;
+	if((*p != 'N') && (*p != 'n')){return STAT_OK;}		//counts on
+	for(++p; (*p == ' ') || (*p == '\t'); ++p){}
+	uint32_t n = 0;
+	uint8_t digits = 0;
+	for(; (*p >= '0') && (*p <= '9'); ++p, ++digits){
+		if(n > (0xFFFFFFFF-9)/10){return STAT_INPUT_VALUE_OUT_OF_RANGE;}
+		n = n*10 + (*p - '0');
+	}
+	if(digits == 0){return STAT_OK;}								//the parser refuses it
+	if(checked && (n != *linenum)){
+		*linenum = n;
+		return STAT_LINENUM_SEQUENCE;
+	}
+	*linenum = n;
+	return STAT_OK;
+}
+
+//_pc_reply//
+//input : line number and status of the line
+//output : none
+//fuction : sends the reply frame of a line
+//notes : the room for it was checked before the line was read
+//additions:
+//
+static void _pc_reply(uint32_t linenum, stat_t status){
+	uint8_t payload[PC_REPLY_SIZE-4];
+	memcpy(payload,&linenum,sizeof(linenum));		//native little endian like the status frames
+	payload[4] = (uint8_t)status;
+	payload[5] = mp_get_available_buffers();
+	sr_send_frame(SR_FRAME_REPLY,payload,sizeof(payload));
+	pc.lines++;
+	if(status != STAT_OK){pc.errors++;}
+}
@@ -0,0 +1,55 @@
+// protocol.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	character counting command stream. the host counts the bytes of the lines it sent and
+	not got a reply for yet and sends the next line as soon as it fits PC_RX_BUFFER_SIZE-1,
+	so it never waits a round trip per line and the receive ring never overflows.
+	  - a line ends with '\n', '\r' is dropped. every '\n' gets exactly one reply frame, in order
+	  - [N<linenum>] <block> [*<checksum>], the checksum is the XOR of every byte before the '*'
+	    in decimal. a checksummed line has to be the next line number, without N it is taken
+	    as the next one. a line without checksum is numbered by its N or counts on
+	  - reply frame SR_FRAME_REPLY, see report.h: linenum uint32_t, status uint8_t and the
+	    available planner buffers uint8_t. status is STAT_OK or the reason the line failed,
+	    a refused line isn't executed and the lines after it fail the sequence check until
+	    the host sends that linenum again
+	a line is read only with a planner buffer free, and its bytes are freed before its reply
+	is sent, so a full planner holds the host back through the count. a block whose M commands
+	don't fit the queue yet stays in the ring and is read again.
+*/
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "config.h"
+
+#define PC_RX_BUFFER_SIZE 256				//must be a power of 2
+#define PC_RX_BUFFER_MASK (PC_RX_BUFFER_SIZE-1)
+#define PC_LINE_SIZE 100						//longest line with its terminator, longer ones are refused
+#define PC_REPLY_SIZE 10						//reply frame on the wire, 6 bytes of payload
+
+typedef struct pcRx{
+	uint8_t buf[PC_RX_BUFFER_SIZE];
+	volatile uint16_t head;					//written by the UART ISR
+	volatile uint16_t tail;					//written by the main loop
+	volatile uint16_t lines_in;			//'\n' received, UART ISR
+	uint16_t lines_out;							//lines read, main loop
+	volatile uint8_t overflow;			//a byte didn't fit, the host miscounted
+}pcRx_t;
+
+typedef struct pcSingleton{
+	pcRx_t rx;
+	uint32_t linenum;								//last line read
+	uint32_t lines;									//replied
+	uint32_t errors;								//replied with a status other than STAT_OK
+}pcSingleton_t;
+
+extern MACHINE_LOCAL pcSingleton_t pc;
+
+void pc_init(void);
+uint8_t pc_receive(uint8_t c);
+stat_t pc_command_callback(void);
+
+#endif
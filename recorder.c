@@ -0,0 +1,88 @@
+/*
+ * recorder.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * segment flight recorder, see recorder.h
+ *
+ * the dump is requested with the SERIAL_RT_FLIGHT_DUMP realtime character and sent oldest
+ * record first, one SR_FRAME_FLIGHT frame per record:
+ *
+ *	  REMAINING | TIMESTAMP | LINENUM | VELOCITY | STEPS[MOTORS]
+ *
+ *	  - REMAINING is a byte holding the number of records still to come, 0 on the last one
+ *	  - the rest is frRecord_t in native little endian
+ *	  - an empty recorder answers with a single zero length frame
+ *
+ *	the recorder is frozen while it's dumped so the records can't move under the reader, a
+ *	dump of a running machine loses the segments prepared meanwhile. an alarm freeze survives
+ *	the dump so it can be read again.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "system.h"
+#include "planner.h"
+#include "encoder.h"
+#include "serial.h"
+#include "report.h"
+#include "recorder.h"
+
+MACHINE_LOCAL flightRecorder_t fr;
+
+void fr_init(void){
+	memset(&fr,0,sizeof(fr));
+}
+
+//fr_freeze//
+//input : none
+//output : none
+//fuction : stops recording so the segments up to an alarm are kept
+//notes : called from cm_hard_alarm
+//additions:
+//
+void fr_freeze(void){
+	fr.frozen |= FR_FROZEN_ALARM;
+}
+
+//fr_dump_callback//
+//input : none
+//output : STAT_NOOP if no dump is requested, STAT_OK otherwise
+//fuction : sends the recorded segments as the serial buffer allows
+//notes : the exec interrupt checks the freeze before writing, so once the freeze is set here
+//the head read after it is final
+//additions:
+//
+stat_t fr_dump_callback(void){
+	if(sx.dump_request == 0) return STAT_NOOP;
+	if((fr.frozen & FR_FROZEN_DUMP) == 0){			//a new dump
+		fr.frozen |= FR_FROZEN_DUMP;
+		fr.dump_end = fr.head;
+		fr.dump_index = (fr.dump_end > FR_RECORDS)? fr.dump_end-FR_RECORDS : 0;
+		if(fr.dump_index == fr.dump_end){
+			if(sr_send_frame(SR_FRAME_FLIGHT,NULL,0) != STAT_OK){
+				fr.frozen &=~ FR_FROZEN_DUMP;				//try again on the next pass
+				return STAT_OK;
+			}
+		}
+	}
+
+	uint8_t frame[sizeof(frRecord_t)+1];
+	while(fr.dump_index != fr.dump_end){
+		frame[0] = (uint8_t)(fr.dump_end - fr.dump_index - 1);
+		memcpy(&frame[1],&fr.rec[fr.dump_index & FR_RECORDS_MASK],sizeof(frRecord_t));
+		if(sr_send_frame(SR_FRAME_FLIGHT,frame,sizeof(frame)) != STAT_OK){
+			return STAT_OK;									//serial link is behind, continue on the next pass
+		}
+		fr.dump_index++;
+	}
+	fr.frozen &=~ FR_FROZEN_DUMP;
+	sx.dump_request = 0;
+	return STAT_OK;
+}
@@ -0,0 +1,71 @@
+// recorder.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	segment flight recorder. the exec interrupt writes one record per prepared segment into a
+	RAM ring that always holds the latest FR_RECORDS segments, the ring freezes on a hard alarm
+	(limit hit, emergency) so the segments that led to it survive until they're dumped.
+	the exec interrupt is the only writer and the ring is only read frozen, so no locking.
+	include after planner.h and encoder.h, fr_record reads mr and en inline.
+*/
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "config.h"
+
+#ifndef INLINE
+#define INLINE extern inline
+#endif
+
+#define FR_RECORDS 64						//must be a power of 2, 28 bytes each with 4 motors
+#define FR_RECORDS_MASK (FR_RECORDS-1)
+
+//freeze reasons
+#define FR_FROZEN_ALARM 0x01			//held until fr_init
+#define FR_FROZEN_DUMP 0x02				//held while a dump is in progress
+
+typedef struct frRecord{
+	uint32_t timestamp;					//debug timer (WTIMER0) when the segment was prepared
+	uint32_t linenum;						//mr.gm.linenum
+	float velocity;							//segment velocity
+	int32_t steps[MOTORS];			//encoder steps at the segment start
+}frRecord_t;
+
+typedef struct flightRecorder{
+	frRecord_t rec[FR_RECORDS];
+	volatile uint32_t head;			//records written, only the exec interrupt writes it
+	volatile uint8_t frozen;		//freeze reasons
+	uint32_t dump_index;				//next record to dump
+	uint32_t dump_end;
+}flightRecorder_t;
+
+extern MACHINE_LOCAL flightRecorder_t fr;
+
+void fr_init(void);
+void fr_freeze(void);
+stat_t fr_dump_callback(void);
+INLINE void fr_record(void) __attribute__((always_inline));
+
+//fr_record//
+//input : none
+//output : none
+//fuction : records the segment the runtime has just prepared
+//notes : EXEC INTERRUPT ONLY. the oldest record is overwritten, nothing is written while frozen
+//additions:
+//
+inline void fr_record(void){
+	if(fr.frozen) return;
+	frRecord_t *r = &fr.rec[fr.head & FR_RECORDS_MASK];
+	r->timestamp = WTIMER0_TAV_R;
+	r->linenum = mr.gm.linenum;
+	r->velocity = mr.segment_velocity;
+	for(uint8_t motor=0; motor<MOTORS; ++motor){
+		r->steps[motor] = en.en[motor].encoder_position;
+	}
+	fr.head++;
+}
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * report.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * binary status and queue reports for the HMI
+ *
+ * reports are sampled from the RUNTIME context (mr) at a configurable rate and sent as
+ * compact frames over the serial link, only the fields that changed since the last sent
+ * frame are carried so a machine at rest costs a few bytes per report:
+ *
+ *	  SYNC | TYPE | LEN | PAYLOAD[LEN] | CHECKSUM
+ *
+ *	  - SYNC is SR_SYNC, LEN is the payload length
+ *	  - CHECKSUM is the XOR of TYPE, LEN and the payload
+ *	  - status payload is a little endian field mask (srFieldBits) of SR_MASK_BYTES bytes,
+ *		2 with 3 axes, followed by the changed fields in bit order, floats and integers in
+ *		native little endian
+ *	  - queue payload is a single byte holding mp_get_available_buffers()
+ *
+ *	every SR_KEYFRAME_FRAMES status frames all the fields are sent so a receiver that
+ *	dropped a frame resyncs on its own. a frame that doesn't fit the serial buffer is
+ *	skipped without updating the sent values, so the next report carries the changes.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "system.h"
+#include "canonical.h"
+#include "planner.h"
+#include "encoder.h"
+#include "serial.h"
+#include "report.h"
+#include "debugging.h"
+#include "HAL.h"
+#include "events.h"
+
+MACHINE_LOCAL srSingleton_t sr;
+
+static void _sr_sample(srValues_t *v);
+
+void sr_init(void){
+	memset(&sr,0,sizeof(sr));
+	sr.status_interval = SR_DEFAULT_STATUS_INTERVAL;
+	sr.queue_interval = SR_DEFAULT_QUEUE_INTERVAL;
+	sr.buffers = 0xFF;				//forces the first queue report
+	sr_request_keyframe();
+}
+
+void sr_set_status_interval(uint32_t interval){sr.status_interval = interval; ev_tick_in(1);}	//the report asks for its next tick
+void sr_set_queue_interval(uint32_t interval){sr.queue_interval = interval; ev_tick_in(1);}
+void sr_request_keyframe(void){sr.keyframe_countdown = 0;}
+
+//_sr_sample//
+//input : values snapshot
+//output : none
+//fuction : samples the reported values from the RUNTIME context
+//notes : 
+//additions: 
+//
+static void _sr_sample(srValues_t *v){
+	v->linenum = mr.gm.linenum;
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+		v->position[axis] = mp_get_runtime_work_position(axis);
+	}
+	v->velocity = (mr.move_state == MOVE_RUN)? mr.segment_velocity : 0.0f;
+	v->feedrate = mr.gm.feedrate;
+	v->machine_state = cm.machine_state;
+	v->cycle_state = cm.cycle_state;
+	v->motion_state = cm.motion_state;
+	v->motion_mode = mr.gm.motion_mode;
+	v->coordinate_system = mr.gm.coordinate_system;
+	v->units_mode = mr.gm.units_mode;
+	v->distance_mode = mr.gm.distance_mode;
+#if defined(__ENCODER_FEEDBACK)
+	v->following_error = en.fb.following_error;
+#else
+	v->following_error = 0;
+#endif
+}
+
+#define SR_FIELD(bit,member) if(keyframe || memcmp(&now.member,&sr.sent.member,sizeof(now.member))){\
+	mask |= (1UL<<(bit)); memcpy(&frame[length],&now.member,sizeof(now.member)); length += sizeof(now.member);}
+
+//sr_status_report_callback//
+//input : none
+//output : STAT_NOOP if no report is due, STAT_OK otherwise
+//fuction : sends the changed RUNTIME values every status interval
+//notes : never returns STAT_RC, reporting shall not hold the controller loop. it asks for the
+//tick of the next report, ev_tick_in
+//additions: 
+//
+stat_t sr_status_report_callback(void){
+	if(sr.status_interval == 0){return STAT_NOOP;}
+	uint32_t tick = tick_get_count();
+	uint32_t elapsed = tick - sr.status_tick;
+	if(elapsed < sr.status_interval){
+		ev_tick_in(sr.status_interval - elapsed);
+		return STAT_NOOP;
+	}
+	sr.status_tick = tick;
+	ev_tick_in(sr.status_interval);
+	db_start_session(STATUS_REPORT_TIME);
+	
+	srValues_t now;
+	uint8_t frame[SR_FRAME_MAX_SIZE];
+	uint8_t length = SR_MASK_BYTES;		//leave room for the mask
+	uint32_t mask = 0;
+	uint8_t keyframe = (sr.keyframe_countdown == 0);
+	
+	_sr_sample(&now);
+	SR_FIELD(SR_BIT_LINENUM,linenum);
+	for(uint8_t axis = X_AXIS; axis<AXES; ++axis){
+		SR_FIELD(SR_BIT_POSITION+axis,position[axis]);
+	}
+	SR_FIELD(SR_BIT_VELOCITY,velocity);
+	SR_FIELD(SR_BIT_FEEDRATE,feedrate);
+	SR_FIELD(SR_BIT_MACHINE_STATE,machine_state);
+	SR_FIELD(SR_BIT_CYCLE_STATE,cycle_state);
+	SR_FIELD(SR_BIT_MOTION_STATE,motion_state);
+	SR_FIELD(SR_BIT_MOTION_MODE,motion_mode);
+	SR_FIELD(SR_BIT_COORD_SYSTEM,coordinate_system);
+	SR_FIELD(SR_BIT_UNITS_MODE,units_mode);
+	SR_FIELD(SR_BIT_DISTANCE_MODE,distance_mode);
+	SR_FIELD(SR_BIT_FOLLOWING_ERROR,following_error);
+	
+	if(mask == 0){							//nothing changed since the last report
+		db_end_session(STATUS_REPORT_TIME);
+		return STAT_NOOP;
+	}
+	for(uint8_t i=0; i<SR_MASK_BYTES; ++i){
+		frame[i] = (uint8_t)(mask>>(8*i));
+	}
+	if(sr_send_frame(SR_FRAME_STATUS,frame,length) == STAT_OK){
+		memcpy(&sr.sent,&now,sizeof(now));
+		sr.keyframe_countdown = (keyframe)? SR_KEYFRAME_FRAMES : sr.keyframe_countdown-1;
+	}
+	db_end_session(STATUS_REPORT_TIME);
+	return STAT_OK;
+}
+
+//qr_queue_report_callback//
+//input : none
+//output : STAT_NOOP if no report is due, STAT_OK otherwise
+//fuction : reports the available planner buffers whenever they change
+//notes : rate limited by the queue interval. the controller runs it on EV_PLANNER too, the
+//buffers only change with it, and a change inside the interval asks for the tick at its end
+//additions: 
+//
+stat_t qr_queue_report_callback(void){
+	if(sr.queue_interval == 0){return STAT_NOOP;}
+	uint8_t buffers = mp_get_available_buffers();
+	if(buffers == sr.buffers){return STAT_NOOP;}
+	uint32_t tick = tick_get_count();
+	uint32_t elapsed = tick - sr.queue_tick;
+	if(elapsed < sr.queue_interval){
+		ev_tick_in(sr.queue_interval - elapsed);
+		return STAT_NOOP;
+	}
+	sr.queue_tick = tick;
+	if(sr_send_frame(SR_FRAME_QUEUE,&buffers,1) == STAT_OK){
+		sr.buffers = buffers;
+	}
+	return STAT_OK;
+}
+
+//sr_send_frame//
+//input : frame type, payload and its length
+//output : STAT_OK or STAT_BUFFER_FULL if the serial link is behind
+//fuction : wraps a payload in sync, type, length and checksum and queues it
+//notes : ONLY THE MAIN LOOP CAN INVOKE THIS FUNCTION, length can't exceed SR_FRAME_MAX_SIZE
+//additions: 
+//
+stat_t sr_send_frame(uint8_t type, uint8_t *payload, uint8_t length){
+	uint8_t frame[SR_FRAME_MAX_SIZE+4];
+	uint8_t checksum = type^length;
+	frame[0] = SR_SYNC;
+	frame[1] = type;
+	frame[2] = length;
+	for(uint8_t i=0; i<length; ++i){
+		frame[3+i] = payload[i];
+		checksum ^= payload[i];
+	}
+	frame[3+length] = checksum;
+	return serial_write(frame,length+4);
+}
@@ -0,0 +1,76 @@
+// report.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "config.h"
+
+#define SR_SYNC 0xA5					//first byte of every frame
+#define SR_FRAME_STATUS 'S'
+#define SR_FRAME_QUEUE 'Q'
+#define SR_FRAME_FLIGHT 'F'				//flight recorder dump, see recorder.c
+#define SR_FRAME_REPLY 'R'				//reply to a streamed line, see protocol.h
+
+#define SR_DEFAULT_STATUS_INTERVAL 20		//ms between status reports (50Hz), 0 disables them
+#define SR_DEFAULT_QUEUE_INTERVAL 10		//minimum ms between queue reports, 0 disables them
+#define SR_KEYFRAME_FRAMES 50					//every Nth status frame carries all the fields
+#define SR_FRAME_MAX_SIZE 64
+
+//status frame field bits, fields follow the mask in the same order
+enum srFieldBits{
+	SR_BIT_LINENUM = 0,						//uint32_t
+	SR_BIT_POSITION,							//float per axis, work coordinates
+	SR_BIT_VELOCITY = SR_BIT_POSITION+AXES,	//float, current segment velocity
+	SR_BIT_FEEDRATE,							//float
+	SR_BIT_MACHINE_STATE,					//uint8_t for the rest
+	SR_BIT_CYCLE_STATE,
+	SR_BIT_MOTION_STATE,
+	SR_BIT_MOTION_MODE,
+	SR_BIT_COORD_SYSTEM,
+	SR_BIT_UNITS_MODE,
+	SR_BIT_DISTANCE_MODE,
+	SR_BIT_FOLLOWING_ERROR,				//float, steps of the encoder feedback motor
+	SR_FIELDS
+};
+
+#define SR_MASK_BYTES ((SR_FIELDS+7)/8)		//the mask is sent in as few bytes as the fields need
+
+typedef struct srValues{
+	uint32_t linenum;
+	float position[AXES];
+	float velocity;
+	float feedrate;
+	uint8_t machine_state;
+	uint8_t cycle_state;
+	uint8_t motion_state;
+	uint8_t motion_mode;
+	uint8_t coordinate_system;
+	uint8_t units_mode;
+	uint8_t distance_mode;
+	float following_error;
+}srValues_t;
+
+typedef struct srSingleton{
+	uint32_t status_interval;
+	uint32_t queue_interval;
+	uint32_t status_tick;			//tick of the last status report
+	uint32_t queue_tick;			//tick of the last queue report
+	uint8_t keyframe_countdown;
+	uint8_t buffers;					//last reported planner buffers
+	srValues_t sent;					//last reported status values
+}srSingleton_t;
+
+extern MACHINE_LOCAL srSingleton_t sr;
+
+void sr_init(void);
+void sr_set_status_interval(uint32_t interval);
+void sr_set_queue_interval(uint32_t interval);
+void sr_request_keyframe(void);
+stat_t sr_status_report_callback(void);
+stat_t qr_queue_report_callback(void);
+stat_t sr_send_frame(uint8_t type, uint8_t *payload, uint8_t length);
+
+#endif
@@ -0,0 +1,79 @@
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "system.h"
+#include "serial.h"
+#include "canonical.h"
+#include "events.h"
+#include "protocol.h"
+
+MACHINE_LOCAL serial_t sx;
+
+static void _serial_fill_fifo(void);
+
+//serial_tx_free//
+//input : none
+//output : number of bytes that can be queued for transmission
+//fuction : 
+//notes : one slot is kept empty to tell a full ring from an empty one
+//additions: 
+//
+uint16_t serial_tx_free(void){
+	return (uint16_t)((sx.tx.tail - sx.tx.head - 1)&SERIAL_TX_BUFFER_MASK);
+}
+
+//serial_write//
+//input : data and its length
+//output : STAT_OK or STAT_BUFFER_FULL if the whole data can't be queued
+//fuction : queues data for transmission and kicks the transmitter
+//notes : ONLY THE MAIN LOOP CAN INVOKE THIS FUNCTION
+//additions: 
+//
+stat_t serial_write(const uint8_t *data, uint16_t length){
+	if(length > serial_tx_free()){
+		return STAT_BUFFER_FULL;
+	}
+	uint16_t head = sx.tx.head;
+	for(uint16_t i=0; i<length; ++i){
+		sx.tx.buf[head] = data[i];
+		head = (head+1)&SERIAL_TX_BUFFER_MASK;
+	}
+	sx.tx.head = head;
+	UART0_IM_R &=~ UART_IM_TXIM;
+	_serial_fill_fifo();					//prime the fifo, the ISR continues from there
+	UART0_IM_R |= UART_IM_TXIM;
+	return STAT_OK;
+}
+
+static void _serial_fill_fifo(void){
+	while((sx.tx.tail != sx.tx.head) && ((UART0_FR_R&UART_FR_TXFF) == 0)){
+		UART0_DR_R = sx.tx.buf[sx.tx.tail];
+		sx.tx.tail = (sx.tx.tail+1)&SERIAL_TX_BUFFER_MASK;
+	}
+}
+
+void UART0_Handler(void){
+	if(UART0_MIS_R&(UART_MIS_RXMIS|UART_MIS_RTMIS)){
+		UART0_ICR_R = UART_ICR_RXIC|UART_ICR_RTIC;
+		while((UART0_FR_R&UART_FR_RXFE) == 0){
+			uint8_t c = (uint8_t)UART0_DR_R;
+			if(c == SERIAL_RT_FLIGHT_DUMP){
+				sx.dump_request = 1;
+				ev_post(EV_FLIGHT_DUMP);
+			}else if(c == SERIAL_RT_JOG_CANCEL){
+				cm_jog_cancel();
+				ev_post(EV_PLANNER);
+			}else if(pc_receive(c)){
+				ev_post(EV_COMMAND);				//a whole line is waiting
+			}
+		}
+	}
+	if(UART0_MIS_R&UART_MIS_TXMIS){
+		UART0_ICR_R = UART_ICR_TXIC;
+		_serial_fill_fifo();
+		if(sx.tx.tail == sx.tx.head){
+			UART0_IM_R &=~ UART_IM_TXIM;		//nothing left, wait for the next write
+		}
+	}
+}
@@ -0,0 +1,48 @@
+// serial.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	UART0 (PA0 RX, PA1 TX) link to the host/HMI.
+	transmission is interrupt driven out of a ring buffer so callers never wait on the line,
+	a write that doesn't fit the free space is rejected as a whole so frames are never split.
+	received realtime commands act as soon as they arrive, the other characters go to the
+	command stream, see protocol.h.
+*/
+
+#ifndef SERIAL_H
+#define SERIAL_H
+
+#include "config.h"
+
+#define SERIAL_BAUDRATE 115200UL
+#define SERIAL_TX_BUFFER_SIZE 256			//must be a power of 2
+#define SERIAL_TX_BUFFER_MASK (SERIAL_TX_BUFFER_SIZE-1)
+
+//realtime characters, outside the g-code character set
+#define SERIAL_RT_FLIGHT_DUMP 0x8F		//dump the flight recorder, see recorder.h
+#define SERIAL_RT_JOG_CANCEL 0x85		//stop jogging, see cycle_jogging.c
+
+#define SERIAL_PRIORITY 3UL
+#define SERIAL_IRQ 5
+#define SERIAL_PRIORITY_BITS 13
+#define SERIAL_ENABLE_BIT 0x00000020
+
+typedef struct serialTx{
+	uint8_t buf[SERIAL_TX_BUFFER_SIZE];
+	volatile uint16_t head;			//written by the main loop
+	volatile uint16_t tail;			//written by the UART ISR
+}serialTx_t;
+
+typedef struct serial{
+	serialTx_t tx;
+	volatile uint8_t dump_request;	//set by the UART ISR, cleared once the dump is sent
+}serial_t;
+
+extern MACHINE_LOCAL serial_t sx;
+
+uint16_t serial_tx_free(void);
+stat_t serial_write(const uint8_t *data, uint16_t length);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * trace.c
+ * This file is part of the X project
+ *
+ * Omar Emad El-Deen
+ * Yossef Mohammed Hassanin
+ * Mars, 2018
+ */
+/*
+ * planner velocity profile trace, see trace.h
+ *
+ * every constraint _plan_block_list weighs is in the record, the vmax limits, the junction
+ * velocity and the braking velocity, next to the velocities it chose, so a plot of a program
+ * shows which one throttles a feed dip.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#if defined(HOST_BUILD)
+#include <stdio.h>
+#endif
+#include "system.h"
+#include "planner.h"
+#include "trace.h"
+
+#if defined(__PLANNER_TRACE)
+
+MACHINE_LOCAL planTrace_t pt;
+
+void pt_init(void){
+	memset(&pt,0,sizeof(pt));
+}
+
+//pt_set_junction//
+//input : the buffer being planned, its junction velocity with the previous buffer
+//output : none
+//fuction : keeps the junction velocity mp_plan_line computed, mpBuf_t has no room for it
+//notes : 
+//additions: 
+//
+void pt_set_junction(mpBuf_t *bf, float junction_vmax){
+	pt.junction_vmax[bf - mb.bf] = junction_vmax;
+}
+
+//pt_record//
+//input : the buffer the runtime is taking
+//output : none
+//fuction : records the final plan of a buffer
+//notes : called from the exec interrupt before mp_exec_move, only the first time a buffer is seen.
+//the oldest record is overwritten when the ring is full
+//additions: 
+//
+void pt_record(mpBuf_t *bf){
+	if((bf == NULL) || (bf->move_type != MOVE_TYPE_ALINE) || (bf->move_state != MOVE_NEW)) return;
+	ptRecord_t *r = &pt.rec[pt.head & (PT_RECORDS-1)];
+	r->linenum = bf->gm.linenum;
+	r->length = bf->length;
+	r->entry_vmax = bf->entry_vmax;
+	r->cruise_vmax = bf->cruise_vmax;
+	r->exit_vmax = bf->exit_vmax;
+	r->entry_velocity = bf->entry_velocity;
+	r->cruise_velocity = bf->cruise_velocity;
+	r->exit_velocity = bf->exit_velocity;
+	r->delta_vmax = bf->delta_vmax;
+	r->braking_velocity = bf->braking_velocity;
+	r->junction_vmax = pt.junction_vmax[bf - mb.bf];
+	r->head_time = (bf->head_length > 0)? (2*bf->head_length)/(bf->entry_velocity + bf->cruise_velocity) : 0;
+	r->body_time = (bf->body_length > 0)? bf->body_length/bf->cruise_velocity : 0;
+	r->tail_time = (bf->tail_length > 0)? (2*bf->tail_length)/(bf->cruise_velocity + bf->exit_velocity) : 0;
+	pt.head++;
+	if(pt.head - pt.tail > PT_RECORDS){
+		pt.tail = pt.head - PT_RECORDS;
+	}
+}
+
+//pt_read//
+//input : storage for a record
+//output : false if there's nothing new
+//fuction : takes the oldest unread record
+//notes : not to be called while the exec interrupt can record
+//additions: 
+//
+uint8_t pt_read(ptRecord_t *rec){
+	if(pt.tail == pt.head) return false;
+	*rec = pt.rec[pt.tail & (PT_RECORDS-1)];
+	pt.tail++;
+	return true;
+}
+
+#if defined(HOST_BUILD)
+
+void pt_write_csv_header(FILE *out){
+	fprintf(out,"line,length,entry_vmax,cruise_vmax,exit_vmax,entry_velocity,cruise_velocity,exit_velocity,"
+							"delta_vmax,braking_velocity,junction_vmax,head_time,body_time,tail_time\n");
+}
+
+//pt_write_csv//
+//input : stream, record
+//output : none
+//fuction : one csv row, lengths in mm, velocities in mm/min, times in seconds
+//notes : 
+//additions: 
+//
+void pt_write_csv(FILE *out, const ptRecord_t *rec){
+	fprintf(out,"%u,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+		rec->linenum,rec->length,rec->entry_vmax,rec->cruise_vmax,rec->exit_vmax,
+		rec->entry_velocity,rec->cruise_velocity,rec->exit_velocity,rec->delta_vmax,
+		rec->braking_velocity,rec->junction_vmax,
+		rec->head_time*60.0f,rec->body_time*60.0f,rec->tail_time*60.0f);
+}
+
+#endif
+
+#endif
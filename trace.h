@@ -0,0 +1,72 @@
+// trace.h
+// Runs on TM4C123
+// Omar Emad El-Deen
+// Mars, 2018
+
+/*
+	planner velocity profile trace. compiled in only when __PLANNER_TRACE is defined (project
+	preprocessor symbols, like __STEPPER), otherwise the PT_ macros expand to nothing.
+	a buffer is recorded when the runtime first takes it, that's when its plan is final, into a
+	RAM ring that keeps the latest PT_RECORDS blocks for the debugger or a host reader
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "config.h"
+#if defined(HOST_BUILD)
+#include <stdio.h>
+#endif
+
+#define PT_RECORDS 32						//power of 2, 56 bytes each
+
+typedef struct ptRecord{
+	uint32_t linenum;
+	float length;
+	float entry_vmax;
+	float cruise_vmax;
+	float exit_vmax;
+	float entry_velocity;
+	float cruise_velocity;
+	float exit_velocity;
+	float delta_vmax;
+	float braking_velocity;
+	float junction_vmax;				//0 for exact stop
+	float head_time;						//minutes
+	float body_time;
+	float tail_time;
+}ptRecord_t;
+
+typedef struct planTrace{
+	ptRecord_t rec[PT_RECORDS];
+	volatile uint32_t head;			//records written
+	volatile uint32_t tail;			//records read
+	float junction_vmax[PLANNER_BUFFER_POOL_SIZE];	//side array, one per planner buffer
+}planTrace_t;
+
+#if defined(__PLANNER_TRACE)
+
+extern MACHINE_LOCAL planTrace_t pt;
+
+void pt_init(void);
+void pt_set_junction(mpBuf_t *bf, float junction_vmax);
+void pt_record(mpBuf_t *bf);
+uint8_t pt_read(ptRecord_t *rec);
+#if defined(HOST_BUILD)
+void pt_write_csv_header(FILE *out);
+void pt_write_csv(FILE *out, const ptRecord_t *rec);
+#endif
+
+#define PT_INIT() pt_init()
+#define PT_JUNCTION(bf,v) pt_set_junction(bf,v)
+#define PT_RECORD(bf) pt_record(bf)
+
+#else
+
+#define PT_INIT()
+#define PT_JUNCTION(bf,v)
+#define PT_RECORD(bf)
+
+#endif
+
+#endif